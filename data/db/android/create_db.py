@@ -1,7 +1,10 @@
-#!/usr/bin/env python
+#!/usr/bin/env python3
 from pydict import *
 from id import *
 from valid_hanzi import *
+import functools
+import math
+import re
 import sys
 
 def get_sheng_yun(pinyin):
@@ -9,48 +12,85 @@ def get_sheng_yun(pinyin):
         return None, None
     if pinyin == "ng":
         return "", "en"
-    for i in xrange(2, 0, -1):
+    for i in range(2, 0, -1):
         t = pinyin[:i]
         if t in SHENGMU_DICT:
             return t, pinyin[len(t):]
     return "", pinyin
 
+def read_simp_trad(filename):
+    # the simp_to_trad table of src/SimpTradConverterTable.h
+    table = {}
+    with open(filename, encoding="utf8") as f:
+        for simp, trad in re.findall(r'\{ "([^"]*)", "([^"]*)" \}', f.read()):
+            table[simp] = trad
+    return table
+
+def simp_to_trad(hanzi, table, max_len):
+    # the longest match, like SimpTradConverter does
+    trad = []
+    i = 0
+    while i < len(hanzi):
+        for j in range(min(max_len, len(hanzi) - i), 0, -1):
+            if hanzi[i:i + j] in table:
+                trad.append(table[hanzi[i:i + j]])
+                i += j
+                break
+        else:
+            trad.append(hanzi[i])
+            i += 1
+    return "".join(trad)
+
 def read_phrases(filename):
-    buf = file(filename).read()
-    buf = unicode(buf, "utf16")
+    with open(filename, encoding="utf16", newline="") as f:
+        buf = f.read()
     buf = buf.strip()
-    for l in buf.split(u'\n'):
-        hanzi, freq, flag, pinyin = l.split(u' ', 3)
+    for l in buf.split('\n'):
+        hanzi, freq, flag, pinyin = l.split(' ', 3)
         freq = float(freq)
         pinyin = pinyin.split()
         if any(map(lambda c: c not in valid_hanzi, hanzi)):
             continue
         yield hanzi, freq, pinyin
 
-def create_db(filename):
+def freq_scale(records):
+    # the freq of a phrase is its rank, fit to a line of the log of its
+    # share of the texts: freq = per_e * log(share) + zero
+    total = sum(freq for hanzi, freq, rank in records)
+    n = len(records)
+    xs = [math.log(freq / total) for hanzi, freq, rank in records]
+    ys = [rank for hanzi, freq, rank in records]
+    mean_x = sum(xs) / n
+    mean_y = sum(ys) / n
+    per_e = sum((x - mean_x) * (y - mean_y) for x, y in zip(xs, ys)) / \
+            sum((x - mean_x) ** 2 for x in xs)
+    return int(round(per_e)), int(round(mean_y - per_e * mean_x))
+
+def create_db(filename, simp_trad_filename, out):
     # import sqlite3
     # con = sqlite3.connect("main.db")
     # con.execute ("PRAGMA synchronous = NORMAL;")
     # con.execute ("PRAGMA temp_store = MEMORY;")
     # con.execute ("PRAGMA default_cache_size = 5000;")
-    print "PRAGMA synchronous = NORMAL;"
-    print "PRAGMA temp_store = MEMORY;"
-    print "PRAGMA default_cache_size = 5000;"
+    print("PRAGMA synchronous = NORMAL;", file=out)
+    print("PRAGMA temp_store = MEMORY;", file=out)
+    print("PRAGMA default_cache_size = 5000;", file=out)
 
 
-    sql = "CREATE TABLE py_phrase_%d (phrase TEXT, freq INTEGER, %s);"
+    sql = "CREATE TABLE py_phrase_%d (phrase TEXT, freq INTEGER, %s, trad TEXT);"
     for i in range(0, 16):
         column = []
         for j in range(0, i + 1):
             column.append ("s%d INTEGER" % j)
             column.append ("y%d INTEGER" % j)
-        print sql % (i, ",".join(column))
+        print(sql % (i, ",".join(column)), file=out)
         # con.execute(sql % (i, column))
         # con.commit()
 
     records = list(read_phrases(filename))
-    records.sort(lambda a, b: 1 if a[1] > b[1] else -1)
+    records.sort(key=functools.cmp_to_key(lambda a, b: 1 if a[1] > b[1] else -1))
     records_new = []
+    ranks = []
     i = 0
     max_freq = 0.0
     for hanzi, freq, pinyin in records:
@@ -58,9 +98,19 @@ def create_db(filename):
             max_freq = freq
             i = i + 1
         records_new.append((hanzi, i, pinyin))
+        ranks.append((hanzi, freq, i))
     records_new.reverse()
+
+    # the scale of freq, read by the lattice of the first candidate
+    per_e, zero = freq_scale(ranks)
+    print("CREATE TABLE desc (name PRIMARY KEY, value TEXT);", file=out)
+    print("INSERT INTO desc VALUES ('freq-per-e', '%d');" % per_e, file=out)
+    print("INSERT INTO desc VALUES ('freq-zero', '%d');" % zero, file=out)
+
+    simp_trad = read_simp_trad(simp_trad_filename)
+    max_len = max(map(len, simp_trad))
     
-    print "BEGIN;"
+    print("BEGIN;", file=out)
     insert_sql = "INSERT INTO py_phrase_%d VALUES (%s);"
     for hanzi, freq, pinyin in records_new:
         columns = []
@@ -69,15 +119,18 @@ def create_db(filename):
             s, y = pinyin_id[s], pinyin_id[y]
             columns.append(s)
             columns.append(y)
-        values = "'%s', %d, %s" % (hanzi.encode("utf8"), freq, ",".join(map(str,columns)))
+        trad = simp_to_trad(hanzi, simp_trad, max_len)
+        values = "'%s', %d, %s, '%s'" % (hanzi, freq, ",".join(map(str,columns)), trad)
             
         sql = insert_sql % (len(hanzi) - 1, values)
-        print sql
-    print "COMMIT;"
-    print "VACUUM;"
+        print(sql, file=out)
+    print("COMMIT;", file=out)
+    print("VACUUM;", file=out)
 
 def main():
-    create_db(sys.argv[1])
+    # the sql is utf8 whatever the locale is
+    with open(sys.stdout.fileno(), "w", encoding="utf8", closefd=False) as out:
+        create_db(sys.argv[1], sys.argv[2], out)
  
 if __name__ == "__main__":
     main()
@@ -1,17 +1,22 @@
+import sys
+
 
 def get_validate_hanzi():
-    validate_hanzi = file("valid_utf16.txt").read().decode("utf16")
+    with open("valid_utf16.txt", encoding="utf16", newline="") as f:
+        validate_hanzi = f.read()
     return set(validate_hanzi)
 
 def main():
     hanzi = get_validate_hanzi()
     hanzi = list(hanzi)
     hanzi.sort()
-    print "# -*- coding: utf-8 -*- "
-    print "valid_hanzi = set(["
+    out = open(sys.stdout.fileno(), "w", encoding="utf8", closefd=False)
+    print("# -*- coding: utf-8 -*- ", file=out)
+    print("valid_hanzi = set([", file=out)
     for c in hanzi:
-        print "    u\"%s\"," % c.encode("utf8")
-    print "])"
+        print("    u\"%s\"," % c, file=out)
+    print("])", file=out)
+    out.close()
 
 if __name__ == "__main__":
     main()
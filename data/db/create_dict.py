@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+# vim:set et ts=4 sts=4:
+#
+# Compile the py_phrase_* tables of a main database into the memory mapped
+# dictionary read by PyZy::PhraseDict (src/PhraseDict.cc).
+#
+# usage: create_dict.py main.db main.dict
+#
+import sqlite3
+import struct
+import sys
+
+MAGIC = b"PYZYDICT"
+BYTE_ORDER = 0x01020304
+VERSION = 3
+# the strings have the traditional texts
+FLAG_TRAD = 1
+MAX_PHRASE_LEN = 16
+SHENG_NUM = 24
+
+# magic, byte_order, version, sheng_num, strings_offset, strings_size
+HEADER_FORMAT = "=8sIIIII"
+# record_num, record_size, records_offset, index_offset
+TABLE_FORMAT = "=IIII"
+# flags, freq_per_e, freq_zero, after the tables
+TRAILER_FORMAT = "=IIi"
+# phrase, freq
+RECORD_FORMAT = "=II"
+
+def align(n):
+    return (n + 3) & ~3
+
+class Strings:
+    def __init__(self, trad):
+        self.trad = trad
+        self.offsets = {}
+        self.data = []
+        self.size = 0
+
+    # a phrase is followed by its traditional text, which is empty if it is
+    # the same as the phrase
+    def add(self, phrase, trad):
+        if phrase not in self.offsets:
+            data = phrase + b"\0"
+            if self.trad:
+                data += (trad if trad != phrase else b"") + b"\0"
+            self.offsets[phrase] = self.size
+            self.data.append(data)
+            self.size += len(data)
+        return self.offsets[phrase]
+
+def has_trad(db):
+    for i in range(MAX_PHRASE_LEN):
+        columns = db.execute("PRAGMA table_info(py_phrase_%d)" % i)
+        if "trad" not in [row[1] for row in columns]:
+            return False
+    return True
+
+# freq_per_e and freq_zero of the desc table, 0 if the database does not
+# tell the scale of its freq
+def freq_scale(db):
+    scale = []
+    for name in ("freq-per-e", "freq-zero"):
+        try:
+            row = db.execute("SELECT value FROM desc WHERE name = ?", (name,)).fetchone()
+        except sqlite3.OperationalError:
+            row = None
+        scale.append(int(row[0]) if row else 0)
+    if scale[0] <= 0:
+        return 0, 0
+    return scale[0], scale[1]
+
+def read_table(db, length, trad):
+    columns = ",".join("s%d,y%d" % (i, i) for i in range(length))
+    trad = "trad" if trad else "NULL"
+    sql = "SELECT phrase, %s, freq, %s FROM py_phrase_%d" % (trad, columns, length - 1)
+    for row in db.execute(sql):
+        phrase = row[0].encode("utf8")
+        trad = row[1].encode("utf8") if row[1] else b""
+        ids = [int(i) for i in row[3:]]
+        sheng = ids[0::2]
+        if max(sheng) >= SHENG_NUM:
+            raise ValueError("invalid sheng id in %s" % row[0])
+        yield phrase, trad, int(row[2]), ids
+
+def build_table(db, length, strings):
+    groups = {}
+    for phrase, trad, freq, ids in read_table(db, length, strings.trad):
+        s1 = ids[2] if length > 1 else 0
+        groups.setdefault(ids[0] * SHENG_NUM + s1, []).append((freq, phrase, ids, trad))
+
+    record_size = align(struct.calcsize(RECORD_FORMAT) + 2 * length)
+    padding = b"\0" * (record_size - struct.calcsize(RECORD_FORMAT) - 2 * length)
+    index = []
+    records = []
+    for key in range(SHENG_NUM * SHENG_NUM):
+        index.append(len(records))
+        group = groups.get(key, [])
+        # most frequent first, ties in a stable order
+        group.sort(key=lambda r: (-r[0], r[1], r[2]))
+        for freq, phrase, ids, trad in group:
+            records.append(struct.pack(RECORD_FORMAT, strings.add(phrase, trad), freq) +
+                           struct.pack("=%dB" % len(ids), *ids) + padding)
+    index.append(len(records))
+    return record_size, index, records
+
+def create_dict(dbfile, dictfile):
+    db = sqlite3.connect(dbfile)
+    strings = Strings(has_trad(db))
+    tables = [build_table(db, i + 1, strings) for i in range(MAX_PHRASE_LEN)]
+
+    offset = struct.calcsize(HEADER_FORMAT) + struct.calcsize(TABLE_FORMAT) * MAX_PHRASE_LEN + \
+             struct.calcsize(TRAILER_FORMAT)
+    headers = []
+    body = []
+    for record_size, index, records in tables:
+        index_offset = offset
+        offset += 4 * len(index)
+        records_offset = offset
+        offset += record_size * len(records)
+        headers.append(struct.pack(TABLE_FORMAT, len(records), record_size,
+                                   records_offset, index_offset))
+        body.append(struct.pack("=%dI" % len(index), *index))
+        body.extend(records)
+
+    out = open(dictfile, "wb")
+    flags = FLAG_TRAD if strings.trad else 0
+    per_e, zero = freq_scale(db)
+    out.write(struct.pack(HEADER_FORMAT, MAGIC, BYTE_ORDER, VERSION, SHENG_NUM,
+                          offset, strings.size))
+    out.write(b"".join(headers))
+    out.write(struct.pack(TRAILER_FORMAT, flags, per_e, zero))
+    out.write(b"".join(body))
+    out.write(b"".join(strings.data))
+    out.close()
+
+def main():
+    if len(sys.argv) != 3:
+        print("usage: %s main.db main.dict" % sys.argv[0], file=sys.stderr)
+        sys.exit(1)
+    create_dict(sys.argv[1], sys.argv[2])
+
+if __name__ == "__main__":
+    main()
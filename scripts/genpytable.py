@@ -422,6 +422,116 @@ def gen_special_table(pinyins):
     print '};'
     print
 
+    gen_special_index(pinyins, l)
+
+
+def gen_special_index(pinyins, special):
+    _dict = {}
+    for i in xrange(0, len(pinyins)):
+        _dict[pinyins[i][0]] = i
+
+    firsts = sorted(set([r[0] for r in special]))
+    seconds = sorted(set([r[1] for r in special]))
+    rows = dict([(p, i) for i, p in enumerate(firsts)])
+    columns = dict([(p, i) for i, p in enumerate(seconds)])
+    index = [[-1] * len(seconds) for p in firsts]
+    for i, r in enumerate(special):
+        index[rows[r[0]]][columns[r[1]]] = i
+
+    print '''/* The resplit of pinyin p1 p2 is special_table[special_index[r][c]], where r is
+ * special_row[p1 - pinyin_table] and c is special_column[p2 - pinyin_table].
+ * -1 means no resplit. */'''
+    print 'static const short special_row[] = {'
+    row = [rows.get(p[0], -1) for p in pinyins]
+    for i in xrange(0, len(row), 16):
+        print '    %s,' % ", ".join([str(n) for n in row[i:i + 16]])
+    print '};'
+    print
+    print 'static const signed char special_column[] = {'
+    column = [columns.get(p[0], -1) for p in pinyins]
+    for i in xrange(0, len(column), 16):
+        print '    %s,' % ", ".join([str(n) for n in column[i:i + 16]])
+    print '};'
+    print
+    print 'static const short special_index[][%d] = {' % len(seconds)
+    for p, r in zip(firsts, index):
+        print '    { %s },' % ", ".join([str(n) for n in r]), '/* %s */' % p
+    print '};'
+    print
+
+
+def gen_sheng_yun_table(pinyins):
+    _dict = {}
+    for i in xrange(0, len(pinyins)):
+        _dict[pinyins[i][0]] = i
+
+    shengs = [""] + shengmu_list
+    yuns = [y for y in yunmu_list if y != "ve"]
+
+    print '''/* sheng_yun_table[sheng][yun] is the pinyin of the sheng and yun ids, or NULL.
+ * yun is 0 for a pinyin of sheng only. */'''
+    print 'static const Pinyin * const sheng_yun_table[%d][%d] = {' % (len(shengs), len(shengs) + len(yuns))
+    for s in shengs:
+        row = [s] + [None] * (len(shengs) - 1)
+        for y in yuns:
+            if y == "ue" and s not in ["j", "q", "x", "y"]:
+                y = "ve"
+            row.append(s + y)
+        row = ["&pinyin_table[%d]" % _dict[p] if p in _dict else "NULL" for p in row]
+        print '    {   /* %s */' % (s if s else "zero")
+        for i in xrange(0, len(row), 6):
+            print '        %s,' % ", ".join(row[i:i + 6])
+        print '    },'
+    print '};'
+    print
+
+
+def gen_pinyin_trie(pinyins):
+    # each node is [children, index of the pinyin ends at it]
+    nodes = [[{}, -1, ""]]
+    for i, p in enumerate(pinyins):
+        text = p[0]
+        assert len(text) <= 6
+        n = 0
+        for c in text:
+            if c not in nodes[n][0]:
+                nodes[n][0][c] = len(nodes)
+                nodes.append([{}, -1, nodes[n][2] + c])
+            n = nodes[n][0][c]
+        nodes[n][1] = i
+
+    print '''/* The trie of the text of pinyin_table, pinyin_trie[0] is the root. The child
+ * of a node for char c is pinyin_trie_next[next + c - lo] if lo <= c <= hi,
+ * 0 means no child. A leaf has hi < lo. */
+struct PinyinTrieNode {
+    unsigned char   lo;
+    unsigned char   hi;
+    unsigned short  next;
+    short           pinyin;     /* index in pinyin_table, -1 if no pinyin ends here */
+    unsigned int    flags;      /* flags of the pinyin */
+};
+'''
+    print 'static const PinyinTrieNode pinyin_trie[] = {'
+    next = []
+    for children, i, text in nodes:
+        flags = pinyins[i][-1] if i >= 0 else "0"
+        if children:
+            lo, hi = min(children), max(children)
+            row = "'%s', '%s', %d" % (lo, hi, len(next))
+            for c in xrange(ord(lo), ord(hi) + 1):
+                next.append(children.get(chr(c), 0))
+        else:
+            row = "1, 0, 0"
+        print '    { %s, %d, %s },' % (row, i, flags), '/* "%s" */' % text
+    print '};'
+    print
+
+    print 'static const unsigned short pinyin_trie_next[] = {'
+    for i in xrange(0, len(next), 10):
+        print '    %s,' % ", ".join([str(n) for n in next[i:i + 10]])
+    print '};'
+    print
+
 
 def main():
     # gen_header()
@@ -430,6 +540,8 @@ def main():
     # gen_full_pinyin_table (pinyins)
     gen_bopomofo_table(pinyins)
     gen_special_table(pinyins)
+    gen_pinyin_trie(pinyins)
+    gen_sheng_yun_table(pinyins)
     # gen_option_check("pinyin_option_check_sheng", fuzzy_shengmu)
     # gen_option_check("pinyin_option_check_yun", fuzzy_yunmu)
 
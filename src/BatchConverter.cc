@@ -0,0 +1,238 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#include "BatchConverter.h"
+
+#include <glib.h>
+
+#include "PhoneticContext.h"
+#include "String.h"
+#include "Util.h"
+
+namespace PyZy {
+
+namespace {
+
+class NullObserver : public InputContext::Observer {
+public:
+    void commitText (InputContext *context, const std::string &commit_text) { }
+    void inputTextChanged (InputContext *context) { }
+    void cursorChanged (InputContext *context) { }
+    void preeditTextChanged (InputContext *context) { }
+    void auxiliaryTextChanged (InputContext *context) { }
+    void candidatesChanged (InputContext *context) { }
+};
+
+/* the lines left to a worker; the worker takes them from the front, and
+ * the other workers steal the back half when they have nothing to do */
+struct Worker {
+    GMutex mutex;
+    size_t begin;
+    size_t end;
+    size_t syllables;
+    GThread *thread;
+    struct Batch *batch;
+};
+
+struct Batch {
+    InputContext::InputType type;
+    const std::vector<std::pair<InputContext::PropertyName, Variant> > *properties;
+    const std::vector<std::string> *texts;
+    std::vector<std::string> *results;
+    std::vector<Worker> workers;
+};
+
+inline static size_t
+lines_left (Worker &worker)
+{
+    g_mutex_lock (&worker.mutex);
+    size_t n = worker.end - worker.begin;
+    g_mutex_unlock (&worker.mutex);
+    return n;
+}
+
+static bool
+take_line (Batch &batch, Worker &self, size_t &line)
+{
+    g_mutex_lock (&self.mutex);
+    if (self.begin < self.end) {
+        line = self.begin++;
+        g_mutex_unlock (&self.mutex);
+        return true;
+    }
+    g_mutex_unlock (&self.mutex);
+
+    for (;;) {
+        /* lines are never added, so all workers are done if none is left */
+        Worker *victim = NULL;
+        size_t most = 0;
+        for (size_t i = 0; i < batch.workers.size (); i++) {
+            size_t n = lines_left (batch.workers[i]);
+            if (n > most) {
+                most = n;
+                victim = &batch.workers[i];
+            }
+        }
+        if (victim == NULL)
+            return false;
+
+        g_mutex_lock (&victim->mutex);
+        size_t n = (victim->end - victim->begin + 1) / 2;
+        if (n == 0) {
+            /* taken by its owner or another thief */
+            g_mutex_unlock (&victim->mutex);
+            continue;
+        }
+        victim->end -= n;
+        const size_t begin = victim->end;
+        g_mutex_unlock (&victim->mutex);
+
+        g_mutex_lock (&self.mutex);
+        self.begin = begin + 1;
+        self.end = begin + n;
+        g_mutex_unlock (&self.mutex);
+        line = begin;
+        return true;
+    }
+}
+
+static gpointer
+convert_thread (gpointer data)
+{
+    Worker &worker = *(Worker *) data;
+    Batch &batch = *worker.batch;
+    NullObserver observer;
+
+    /* the contexts of every thread look up phrases by its own reader */
+    std::unique_ptr<InputContext> context (
+        InputContext::create (batch.type, &observer));
+    context->setProperty (InputContext::PROPERTY_SPECIAL_PHRASE,
+                          Variant::fromBool (false));
+    for (size_t i = 0; i < batch.properties->size (); i++) {
+        context->setProperty ((*batch.properties)[i].first,
+                              (*batch.properties)[i].second);
+    }
+
+    PhoneticContext *phonetic = static_cast<PhoneticContext *> (context.get ());
+    String result;
+    size_t line;
+    while (take_line (batch, worker, line)) {
+        worker.syllables += phonetic->convertText ((*batch.texts)[line], result);
+        (*batch.results)[line].assign (result);
+    }
+    return NULL;
+}
+
+};  // namespace
+
+BatchConverter::BatchConverter (InputContext::InputType type,
+                                unsigned int threads)
+    : m_type (type),
+      m_threads (threads != 0 ? threads : g_get_num_processors ()),
+      m_syllables (0)
+{
+}
+
+bool
+BatchConverter::setProperty (InputContext::PropertyName name,
+                             const Variant &variant)
+{
+    /* checks the value by a context */
+    NullObserver observer;
+    std::unique_ptr<InputContext> context (
+        InputContext::create (m_type, &observer));
+    if (!context->setProperty (name, variant))
+        return false;
+
+    m_properties.push_back (std::make_pair (name, variant));
+    return true;
+}
+
+void
+BatchConverter::convert (const std::vector<std::string> & texts,
+                         std::vector<std::string> & results)
+{
+    Batch batch;
+    const size_t n = MAX (MIN ((size_t) m_threads, texts.size ()), (size_t) 1);
+
+    batch.type = m_type;
+    batch.properties = &m_properties;
+    batch.texts = &texts;
+    batch.results = &results;
+    batch.workers.resize (n);
+    results.resize (texts.size ());
+
+    for (size_t i = 0; i < n; i++) {
+        Worker &worker = batch.workers[i];
+        g_mutex_init (&worker.mutex);
+        worker.begin = texts.size () * i / n;
+        worker.end = texts.size () * (i + 1) / n;
+        worker.syllables = 0;
+        worker.thread = NULL;
+        worker.batch = &batch;
+    }
+
+    /* the calling thread is the first worker, and the lines of a thread
+     * which can not start are stolen by the others */
+    for (size_t i = 1; i < n; i++) {
+        batch.workers[i].thread = g_thread_try_new ("pyzy-batch",
+                                                    convert_thread,
+                                                    &batch.workers[i], NULL);
+    }
+    convert_thread (&batch.workers[0]);
+
+    m_syllables = 0;
+    for (size_t i = 0; i < n; i++) {
+        Worker &worker = batch.workers[i];
+        if (worker.thread != NULL)
+            g_thread_join (worker.thread);
+        g_mutex_clear (&worker.mutex);
+        m_syllables += worker.syllables;
+    }
+}
+
+std::string
+BatchConverter::convert (const std::string & text)
+{
+    std::vector<std::string> lines;
+    std::vector<std::string> results;
+    size_t begin = 0;
+
+    for (;;) {
+        size_t end = text.find ('\n', begin);
+        lines.push_back (text.substr (begin, end - begin));
+        if (end == std::string::npos)
+            break;
+        begin = end + 1;
+    }
+
+    convert (lines, results);
+
+    std::string result;
+    for (size_t i = 0; i < results.size (); i++) {
+        if (i != 0)
+            result += '\n';
+        result += results[i];
+    }
+    return result;
+}
+
+};  // namespace PyZy
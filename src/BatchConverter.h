@@ -0,0 +1,100 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#ifndef __PYZY_BATCH_CONVERTER_H_
+#define __PYZY_BATCH_CONVERTER_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "InputContext.h"
+#include "Variant.h"
+
+namespace PyZy {
+
+/**
+ * \brief Converts texts without an input session.
+ *
+ * BatchConverter converts phonetic texts, like logs or transcripts, to
+ * chinese texts by the first candidates of an InputContext. The lines are
+ * converted independently by some threads which share the dictionaries.
+ * It does not learn phrases.
+ *
+ * InputContext::init () must be called before converting.
+ */
+class BatchConverter {
+public:
+    /**
+     * \brief Constructor.
+     * @param type Input type of the texts.
+     * @param threads Count of the threads converting the lines, or 0 for
+     * the count of the processors.
+     */
+    explicit BatchConverter (InputContext::InputType type,
+                             unsigned int threads = 0);
+
+    /**
+     * \brief Sets a property of the contexts converting the texts.
+     * @param name Property name.
+     * @param variant Value.
+     * @return true if the property is set.
+     * @see InputContext::setProperty
+     *
+     * PROPERTY_SPECIAL_PHRASE is false by default.
+     */
+    bool setProperty (InputContext::PropertyName name,
+                      const Variant &variant);
+
+    /**
+     * \brief Converts texts.
+     * @param texts Phonetic texts, each of them is a line.
+     * @param results Converted texts in the same order.
+     *
+     * The characters which are not converted are copied.
+     */
+    void convert (const std::vector<std::string> & texts,
+                  std::vector<std::string> & results);
+
+    /**
+     * \brief Converts a text line by line.
+     * @param text Phonetic text.
+     * @return Converted text.
+     */
+    std::string convert (const std::string & text);
+
+    /**
+     * \brief Gets the count of the syllables converted by the last
+     * convert ().
+     * @return Count of the syllables.
+     */
+    size_t syllables (void) const { return m_syllables; }
+
+private:
+    InputContext::InputType m_type;
+    unsigned int m_threads;
+    std::vector<std::pair<InputContext::PropertyName, Variant> > m_properties;
+    size_t m_syllables;
+};
+
+};  // namespace PyZy
+
+#endif  // __PYZY_BATCH_CONVERTER_H_
@@ -24,7 +24,6 @@
 
 #include "Config.h"
 #include "PinyinParser.h"
-#include "SimpTradConverter.h"
 
 namespace PyZy {
 #include "BopomofoKeyboard.h"
@@ -42,6 +41,8 @@ BopomofoContext::~BopomofoContext (void)
 bool
 BopomofoContext::insert (char ch)
 {
+    ChangeBatch batch (this);
+
     if (keyvalToBopomofo (ch) == BOPOMOFO_ZERO) {
         return false;
     }
@@ -75,9 +76,35 @@ BopomofoContext::insert (char ch)
     return true;
 }
 
+bool
+BopomofoContext::insert (const std::string & text)
+{
+    ChangeBatch batch (this);
+
+    size_t len = 0;
+    while (len < text.length () && keyvalToBopomofo (text[len]) != BOPOMOFO_ZERO)
+        len++;
+
+    /* characters over MAX_PINYIN_LEN are dropped as insert (char) does */
+    const size_t n = MIN (len, MAX_PINYIN_LEN -
+                               MIN (m_text.length (), MAX_PINYIN_LEN));
+    if (n > 0) {
+        m_text.insert (m_cursor, text, n);
+        m_cursor += n;
+        updateInputText ();
+        updateCursor ();
+        updateSpecialPhrases ();
+        updatePinyin ();
+    }
+
+    return len == text.length ();
+}
+
 bool
 BopomofoContext::removeCharBefore (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -94,6 +121,8 @@ BopomofoContext::removeCharBefore (void)
 bool
 BopomofoContext::removeCharAfter (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -108,6 +137,8 @@ BopomofoContext::removeCharAfter (void)
 bool
 BopomofoContext::removeWordBefore (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -136,6 +167,8 @@ BopomofoContext::removeWordBefore (void)
 bool
 BopomofoContext::removeWordAfter (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -146,9 +179,38 @@ BopomofoContext::removeWordAfter (void)
     return true;
 }
 
+bool
+BopomofoContext::removeRange (size_t begin, size_t end)
+{
+    ChangeBatch batch (this);
+
+    end = MIN (end, m_text.length ());
+    if (G_UNLIKELY (begin >= end))
+        return false;
+
+    m_text.erase (begin, end - begin);
+    updateInputText ();
+
+    /* text after the cursor is not parsed */
+    if (begin >= m_cursor) {
+        updatePreeditText ();
+        updateAuxiliaryText ();
+        return true;
+    }
+
+    m_cursor = m_cursor >= end ? m_cursor - (end - begin) : begin;
+    updateCursor ();
+    updateSpecialPhrases ();
+    updatePinyin ();
+
+    return true;
+}
+
 bool
 BopomofoContext::moveCursorLeft (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -163,6 +225,8 @@ BopomofoContext::moveCursorLeft (void)
 bool
 BopomofoContext::moveCursorRight (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -177,6 +241,8 @@ BopomofoContext::moveCursorRight (void)
 bool
 BopomofoContext::moveCursorLeftByWord (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -201,12 +267,16 @@ BopomofoContext::moveCursorLeftByWord (void)
 bool
 BopomofoContext::moveCursorRightByWord (void)
 {
+    ChangeBatch batch (this);
+
     return moveCursorToEnd ();
 }
 
 bool
 BopomofoContext::moveCursorToBegin (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -225,6 +295,8 @@ BopomofoContext::moveCursorToBegin (void)
 bool
 BopomofoContext::moveCursorToEnd (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -244,6 +316,7 @@ BopomofoContext::updatePinyin (void)
         m_pinyin_len = 0;
     }
     else {
+        size_t edit = unchangedTextLength ();
         std::wstring bopomofo;
         for(String::iterator i = m_text.begin (); i != m_text.end (); ++i) {
             bopomofo += bopomofo_char[keyvalToBopomofo (*i)];
@@ -254,8 +327,10 @@ BopomofoContext::updatePinyin (void)
             m_cursor,            // text length
             m_config.option,     // option
             m_pinyin,            // result
-            MAX_PHRASE_LEN);     // max result length
+            MAX_PHRASE_LEN,      // max result length
+            edit);               // first changed char
     }
+    setParsedText ();
 
     updatePhraseEditor ();
     update ();
@@ -264,6 +339,9 @@ BopomofoContext::updatePinyin (void)
 void
 BopomofoContext::updateAuxiliaryText (void)
 {
+    if (deferChange (AUXILIARY_TEXT_CHANGED))
+        return;
+
     if (G_UNLIKELY (m_text.empty () || !hasCandidate (0))) {
         m_auxiliary_text = "";
         PhoneticContext::updateAuxiliaryText ();
@@ -311,6 +389,8 @@ BopomofoContext::updateAuxiliaryText (void)
 void
 BopomofoContext::commit (CommitType type)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_buffer.empty ()))
         return;
 
@@ -355,6 +435,9 @@ BopomofoContext::commit (CommitType type)
 void
 BopomofoContext::updatePreeditText (void)
 {
+    if (deferChange (PREEDIT_TEXT_CHANGED))
+        return;
+
     /* preedit text = selected phrases + highlight candidate + rest text */
     if (G_UNLIKELY (m_phrase_editor.empty () && m_text.empty ())) {
         m_preedit_text.clear ();
@@ -393,13 +476,9 @@ BopomofoContext::updatePreeditText (void)
                 m_buffer << textAfterCursor ();
             }
             else {
-                const Phrase & candidate = m_phrase_editor.candidate (index - m_special_phrases.size ());
                 if (m_text.size () == m_cursor) {
                     /* cursor at end */
-                    if (m_config.modeSimp)
-                        m_buffer << candidate;
-                    else
-                        SimpTradConverter::simpToTrad (candidate, m_buffer);
+                    m_buffer << m_phrase_editor.candidateText (index - m_special_phrases.size ());
                     edit_end_byte = m_buffer.size ();
                     /* append rest text */
                     for (const char *p=m_text.c_str() + m_pinyin_len; *p ;++p) {
@@ -443,6 +522,8 @@ BopomofoContext::getProperty (PropertyName name) const
 bool
 BopomofoContext::setProperty (PropertyName name, const Variant &variant)
 {
+    ChangeBatch batch (this);
+
     if (name == PROPERTY_BOPOMOFO_SCHEMA) {
         if (variant.getType () != Variant::TYPE_UNSIGNED_INT) {
             return false;
@@ -453,6 +534,8 @@ BopomofoContext::setProperty (PropertyName name, const Variant &variant)
         }
 
         m_bopomofo_schema = schema;
+        /* the keys map to other bopomofo, parse them again */
+        m_parsed_text.clear ();
         return true;
     }
 
@@ -35,12 +35,14 @@ public:
 
     /* API of InputContext */
     virtual bool insert (char ch);
+    virtual bool insert (const std::string & text);
     virtual void commit (CommitType type);
 
     virtual bool removeCharBefore (void);
     virtual bool removeCharAfter (void);
     virtual bool removeWordBefore (void);
     virtual bool removeWordAfter (void);
+    virtual bool removeRange (size_t begin, size_t end);
 
     virtual bool moveCursorLeft (void);
     virtual bool moveCursorRight (void);
@@ -24,6 +24,7 @@
 #include <glib.h>
 #include <glib/gstdio.h>
 #include <sqlite3.h>
+#include <cstring>
 
 #include "Config.h"
 #include "PinyinArray.h"
@@ -33,63 +34,53 @@
 namespace PyZy {
 
 #define DB_CACHE_SIZE       "5000"
-#define DB_INDEX_SIZE       (3)
 /* define columns */
 #define DB_COLUMN_USER_FREQ (0)
 #define DB_COLUMN_PHRASE    (1)
 #define DB_COLUMN_FREQ      (2)
 #define DB_COLUMN_S0        (3)
 
-#define DB_PREFETCH_LEN     (6)
-#define DB_BACKUP_TIMEOUT   (60)
+#define DB_STMT_CACHE_SIZE  (256)
+#define DB_QUERY_CACHE_SIZE (256)
 
-#define USER_DICTIONARY_FILE  "user-1.0.db"
+/* nearly every span of one or two syllables has phrases, so only the
+ * longer lengths are filtered. A filter has room for the phrases learned
+ * until it is built again */
+#define DB_FILTER_MIN_LEN   (3)
+#define DB_FILTER_HEADROOM  (256)
 
+/* changes kept for the readers which have not applied them */
+#define DB_MAX_LOG          (256)
 
-std::unique_ptr<Database> Database::m_instance;
+/* a reader copies the user database by this many pages at a time without
+ * the lock, until it is started over by this many changes */
+#define DB_BACKUP_PAGES     (256)
+#define DB_BACKUP_RESTARTS  (4)
 
-class Conditions : public std::vector<std::string> {
-public:
-    Conditions (void) : std::vector<std::string> (1) {}
+/* the connection of the writer is also read by the first reader */
+#define DB_MASTER_FLAGS     (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX)
 
-    void double_ (void) {
-        size_t i = size ();
-        // To avoid a invalid referece caused by a memory reallocation, which
-        // may occur on push_back, we call reserve here.
-        reserve (i * 2);
-        do {
-            push_back (at (--i));
-        } while (i > 0);
-    }
+/* the warm up checks its budget every WARM_UP_CHECK_PAGES pages of the
+ * dictionary, or every WARM_UP_PROGRESS_OPS sqlite instructions */
+#define WARM_UP_PAGE_SIZE       (4096)
+#define WARM_UP_CHECK_PAGES     (16)
+#define WARM_UP_PROGRESS_OPS    (1000)
 
-    void triple (void) {
-        size_t i = size ();
-        // To avoid a invalid referece caused by a memory reallocation, which
-        // may occur on push_back, we call reserve here.
-        reserve (i * 3);
-        do {
-            const std::string & value = at (--i);
-            push_back (value);
-            push_back (value);
-        } while (i > 0);
-    }
+#define USER_DICTIONARY_FILE  "user-1.0.db"
 
-    void appendVPrintf (size_t begin, size_t end, const char *fmt, va_list args) {
-        char str[64];
-        g_vsnprintf (str, sizeof(str), fmt, args);
-        for (size_t i = begin; i < end; i++) {
-            at (i) += str;
-        }
-    }
 
-    void appendPrintf (size_t begin, size_t end, const char *fmt, ...) {
-        va_list args;
-        va_start (args, fmt);
-        appendVPrintf (begin, end, fmt, args);
-        va_end (args);
-    }
+std::unique_ptr<Database> Database::m_instance;
+GMutex Database::m_mutex;
+unsigned int Database::m_serials = 0;
+
+/* the reader of a thread, with the serial of the instance owning it */
+struct ReaderSlot {
+    unsigned int serial;
+    Database::Reader *reader;
 };
 
+GPrivate Database::m_thread_reader = G_PRIVATE_INIT (Database::releaseReader);
+
 class SQLStmt {
 public:
     SQLStmt (sqlite3 *db)
@@ -106,11 +97,11 @@ public:
     }
 
     bool prepare (const String &sql) {
-        if (sqlite3_prepare (m_db,
-                             sql.c_str (),
-                             sql.size (),
-                             &m_stmt,
-                             NULL) != SQLITE_OK) {
+        if (sqlite3_prepare_v2 (m_db,
+                                sql.c_str (),
+                                sql.size (),
+                                &m_stmt,
+                                NULL) != SQLITE_OK) {
             g_warning ("parse sql failed!\n %s", sql.c_str ());
             return false;
         }
@@ -118,6 +109,20 @@ public:
         return true;
     }
 
+    /* rewinds the stmt, so it can be stepped again with new bindings */
+    void reset (void) {
+        sqlite3_reset (m_stmt);
+        sqlite3_clear_bindings (m_stmt);
+    }
+
+    bool bindInt (int index, int value) {
+        if (sqlite3_bind_int (m_stmt, index, value) != SQLITE_OK) {
+            g_warning ("bind sql parameter %d failed!", index);
+            return false;
+        }
+        return true;
+    }
+
     bool step (void) {
         switch (sqlite3_step (m_stmt)) {
         case SQLITE_ROW:
@@ -143,78 +148,303 @@ private:
     sqlite3_stmt *m_stmt;
 };
 
+/* phrases of a py_phrase_N stmt, the stmt is shared by the stmt cache */
+class SQLPhraseStream : public PhraseStream {
+public:
+    /* len is the longest length of the stmt, the length of a phrase is in
+     * the column after the ids, and its traditional text after that */
+    SQLPhraseStream (const SQLStmtPtr &stmt, size_t len)
+        : m_stmt (stmt), m_len (len) { }
+
+    ~SQLPhraseStream (void) {
+        m_stmt->reset ();
+    }
+
+    bool next (Phrase &phrase) {
+        if (!m_stmt->step ())
+            return false;
+
+        g_strlcpy (phrase.phrase,
+                   m_stmt->columnText (DB_COLUMN_PHRASE),
+                   sizeof (phrase.phrase));
+        phrase.freq = m_stmt->columnInt (DB_COLUMN_FREQ);
+        phrase.user_freq = m_stmt->columnInt (DB_COLUMN_USER_FREQ);
+        phrase.len = m_stmt->columnInt (DB_COLUMN_S0 + (m_len << 1));
+
+        for (size_t i = 0, column = DB_COLUMN_S0; i < phrase.len; i++) {
+            phrase.pinyin_id[i].sheng = m_stmt->columnInt (column++);
+            phrase.pinyin_id[i].yun = m_stmt->columnInt (column++);
+        }
+
+        const char *trad = m_stmt->columnText (DB_COLUMN_S0 + (m_len << 1) + 1);
+        if (trad != NULL)
+            phrase.setTrad (trad, std::strlen (trad));
+        else
+            phrase.trad_pos = 0;
+        return true;
+    }
+
+private:
+    SQLStmtPtr m_stmt;
+    size_t m_len;
+};
+
+/* a span the filter knows to have no phrases */
+class EmptyPhraseStream : public PhraseStream {
+public:
+    bool next (Phrase &phrase) {
+        return false;
+    }
+};
+
+/* phrases of the compiled main dictionary, the shorter lengths look up
+ * the heads of the same id sets */
+class DictPhraseStream : public PhraseStream {
+public:
+    DictPhraseStream (const PhraseDict &dict, const PinyinIdSet *sets,
+                      size_t len, size_t min_len)
+        : m_dict (dict), m_len (len), m_min_len (min_len) {
+        std::copy (sets, sets + len, m_sets);
+        m_dict.lookup (m_sets, m_len, m_cursor);
+    }
+
+    bool next (Phrase &phrase) {
+        while (!m_cursor.next (phrase)) {
+            if (m_len == m_min_len)
+                return false;
+            m_dict.lookup (m_sets, --m_len, m_cursor);
+        }
+        return true;
+    }
+
+private:
+    const PhraseDict &m_dict;
+    PinyinIdSet m_sets[MAX_PHRASE_LEN];
+    size_t m_len;
+    size_t m_min_len;
+    PhraseDict::Cursor m_cursor;
+};
+
+/* phrases of pinyin_len down to pinyin_min_len syllables, by a stream of
+ * every length */
+class LengthsPhraseStream : public PhraseStream {
+public:
+    LengthsPhraseStream (Database::Reader &reader, const PinyinArray &pinyin,
+                         size_t pinyin_begin, size_t pinyin_len, size_t pinyin_min_len,
+                         int m, unsigned int option, bool userdb)
+        : m_reader (reader), m_pinyin (pinyin), m_pinyin_begin (pinyin_begin),
+          m_pinyin_len (pinyin_len), m_pinyin_min_len (pinyin_min_len),
+          m_m (m), m_option (option), m_userdb (userdb) { }
+
+    bool next (Phrase &phrase) {
+        while (m_stream.get () == NULL || !m_stream->next (phrase)) {
+            /* the stmt of the last length goes back to the stmt cache */
+            m_stream.reset ();
+            if (m_pinyin_len < m_pinyin_min_len)
+                return false;
+            m_stream = m_reader.query (m_pinyin, m_pinyin_begin, m_pinyin_len, m_pinyin_len,
+                                       m_m, m_option, m_userdb);
+            m_pinyin_len --;
+        }
+        return true;
+    }
+
+private:
+    Database::Reader &m_reader;
+    const PinyinArray &m_pinyin;
+    size_t m_pinyin_begin;
+    size_t m_pinyin_len;
+    size_t m_pinyin_min_len;
+    int m_m;
+    unsigned int m_option;
+    bool m_userdb;
+    PhraseStreamPtr m_stream;
+};
+
+inline static bool
+phrase_greater (const Phrase &a, const Phrase &b)
+{
+    if (a.user_freq != b.user_freq)
+        return a.user_freq > b.user_freq;
+    return a.freq > b.freq;
+}
+
 Query::Query (const PinyinArray    & pinyin,
               size_t                 pinyin_begin,
               size_t                 pinyin_len,
-              unsigned int           option)
+              unsigned int           option,
+              size_t                 pinyin_min_len)
     : m_pinyin (pinyin),
       m_pinyin_begin (pinyin_begin),
       m_pinyin_len (pinyin_len),
-      m_option (option)
+      m_option (option),
+      m_pinyin_min_len (pinyin_min_len),
+      m_reader (Database::instance ().reader ()),
+      m_result_pos (0),
+      m_produced (0)
 {
     g_assert (m_pinyin.size () >= pinyin_begin + pinyin_len);
+    g_assert (pinyin_min_len > 0);
 }
 
 Query::~Query (void)
 {
+    /* the stmts go back to the stmt cache of the reader */
+    m_reader.lock ();
+    m_streams.clear ();
+    m_result.reset ();
+    m_reader.unlock ();
 }
 
 int
 Query::fill (PhraseArray &phrases, int count)
+{
+    m_reader.lock ();
+    int row = fillPhrases (phrases, count);
+    m_reader.unlock ();
+    return row;
+}
+
+int
+Query::fillPhrases (PhraseArray &phrases, int count)
 {
     int row = 0;
 
-    while (m_pinyin_len > 0) {
-        if (G_LIKELY (m_stmt.get () == NULL)) {
-            m_stmt = Database::instance ().query (m_pinyin, m_pinyin_begin, m_pinyin_len, -1, m_option);
-            g_assert (m_stmt.get () != NULL);
+    while (m_pinyin_len >= m_pinyin_min_len) {
+        if (G_UNLIKELY (m_result.get () == NULL)) {
+            m_result = m_reader.queryResult (m_pinyin, m_pinyin_begin, m_pinyin_len, m_option);
+            m_result_pos = 0;
         }
 
-        while (m_stmt->step ()) {
-            Phrase phrase;
-
-            g_strlcpy (phrase.phrase,
-                       m_stmt->columnText (DB_COLUMN_PHRASE),
-                       sizeof (phrase.phrase));
-            phrase.freq = m_stmt->columnInt (DB_COLUMN_FREQ);
-            phrase.user_freq = m_stmt->columnInt (DB_COLUMN_USER_FREQ);
-            phrase.len = m_pinyin_len;
+        PhraseArray &result = m_result->phrases;
+        while (TRUE) {
+            if (m_result_pos == result.size ()) {
+                if (m_result->complete)
+                    break;
 
-            for (size_t i = 0, column = DB_COLUMN_S0; i < m_pinyin_len; i++) {
-                phrase.pinyin_id[i].sheng = m_stmt->columnInt (column++);
-                phrase.pinyin_id[i].yun = m_stmt->columnInt (column++);
+                Phrase phrase;
+                if (!next (phrase)) {
+                    m_result->complete = true;
+                    break;
+                }
+                /* skip phrases another Query has put in the result */
+                if (m_produced++ < result.size ())
+                    continue;
+                result.push_back (phrase);
             }
 
-            phrases.push_back (phrase);
+            phrases.push_back (result[m_result_pos++]);
             row ++;
             if (G_UNLIKELY (row == count)) {
                 return row;
             }
         }
 
-        m_stmt.reset ();
+        /* the streams go on with the next length */
+        m_phrases.clear ();
+        m_result.reset ();
+        m_produced = 0;
         m_pinyin_len --;
     }
 
     return row;
 }
 
-Database::Database (const std::string &user_data_dir)
+bool
+Query::next (Phrase &phrase)
+{
+    if (G_UNLIKELY (m_streams.empty ())) {
+        /* the user database goes first, so it wins a tie */
+        m_streams.push_back (m_reader.query (m_pinyin, m_pinyin_begin, m_pinyin_len,
+                                             m_pinyin_min_len, -1, m_option, true));
+        m_streams.push_back (m_reader.query (m_pinyin, m_pinyin_begin, m_pinyin_len,
+                                             m_pinyin_min_len, -1, m_option, false));
+        m_heads.resize (m_streams.size ());
+        for (size_t i = 0; i < m_streams.size (); i++) {
+            g_assert (m_streams[i].get () != NULL);
+            if (!m_streams[i]->next (m_heads[i]))
+                m_streams[i].reset ();
+        }
+    }
+
+    while (TRUE) {
+        /* take the greatest head of the current length, every stream is
+         * already ordered */
+        size_t best = m_streams.size ();
+        for (size_t i = 0; i < m_streams.size (); i++) {
+            /* skip the lengths which were served by the query cache */
+            while (m_streams[i].get () != NULL && m_heads[i].len > m_pinyin_len) {
+                if (!m_streams[i]->next (m_heads[i]))
+                    m_streams[i].reset ();
+            }
+            if (m_streams[i].get () == NULL || m_heads[i].len < m_pinyin_len)
+                continue;
+            if (best == m_streams.size () || phrase_greater (m_heads[i], m_heads[best]))
+                best = i;
+        }
+        if (best == m_streams.size ())
+            return false;
+
+        phrase = m_heads[best];
+        if (!m_streams[best]->next (m_heads[best]))
+            m_streams[best].reset ();
+
+        /* a phrase may be in both databases, or have more readings */
+        if (m_phrases.insert (phrase.phrase).second)
+            return true;
+    }
+}
+
+Database::Database (const std::string &user_data_dir, bool lazy_userdb,
+                    const std::string &main_db)
     : m_db (NULL)
-    , m_timeout_id (0)
-    , m_timer (g_timer_new ())
+    , m_main_db (NULL)
+    , m_main_db_file (main_db)
+    , m_main_trad (false)
+    , m_freq_per_e (0)
+    , m_freq_zero (0)
+    , m_log_begin (0)
+    , m_epoch (0)
+    , m_shared_reader (NULL)
+    , m_generation (0)
+    , m_query_cache_size (DB_QUERY_CACHE_SIZE)
+    , m_lazy_userdb (lazy_userdb)
+    , m_loader (NULL)
+    , m_loader_done (0)
+    , m_loaded_db (NULL)
+    , m_retired_db (NULL)
+    , m_warmer (NULL)
+    , m_warm_up_cancelled (0)
+    , m_warm_up_done (0)
+    , m_warm_up_max_bytes (0)
+    , m_warm_up_deadline (0)
     , m_user_data_dir (user_data_dir)
 {
+    g_mutex_lock (&m_mutex);
+    m_serial = ++m_serials;
+    g_mutex_unlock (&m_mutex);
     open ();
 }
 
 Database::~Database (void)
 {
-    g_timer_destroy (m_timer);
-    if (m_timeout_id != 0) {
-        saveUserDB ();
-        g_source_remove (m_timeout_id);
+    g_mutex_lock (&m_mutex);
+    cancelWarmUp (true);
+    /* keep the phrases learned while the user database was loading */
+    mergeUserDB (true);
+    /* the threads exiting later do not find their readers */
+    for (size_t i = 0; i < m_readers.size (); i++)
+        delete m_readers[i];
+    m_readers.clear ();
+    m_shared_reader = NULL;
+    m_serials++;
+    if (m_retired_db != NULL) {
+        sqlite3_close_v2 (m_retired_db);
+        m_retired_db = NULL;
     }
+    g_mutex_unlock (&m_mutex);
+
+    m_writer.stop ();
     if (m_db) {
         if (sqlite3_close (m_db) != SQLITE_OK) {
             g_warning ("close sqlite database failed!");
@@ -222,12 +452,9 @@ Database::~Database (void)
     }
 }
 
-inline bool
-Database::executeSQL (const char *sql, sqlite3 *db)
+static bool
+execute_sql (sqlite3 *db, const char *sql)
 {
-    if (db == NULL)
-        db = m_db;
-
     char *errmsg = NULL;
     if (sqlite3_exec (db, sql, NULL, NULL, &errmsg) != SQLITE_OK) {
         g_warning ("%s: %s", errmsg, sql);
@@ -237,6 +464,70 @@ Database::executeSQL (const char *sql, sqlite3 *db)
     return true;
 }
 
+/* an integer in the desc table of a database, 0 if it is not there */
+static gint64
+desc_int (sqlite3 *db, const char *name, const char *key)
+{
+    String sql;
+    sql.printf ("SELECT value FROM %s.desc WHERE name=\"%s\"", name, key);
+    sqlite3_stmt *stmt = NULL;
+    gint64 value = 0;
+    if (sqlite3_prepare_v2 (db, sql.c_str (), sql.size (), &stmt, NULL) == SQLITE_OK &&
+        sqlite3_step (stmt) == SQLITE_ROW)
+        value = sqlite3_column_int64 (stmt, 0);
+    sqlite3_finalize (stmt);
+    return value;
+}
+
+/* whether every py_phrase_N table of a database has a column */
+static bool
+has_column (sqlite3 *db, const char *name, const char *column)
+{
+    String sql;
+    for (size_t i = 0; i < MAX_PHRASE_LEN; i++) {
+        sql.printf ("SELECT %s FROM %s.py_phrase_%d LIMIT 0", column, name, i);
+        sqlite3_stmt *stmt = NULL;
+        int retval = sqlite3_prepare_v2 (db, sql.c_str (), sql.size (), &stmt, NULL);
+        sqlite3_finalize (stmt);
+        if (retval != SQLITE_OK)
+            return false;
+    }
+    return true;
+}
+
+inline bool
+Database::executeSQL (const char *sql, sqlite3 *db)
+{
+    return execute_sql (db != NULL ? db : m_db, sql);
+}
+
+/* sets the pragmas of a connection to the main database */
+static bool
+setup_db (sqlite3 *db)
+{
+    String sql;
+
+    /* Set synchronous=OFF, write user database will become much faster.
+     * It will cause user database corrupted, if the operatering system
+     * crashes or computer loses power.
+     * */
+    sql << "PRAGMA synchronous=OFF;\n";
+
+    /* Set the cache size for better performance */
+    sql << "PRAGMA cache_size=" DB_CACHE_SIZE ";\n";
+
+    /* Using memory for temp store */
+    // sql << "PRAGMA temp_store=MEMORY;\n";
+
+    /* Set journal mode */
+    // sql << "PRAGMA journal_mode=PERSIST;\n";
+
+    /* Using EXCLUSIVE locking mode on databases
+     * for better performance */
+    sql << "PRAGMA locking_mode=EXCLUSIVE;\n";
+    return execute_sql (db, sql);
+}
+
 bool
 Database::open (void)
 {
@@ -251,43 +542,62 @@ Database::open (void)
             "main.db",
         };
 
+        const char * const *files = maindb;
+        size_t n = G_N_ELEMENTS (maindb);
+        const char *file = m_main_db_file.c_str ();
+        if (!m_main_db_file.empty ()) {
+            files = &file;
+            n = 1;
+        }
+
         size_t i;
-        for (i = 0; i < G_N_ELEMENTS (maindb); i++) {
-            if (!g_file_test(maindb[i], G_FILE_TEST_IS_REGULAR))
+        for (i = 0; i < n; i++) {
+            const char *db = files[i];
+            /* prefer the compiled dictionary of a main database, then
+             * sqlite only holds the user database */
+            String dict (std::string (db, MAX (std::strlen (db), 3) - 3));
+            dict << ".dict";
+            if (g_file_test (dict, G_FILE_TEST_IS_REGULAR) && m_dict.open (dict)) {
+                m_main_db = ":memory:";
+                if (sqlite3_open_v2 (m_main_db, &m_db,
+                    DB_MASTER_FLAGS, NULL) == SQLITE_OK) {
+                    break;
+                }
+                m_dict.close ();
+            }
+
+            if (!g_file_test(db, G_FILE_TEST_IS_REGULAR))
                 continue;
-            if (sqlite3_open_v2 (maindb[i], &m_db,
-                SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL) == SQLITE_OK) {
+            m_main_db = db;
+            if (sqlite3_open_v2 (m_main_db, &m_db,
+                DB_MASTER_FLAGS, NULL) == SQLITE_OK) {
                 break;
             }
         }
 
-        if (i == G_N_ELEMENTS (maindb)) {
+        if (i == n) {
             g_warning ("can not open main database");
             break;
         }
 
-        m_sql.clear ();
-
-        /* Set synchronous=OFF, write user database will become much faster.
-         * It will cause user database corrupted, if the operatering system
-         * crashes or computer loses power.
-         * */
-        m_sql << "PRAGMA synchronous=OFF;\n";
-
-        /* Set the cache size for better performance */
-        m_sql << "PRAGMA cache_size=" DB_CACHE_SIZE ";\n";
-
-        /* Using memory for temp store */
-        // m_sql << "PRAGMA temp_store=MEMORY;\n";
+        if (!setup_db (m_db))
+            break;
 
-        /* Set journal mode */
-        // m_sql << "PRAGMA journal_mode=PERSIST;\n";
+        /* older main databases have no traditional texts */
+        m_main_trad = !m_dict.isOpen () && has_column (m_db, "main", "trad");
 
-        /* Using EXCLUSIVE locking mode on databases
-         * for better performance */
-        m_sql << "PRAGMA locking_mode=EXCLUSIVE;\n";
-        if (!executeSQL (m_sql))
-            break;
+        /* the scale of freq, the compiled dictionary copies it */
+        if (m_dict.isOpen ()) {
+            m_freq_per_e = m_dict.freqPerE ();
+            m_freq_zero = m_dict.freqZero ();
+        }
+        else {
+            gint64 per_e = desc_int (m_db, "main", "freq-per-e");
+            if (per_e > 0 && per_e <= G_MAXINT32) {
+                m_freq_per_e = per_e;
+                m_freq_zero = desc_int (m_db, "main", "freq-zero");
+            }
+        }
 
         loadUserDB ();
 #if 0
@@ -305,9 +615,6 @@ Database::open (void)
     }
 #endif
 
-        /* prefetch some tables */
-        // prefetch ();
-
         return true;
     } while (0);
 
@@ -318,67 +625,87 @@ Database::open (void)
     return false;
 }
 
-bool
-Database::loadUserDB (void)
+/* opens a user database file, creates its tables if they do not exist, and
+ * copies it into the database name of db. path is set to the file name, or
+ * cleared if the file can not be opened and an empty database is used */
+static bool
+read_user_db (const char *filename, sqlite3 *db, const char *name, String &path)
 {
     sqlite3 *userdb = NULL;
+    String sql;
     do {
-        /* Attach user database */
-        m_sql.printf ("ATTACH DATABASE \":memory:\" AS userdb;");
-        if (!executeSQL (m_sql))
-            break;
-
-        g_mkdir_with_parents (m_user_data_dir, 0750);
-        m_buffer.clear ();
-        m_buffer << m_user_data_dir << G_DIR_SEPARATOR_S << USER_DICTIONARY_FILE;
-
         unsigned int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
-        if (sqlite3_open_v2 (m_buffer, &userdb, flags, NULL) != SQLITE_OK &&
-            sqlite3_open_v2 (":memory:", &userdb, flags, NULL) != SQLITE_OK)
-            break;
+        if (sqlite3_open_v2 (filename, &userdb, flags, NULL) != SQLITE_OK) {
+            sqlite3_close (userdb);
+            userdb = NULL;
+            if (sqlite3_open_v2 (":memory:", &userdb, flags, NULL) != SQLITE_OK)
+                break;
+        }
 
-        m_sql = "BEGIN TRANSACTION;\n";
+        sql = "BEGIN TRANSACTION;\n";
         /* create desc table*/
-        m_sql << "CREATE TABLE IF NOT EXISTS desc (name PRIMARY KEY, value TEXT);\n";
-        m_sql << "INSERT OR IGNORE INTO desc VALUES " << "('version', '1.2.0');\n"
-              << "INSERT OR IGNORE INTO desc VALUES " << "('uuid', '" << UUID () << "');\n"
-              << "INSERT OR IGNORE INTO desc VALUES " << "('hostname', '" << Hostname () << "');\n"
-              << "INSERT OR IGNORE INTO desc VALUES " << "('username', '" << Env ("USERNAME") << "');\n"
-              << "INSERT OR IGNORE INTO desc VALUES " << "('create-time', datetime());\n"
-              << "INSERT OR IGNORE INTO desc VALUES " << "('attach-time', datetime());\n";
+        sql << "CREATE TABLE IF NOT EXISTS desc (name PRIMARY KEY, value TEXT);\n";
+        sql << "INSERT OR IGNORE INTO desc VALUES " << "('version', '1.3.0');\n"
+            << "INSERT OR IGNORE INTO desc VALUES " << "('uuid', '" << UUID () << "');\n"
+            << "INSERT OR IGNORE INTO desc VALUES " << "('hostname', '" << Hostname () << "');\n"
+            << "INSERT OR IGNORE INTO desc VALUES " << "('username', '" << Env ("USERNAME") << "');\n"
+            << "INSERT OR IGNORE INTO desc VALUES " << "('create-time', datetime());\n"
+            << "INSERT OR IGNORE INTO desc VALUES " << "('attach-time', datetime());\n";
 
         /* create phrase tables */
         for (size_t i = 0; i < MAX_PHRASE_LEN; i++) {
-            m_sql.appendPrintf ("CREATE TABLE IF NOT EXISTS py_phrase_%d (user_freq, phrase TEXT, freq INTEGER ", i);
+            sql.appendPrintf ("CREATE TABLE IF NOT EXISTS py_phrase_%d (user_freq, phrase TEXT, freq INTEGER ", i);
             for (size_t j = 0; j <= i; j++)
-                m_sql.appendPrintf (",s%d INTEGER, y%d INTEGER", j, j);
-            m_sql << ");\n";
+                sql.appendPrintf (",s%d INTEGER, y%d INTEGER", j, j);
+            sql << ",trad TEXT);\n";
         }
 
         /* create index */
-        m_sql << "CREATE UNIQUE INDEX IF NOT EXISTS " << "index_0_0 ON py_phrase_0(s0,y0,phrase);\n";
-        m_sql << "CREATE UNIQUE INDEX IF NOT EXISTS " << "index_1_0 ON py_phrase_1(s0,y0,s1,y1,phrase);\n";
-        m_sql << "CREATE INDEX IF NOT EXISTS " << "index_1_1 ON py_phrase_1(s0,s1,y1);\n";
+        sql << "CREATE UNIQUE INDEX IF NOT EXISTS " << "index_0_0 ON py_phrase_0(s0,y0,phrase);\n";
+        sql << "CREATE UNIQUE INDEX IF NOT EXISTS " << "index_1_0 ON py_phrase_1(s0,y0,s1,y1,phrase);\n";
+        sql << "CREATE INDEX IF NOT EXISTS " << "index_1_1 ON py_phrase_1(s0,s1,y1);\n";
         for (size_t i = 2; i < MAX_PHRASE_LEN; i++) {
-            m_sql << "CREATE UNIQUE INDEX IF NOT EXISTS " << "index_" << i << "_0 ON py_phrase_" << i
-                  << "(s0,y0";
+            sql << "CREATE UNIQUE INDEX IF NOT EXISTS " << "index_" << i << "_0 ON py_phrase_" << i
+                << "(s0,y0";
+            for (size_t j = 1; j <= i; j++)
+                sql << ",s" << j << ",y" << j;
+            sql << ",phrase);\n";
+            sql << "CREATE INDEX IF NOT EXISTS " << "index_" << i << "_1 ON py_phrase_" << i << "(s0,s1,s2,y2);\n";
+        }
+        /* the initials index of incomplete pinyin, in the order of
+         * queries */
+        for (size_t i = 0; i < MAX_PHRASE_LEN; i++) {
+            sql << "CREATE INDEX IF NOT EXISTS " << "index_" << i << "_2 ON py_phrase_" << i << "(s0";
             for (size_t j = 1; j <= i; j++)
-                m_sql << ",s" << j << ",y" << j;
-            m_sql << ",phrase);\n";
-            m_sql << "CREATE INDEX IF NOT EXISTS " << "index_" << i << "_1 ON py_phrase_" << i << "(s0,s1,s2,y2);\n";
+                sql << ",s" << j;
+            sql << ",user_freq,freq);\n";
         }
-        m_sql << "COMMIT;";
+        sql << "COMMIT;";
 
-        if (!executeSQL (m_sql, userdb))
+        if (!execute_sql (userdb, sql))
             break;
 
-        sqlite3_backup *backup = sqlite3_backup_init (m_db, "userdb", userdb, "main");
+        /* the traditional texts are added by version 1.3.0 */
+        if (!has_column (userdb, "main", "trad")) {
+            sql = "BEGIN TRANSACTION;\n";
+            for (size_t i = 0; i < MAX_PHRASE_LEN; i++)
+                sql.appendPrintf ("ALTER TABLE py_phrase_%d ADD COLUMN trad TEXT;\n", i);
+            sql << "UPDATE desc SET value='1.3.0' WHERE name='version';\n";
+            sql << "COMMIT;";
+            if (!execute_sql (userdb, sql))
+                break;
+        }
+
+        sqlite3_backup *backup = sqlite3_backup_init (db, name, userdb, "main");
 
         if (backup) {
             sqlite3_backup_step (backup, -1);
             sqlite3_backup_finish (backup);
         }
 
+        const char *file = sqlite3_db_filename (userdb, "main");
+        path = file ? file : "";
+
         sqlite3_close (userdb);
         return true;
     } while (0);
@@ -389,85 +716,530 @@ Database::loadUserDB (void)
 }
 
 bool
-Database::saveUserDB (void)
+Database::loadUserDB (void)
 {
+    /* Attach user database */
+    m_sql.printf ("ATTACH DATABASE \":memory:\" AS userdb;");
+    if (!executeSQL (m_sql))
+        return false;
+
     g_mkdir_with_parents (m_user_data_dir, 0750);
     m_buffer.clear ();
     m_buffer << m_user_data_dir << G_DIR_SEPARATOR_S << USER_DICTIONARY_FILE;
 
-    String tmpfile = m_buffer + "-tmp";
-    sqlite3 *userdb = NULL;
-    do {
-        /* remove tmpfile if it exist */
-        g_unlink (tmpfile);
+    String path;
+    if (!m_lazy_userdb) {
+        if (!read_user_db (m_buffer, m_db, "userdb", path))
+            return false;
 
-        unsigned int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
-        if (sqlite3_open_v2 (tmpfile, &userdb, flags, NULL) != SQLITE_OK)
-            break;
+        /* later changes are written to the file in the background */
+        if (!path.empty ())
+            m_writer.start (path);
+        return true;
+    }
 
-        sqlite3_backup *backup = sqlite3_backup_init (userdb, "main", m_db, "userdb");
+    /* only create the tables now, the file is read by a thread and merged
+     * by mergeUserDB */
+    if (!read_user_db (":memory:", m_db, "userdb", path))
+        return false;
 
-        if (backup == NULL)
-            break;
+    m_userdb_file = m_buffer;
+    g_atomic_pointer_set (&m_loader,
+                          g_thread_try_new ("pyzy-userdb-loader",
+                                            Database::loadUserDBThread, this, NULL));
+    if (m_loader == NULL) {
+        g_warning ("can not load user database %s", m_buffer.c_str ());
+        return false;
+    }
+    return true;
+}
 
-        sqlite3_backup_step (backup, -1);
-        sqlite3_backup_finish (backup);
-        sqlite3_close (userdb);
+gpointer
+Database::loadUserDBThread (gpointer data)
+{
+    Database *self = static_cast<Database *> (data);
+    sqlite3 *db = NULL;
+
+    /* a new connection like m_db, which replaces m_db when it is merged */
+    unsigned int flags = DB_MASTER_FLAGS;
+    if (sqlite3_open_v2 (self->m_main_db, &db, flags, NULL) != SQLITE_OK ||
+        !setup_db (db) ||
+        !execute_sql (db, "ATTACH DATABASE \":memory:\" AS userdb;") ||
+        !read_user_db (self->m_userdb_file, db, "userdb", self->m_userdb_path)) {
+        sqlite3_close (db);
+        db = NULL;
+    }
+
+    self->m_loaded_db = db;
+    g_atomic_int_set (&self->m_loader_done, 1);
+    return NULL;
+}
 
-        g_rename (tmpfile, m_buffer);
+/* called with m_mutex locked */
+void
+Database::mergeUserDB (bool wait)
+{
+    if (m_loader == NULL)
+        return;
+    if (!wait && !g_atomic_int_get (&m_loader_done))
+        return;
 
-        return true;
-    } while (0);
+    g_thread_join (m_loader);
+    g_atomic_pointer_set (&m_loader, NULL);
 
-    if (userdb != NULL)
-        sqlite3_close (userdb);
-    g_unlink (tmpfile);
+    if (m_loaded_db != NULL) {
+        /* switch to the connection of the loader, the readers copy it
+         * again before their next lookup. The shared reader may be using
+         * the old one under its own lock, which is taken before m_mutex,
+         * so it closes the old one itself when it switches */
+        if (m_shared_reader != NULL && m_shared_reader->m_db == m_db)
+            m_retired_db = m_db;
+        else
+            sqlite3_close_v2 (m_db);
+        m_db = m_loaded_db;
+        m_loaded_db = NULL;
+
+        /* apply the phrases learned while loading again */
+        for (size_t i = 0; i < m_changes.size (); i++) {
+            m_buffer = "BEGIN TRANSACTION;\n";
+            m_buffer << m_changes[i];
+            m_buffer << "COMMIT;\n";
+            executeSQL (m_buffer);
+        }
 
-    return false;
+        if (!m_userdb_path.empty ()) {
+            m_writer.start (m_userdb_path);
+            for (size_t i = 0; i < m_changes.size (); i++)
+                m_writer.write (m_changes[i]);
+        }
+
+        /* the log is of the old copy */
+        m_epoch++;
+        m_log_begin += m_log.size ();
+        m_log.clear ();
+    }
+
+    m_changes.clear ();
+    g_atomic_int_inc (&m_generation);
 }
 
 void
-Database::prefetch (void)
+Database::waitUserDB (void)
 {
-    m_sql.clear ();
-    for (size_t i = 0; i < DB_PREFETCH_LEN; i++)
-        m_sql << "SELECT * FROM py_phrase_" << i << ";\n";
+    g_mutex_lock (&m_mutex);
+    mergeUserDB (true);
+    g_mutex_unlock (&m_mutex);
+}
 
-    // g_debug ("prefetching ...");
-    executeSQL (m_sql);
-    // g_debug ("done");
+void
+Database::warmUp (size_t max_bytes, unsigned int max_msec)
+{
+    g_mutex_lock (&m_mutex);
+    cancelWarmUp (true);
+    if (m_db == NULL) {
+        g_mutex_unlock (&m_mutex);
+        return;
+    }
+
+    m_warm_up_cancelled = 0;
+    m_warm_up_done = 0;
+    m_warm_up_max_bytes = max_bytes;
+    m_warm_up_deadline = max_msec == 0 ? 0 :
+        g_get_monotonic_time () + (gint64) max_msec * 1000;
+
+    g_atomic_pointer_set (&m_warmer,
+                          g_thread_try_new ("pyzy-warm-up",
+                                            Database::warmUpThread, this, NULL));
+    if (m_warmer == NULL)
+        g_warning ("can not start the warm up thread");
+    g_mutex_unlock (&m_mutex);
 }
 
-// This function should be return gboolean because g_timeout_add_seconds requires it.
-gboolean
-Database::timeoutCallback (void * data)
+/* called with m_mutex locked */
+void
+Database::cancelWarmUp (bool wait)
 {
-    Database *self = static_cast<Database*> (data);
+    if (m_warmer == NULL)
+        return;
 
-    /* Get elapsed time since last modification of database. */
-    unsigned int elapsed = (unsigned int)g_timer_elapsed (self->m_timer, NULL);
+    /* the thread stops at its next budget check, it is joined once it is
+     * done, so a key stroke does not wait for a read of the disk */
+    g_atomic_int_set (&m_warm_up_cancelled, 1);
+    if (!wait && !g_atomic_int_get (&m_warm_up_done))
+        return;
 
-    if (elapsed >= DB_BACKUP_TIMEOUT &&
-        self->saveUserDB ()) {
-        self->m_timeout_id = 0;
-        return false;
+    g_thread_join (m_warmer);
+    g_atomic_pointer_set (&m_warmer, NULL);
+}
+
+bool
+Database::warmUpStopped (gsize bytes) const
+{
+    if (g_atomic_int_get (&m_warm_up_cancelled))
+        return true;
+    if (m_warm_up_max_bytes != 0 && bytes >= m_warm_up_max_bytes)
+        return true;
+    return m_warm_up_deadline != 0 &&
+           g_get_monotonic_time () >= m_warm_up_deadline;
+}
+
+/* the pages are read into the page cache of the system, which is shared
+ * with the connections and the mapping of the dictionary used by queries */
+gpointer
+Database::warmUpThread (gpointer data)
+{
+    Database *self = static_cast<Database *> (data);
+
+    if (self->m_dict.isOpen ())
+        self->warmUpDict ();
+    else
+        self->warmUpSQL ();
+
+    g_atomic_int_set (&self->m_warm_up_done, 1);
+    return NULL;
+}
+
+void
+Database::warmUpDict (void)
+{
+    std::vector<PhraseDict::Range> ranges;
+    m_dict.ranges (ranges);
+
+    /* touch one byte of every page */
+    volatile char sink = 0;
+    gsize pages = 0;
+    for (size_t i = 0; i < ranges.size (); i++) {
+        const char *data = ranges[i].first;
+        for (gsize offset = 0; offset < ranges[i].second; offset += WARM_UP_PAGE_SIZE) {
+            if (pages % WARM_UP_CHECK_PAGES == 0 &&
+                warmUpStopped (pages * WARM_UP_PAGE_SIZE))
+                return;
+            sink = sink + data[offset];
+            pages ++;
+        }
     }
+}
 
-    return true;
+struct WarmUpSQLState {
+    const Database *self;
+    sqlite3 *db;
+    gsize page_size;
+
+    gsize bytes (void) const {
+        int current = 0, highwater = 0;
+        sqlite3_db_status (db, SQLITE_DBSTATUS_CACHE_MISS, &current, &highwater, 0);
+        return (gsize) current * page_size;
+    }
+};
+
+int
+Database::warmUpProgress (gpointer data)
+{
+    const WarmUpSQLState *state = static_cast<const WarmUpSQLState *> (data);
+    return state->self->warmUpStopped (state->bytes ()) ? 1 : 0;
+}
+
+void
+Database::warmUpSQL (void)
+{
+    sqlite3 *db = NULL;
+    if (sqlite3_open_v2 (m_main_db, &db, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK) {
+        sqlite3_close (db);
+        return;
+    }
+
+    /* the pages are not kept by this connection, so every page read is a
+     * cache miss */
+    execute_sql (db, "PRAGMA cache_size=16;");
+
+    WarmUpSQLState state = { this, db, WARM_UP_PAGE_SIZE };
+    sqlite3_stmt *stmt = NULL;
+    if (sqlite3_prepare_v2 (db, "PRAGMA page_size;", -1, &stmt, NULL) == SQLITE_OK &&
+        sqlite3_step (stmt) == SQLITE_ROW)
+        state.page_size = sqlite3_column_int (stmt, 0);
+    sqlite3_finalize (stmt);
+
+    sqlite3_progress_handler (db, WARM_UP_PROGRESS_OPS, Database::warmUpProgress, &state);
+
+    /* the indexes and then the table of every phrase length, short phrases
+     * first. A main database may not have all the indexes */
+    String sql;
+    for (size_t i = 0; i < MAX_PHRASE_LEN && !warmUpStopped (state.bytes ()); i++) {
+        for (size_t j = 0; j < 4; j++) {
+            sql = "SELECT sum(";
+            sql << (j < 3 ? "s0" : "freq") << ") FROM py_phrase_" << i;
+            if (j < 3)
+                sql << " INDEXED BY index_" << i << '_' << j << ";";
+            else
+                sql << " NOT INDEXED;";
+
+            if (sqlite3_prepare_v2 (db, sql, -1, &stmt, NULL) != SQLITE_OK)
+                continue;
+            while (sqlite3_step (stmt) == SQLITE_ROW);
+            sqlite3_finalize (stmt);
+        }
+    }
+
+    sqlite3_close (db);
 }
 
+/* applies sql changing the user database to the master copy, queues it
+ * for the user database file, and logs it for the readers. Called with
+ * m_mutex locked */
 void
-Database::modified (void)
+Database::modify (const String & sql, const PhraseArray & phrases)
 {
-    /* Restart the timer */
-    g_timer_start (m_timer);
+    if (G_UNLIKELY (m_loader != NULL))
+        mergeUserDB (false);
 
-    if (m_timeout_id != 0)
+    m_buffer = "BEGIN TRANSACTION;\n";
+    m_buffer << sql;
+    m_buffer << "COMMIT;\n";
+
+    if (executeSQL (m_buffer)) {
+        if (G_UNLIKELY (m_loader != NULL))
+            m_changes.push_back (sql);
+        else
+            m_writer.write (sql);
+
+        m_log.push_back (Change ());
+        m_log.back ().sql = sql;
+        m_log.back ().phrases = phrases;
+        trimLog ();
+    }
+    g_atomic_int_inc (&m_generation);
+}
+
+/* a reader copies the master when it is created, when the user database
+ * is merged, or when it is too far behind; otherwise it applies the
+ * logged changes */
+void
+Database::catchUp (Reader &reader)
+{
+    if (G_LIKELY (g_atomic_pointer_get (&m_loader) == NULL &&
+                  g_atomic_pointer_get (&m_warmer) == NULL &&
+                  reader.m_generation == g_atomic_int_get (&m_generation)))
         return;
 
-    m_timeout_id = g_timeout_add_seconds (DB_BACKUP_TIMEOUT,
-                                          Database::timeoutCallback,
-                                          static_cast<void *> (this));
+    g_mutex_lock (&m_mutex);
+    if (G_UNLIKELY (m_loader != NULL))
+        mergeUserDB (false);
+    if (G_UNLIKELY (m_warmer != NULL))
+        cancelWarmUp (false);
+
+    if (reader.m_epoch != m_epoch || reader.m_applied < m_log_begin) {
+        reader.open ();
+    }
+    else {
+        for (; reader.m_applied < m_log_begin + m_log.size (); reader.m_applied++) {
+            const Change &change = m_log[reader.m_applied - m_log_begin];
+            if (!reader.m_shared) {
+                reader.m_buffer = "BEGIN TRANSACTION;\n";
+                reader.m_buffer << change.sql;
+                reader.m_buffer << "COMMIT;\n";
+                execute_sql (reader.m_db, reader.m_buffer);
+            }
+            for (size_t i = 0; i < change.phrases.size (); i++)
+                reader.m_filter.add (change.phrases[i].len,
+                                     (const guint8 *) change.phrases[i].pinyin_id);
+        }
+        reader.m_generation = g_atomic_int_get (&m_generation);
+        reader.flushQueryCache ();
+        trimLog ();
+    }
+    g_mutex_unlock (&m_mutex);
+}
+
+/* drops the changes applied by all readers in use, an idle reader or a
+ * reader behind by more than DB_MAX_LOG changes copies the master. Called
+ * with m_mutex locked */
+void
+Database::trimLog (void)
+{
+    guint64 end = m_log_begin + m_log.size ();
+    guint64 applied = end;
+    for (size_t i = 0; i < m_readers.size (); i++) {
+        const Reader *reader = m_readers[i];
+        if (!reader->m_idle && reader->m_epoch == m_epoch)
+            applied = MIN (applied, reader->m_applied);
+    }
+    if (end - applied > DB_MAX_LOG)
+        applied = end - DB_MAX_LOG;
+
+    while (m_log_begin < applied) {
+        m_log.pop_front ();
+        m_log_begin++;
+    }
+}
+
+Database::Reader &
+Database::reader (void)
+{
+    ReaderSlot *slot = static_cast<ReaderSlot *> (g_private_get (&m_thread_reader));
+    if (G_LIKELY (slot != NULL && slot->serial == m_serial))
+        return *slot->reader;
+
+    /* reuse the reader of an exited thread, its caches are still warm */
+    g_mutex_lock (&m_mutex);
+    Reader *reader = NULL;
+    for (size_t i = 0; i < m_readers.size () && reader == NULL; i++) {
+        if (m_readers[i]->m_idle)
+            reader = m_readers[i];
+    }
+    if (reader == NULL) {
+        reader = new Reader (*this);
+        reader->open ();
+        m_readers.push_back (reader);
+    }
+    reader->m_idle = false;
+    g_mutex_unlock (&m_mutex);
+
+    if (slot == NULL) {
+        slot = new ReaderSlot;
+        g_private_set (&m_thread_reader, slot);
+    }
+    slot->serial = m_serial;
+    slot->reader = reader;
+    return *reader;
+}
+
+void
+Database::releaseReader (gpointer data)
+{
+    ReaderSlot *slot = static_cast<ReaderSlot *> (data);
+
+    /* the reader is deleted with an instance which is gone */
+    g_mutex_lock (&m_mutex);
+    if (slot->serial == m_serials)
+        slot->reader->m_idle = true;
+    g_mutex_unlock (&m_mutex);
+    delete slot;
+}
+
+Database::Reader::Reader (Database &database)
+    : m_database (database)
+    , m_db (NULL)
+    , m_applied (0)
+    , m_epoch (0)
+    , m_idle (false)
+    , m_shared (false)
+    , m_generation (0)
+    , m_stmt_cache_hits (0)
+    , m_stmt_cache_misses (0)
+    , m_query_cache_hits (0)
+    , m_query_cache_misses (0)
+    , m_filter_skips (0)
+{
+    g_mutex_init (&m_mutex);
+}
+
+Database::Reader::~Reader (void)
+{
+    close ();
+    g_mutex_clear (&m_mutex);
+}
+
+/* opens a connection to the main database with a copy of the master user
+ * database. The first reader uses the connection of the writer instead, so
+ * a single thread never copies the user database. Called with
+ * Database::m_mutex locked, which is released while the copy is made, so a
+ * large user database does not hold up the other threads */
+bool
+Database::Reader::open (void)
+{
+    close ();
+    if (m_database.m_db == NULL) {
+        sync ();
+        return false;
+    }
+
+    if (m_database.m_shared_reader == NULL || m_database.m_shared_reader == this) {
+        m_database.m_shared_reader = this;
+        m_db = m_database.m_db;
+        m_shared = true;
+        sync ();
+        return true;
+    }
+
+    g_mutex_unlock (&Database::m_mutex);
+    bool opened = false;
+    do {
+        if (sqlite3_open_v2 (m_database.m_main_db, &m_db,
+            SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL) != SQLITE_OK)
+            break;
+        if (!setup_db (m_db))
+            break;
+        if (!execute_sql (m_db, "ATTACH DATABASE \":memory:\" AS userdb;"))
+            break;
+        opened = true;
+    } while (0);
+    g_mutex_lock (&Database::m_mutex);
+
+    while (opened && m_database.m_db != NULL) {
+        /* the master is changed by its own connection, so the backup
+         * starts over on a change, and the rest is copied with the lock
+         * held once the changes keep it from finishing. A merge switches
+         * to another master */
+        unsigned int epoch = m_database.m_epoch;
+        sqlite3_backup *backup = sqlite3_backup_init (m_db, "userdb",
+                                                      m_database.m_db, "userdb");
+        if (backup == NULL)
+            break;
+        sqlite3_backup_step (backup, 0);
+        g_mutex_unlock (&Database::m_mutex);
+        int remaining = sqlite3_backup_remaining (backup);
+        for (int restarts = 0; remaining > DB_BACKUP_PAGES && restarts < DB_BACKUP_RESTARTS; ) {
+            if (sqlite3_backup_step (backup, DB_BACKUP_PAGES) != SQLITE_OK)
+                break;
+            int left = sqlite3_backup_remaining (backup);
+            if (left >= remaining)
+                restarts++;
+            remaining = left;
+        }
+        g_mutex_lock (&Database::m_mutex);
+
+        if (epoch == m_database.m_epoch)
+            sqlite3_backup_step (backup, -1);
+        if (sqlite3_backup_finish (backup) != SQLITE_OK)
+            break;
+        if (epoch == m_database.m_epoch) {
+            sync ();
+            return true;
+        }
+    }
+
+    g_warning ("can not open a reader of the database: %s", sqlite3_errmsg (m_db));
+    close ();
+    sync ();
+    return false;
+}
+
+/* the copy has every logged change. Called with Database::m_mutex locked */
+void
+Database::Reader::sync (void)
+{
+    m_applied = m_database.m_log_begin + m_database.m_log.size ();
+    m_epoch = m_database.m_epoch;
+    m_generation = g_atomic_int_get (&m_database.m_generation);
+}
+
+/* the old connection is closed when the last stmt still stepped by a
+ * Query is finalized. Called with Database::m_mutex locked */
+void
+Database::Reader::close (void)
+{
+    m_stmt_cache.clear ();
+    flushQueryCache ();
+    m_filter.clear ();
+    if (m_db != NULL && !m_shared)
+        sqlite3_close_v2 (m_db);
+    if (m_db != NULL && m_db == m_database.m_retired_db) {
+        /* the connection replaced by mergeUserDB */
+        sqlite3_close_v2 (m_db);
+        m_database.m_retired_db = NULL;
+    }
+    m_db = NULL;
+    m_shared = false;
 }
 
 inline static bool
@@ -534,129 +1306,452 @@ pinyin_option_check_yun (unsigned int option, unsigned int id, unsigned int fid)
     }
 }
 
-SQLStmtPtr
-Database::query (const PinyinArray &pinyin,
-                 size_t             pinyin_begin,
-                 size_t             pinyin_len,
-                 int                m,
-                 unsigned int       option)
+/* Every syllable owns DB_PARAM_STRIDE sql parameters:
+ * up to three shengs and two yuns. */
+#define DB_PARAM_STRIDE     (5)
+#define DB_PARAM(i, n)      ((int) (i) * DB_PARAM_STRIDE + (n) + 1)
+#define DB_PARAM_YUN        (3)
+/* the most arms of an incomplete span, see querySql */
+#define DB_MAX_ARMS         (16)
+
+/* the set of ids a syllable matches, a zero yun matches all yuns */
+inline static PinyinIdSet
+pinyin_id_set (const Pinyin *p, unsigned int option)
 {
-    g_assert (pinyin_begin < pinyin.size ());
-    g_assert (pinyin_len <= pinyin.size () - pinyin_begin);
-    g_assert (pinyin_len <= MAX_PHRASE_LEN);
+    PinyinIdSet set = PINYIN_ID_BIT (p->pinyin_id[0].sheng);
 
-    /* prepare sql */
-    Conditions conditions;
+    if (pinyin_option_check_sheng (option, p->pinyin_id[0].sheng, p->pinyin_id[1].sheng))
+        set |= PINYIN_ID_BIT (p->pinyin_id[1].sheng);
+    if (pinyin_option_check_sheng (option, p->pinyin_id[0].sheng, p->pinyin_id[2].sheng))
+        set |= PINYIN_ID_BIT (p->pinyin_id[2].sheng);
 
-    for (size_t i = 0; i < pinyin_len; i++) {
-        const Pinyin *p;
-        bool fs1, fs2;
-        p = pinyin[i + pinyin_begin];
+    if (p->pinyin_id[0].yun == PINYIN_ID_ZERO)
+        return set | PINYIN_YUN_MASK;
+
+    set |= PINYIN_ID_BIT (p->pinyin_id[0].yun);
+    if (pinyin_option_check_yun (option, p->pinyin_id[0].yun, p->pinyin_id[1].yun))
+        set |= PINYIN_ID_BIT (p->pinyin_id[1].yun);
+
+    return set;
+}
+
+/* writes the ids in set & mask to ids, returns the number of them */
+inline static size_t
+pinyin_id_set_get (PinyinIdSet set, PinyinIdSet mask, unsigned int *ids)
+{
+    size_t n = 0;
+    set &= mask;
+    for (unsigned int id = 0; set != 0; id++, set >>= 1) {
+        if (set & 1)
+            ids[n++] = id;
+    }
+    return n;
+}
+
+/* the shape of a syllable decides the sql text of the syllable:
+ * the number of shengs, and the number of yuns or 0 for any yun */
+inline static char
+pinyin_id_set_shape (PinyinIdSet set)
+{
+    unsigned int ids[PINYIN_ID_NUM];
+    size_t shengs = pinyin_id_set_get (set, PINYIN_SHENG_MASK, ids);
+    size_t yuns = (set & PINYIN_YUN_MASK) == PINYIN_YUN_MASK ?
+                  0 : pinyin_id_set_get (set, PINYIN_YUN_MASK, ids);
+    g_assert (shengs <= DB_PARAM_YUN && yuns <= DB_PARAM_STRIDE - DB_PARAM_YUN);
+    return '0' + shengs * DB_PARAM_STRIDE + yuns;
+}
+
+inline static void
+column_in_sql (String &sql, char column, size_t i, size_t n, int param)
+{
+    if (n == 1) {
+        sql.appendPrintf ("%c%d=?%d", column, i, param);
+        return;
+    }
+    sql.appendPrintf ("%c%d IN (?%d", column, i, param);
+    for (size_t j = 1; j < n; j++)
+        sql.appendPrintf (",?%d", param + j);
+    sql << ')';
+}
+
+bool
+Database::Reader::mayExist (const PinyinIdSet *sets, size_t len)
+{
+    if (len < DB_FILTER_MIN_LEN)
+        return true;
+    if (G_UNLIKELY (!m_filter.isBuilt (len)))
+        buildFilter (len);
+    return m_filter.mayExist (sets, len);
+}
+
+/* appends the sheng and yun ids of the phrases of len syllables in a
+ * database */
+void
+Database::Reader::readFilterIds (const char *db, size_t len, std::vector<guint8> &ids)
+{
+    String sql ("SELECT s0,y0");
+    for (size_t i = 1; i < len; i++)
+        sql << ",s" << i << ",y" << i;
+    sql << " FROM " << db << ".py_phrase_" << len - 1;
+
+    SQLStmt stmt (m_db);
+    if (!stmt.prepare (sql))
+        return;
+    while (stmt.step ()) {
+        for (size_t i = 0; i < (len << 1); i++)
+            ids.push_back (stmt.columnInt (i));
+    }
+}
+
+void
+Database::Reader::buildFilter (size_t len)
+{
+    const PhraseDict &dict = m_database.m_dict;
+    std::vector<guint8> ids;
+    if (dict.isOpen ()) {
+        guint32 size = dict.size (len);
+        ids.reserve ((gsize) size * (len << 1));
+        for (guint32 r = 0; r < size; r++)
+            ids.insert (ids.end (), dict.ids (len, r), dict.ids (len, r) + (len << 1));
+    }
+    else if (m_db != NULL) {
+        readFilterIds ("main", len, ids);
+    }
+    if (m_db != NULL)
+        readFilterIds ("userdb", len, ids);
+
+    size_t num = ids.size () / (len << 1);
+    m_filter.build (len, num + num / 4 + DB_FILTER_HEADROOM);
+    for (size_t i = 0; i < num; i++)
+        m_filter.add (len, &ids[i * (len << 1)]);
+}
 
-        fs1 = pinyin_option_check_sheng (option, p->pinyin_id[0].sheng, p->pinyin_id[1].sheng);
-        fs2 = pinyin_option_check_sheng (option, p->pinyin_id[0].sheng, p->pinyin_id[2].sheng);
+/* the conditions of the first len syllables. An arm of an incomplete
+ * span takes one sheng of every syllable, arm is the number of the
+ * combination in digits of the sheng counts. A negative arm takes all
+ * shengs by IN lists */
+inline static void
+conditions_sql (String &sql, const char *shapes, size_t len, long arm)
+{
+    for (size_t i = 0; i < len; i++) {
+        size_t shengs = (shapes[i] - '0') / DB_PARAM_STRIDE;
+        size_t yuns = (shapes[i] - '0') % DB_PARAM_STRIDE;
 
         if (G_LIKELY (i > 0))
-            conditions.appendPrintf (0, conditions.size (),
-                                       " AND ");
-
-        if (G_UNLIKELY (fs1 || fs2)) {
-            if (G_LIKELY (i < DB_INDEX_SIZE)) {
-                if (fs1 && fs2 == 0) {
-                    conditions.double_ ();
-                    conditions.appendPrintf (0, conditions.size ()  >> 1,
-                                               "s%d=%d", i, p->pinyin_id[0].sheng);
-                    conditions.appendPrintf (conditions.size () >> 1, conditions.size (),
-                                               "s%d=%d", i, p->pinyin_id[1].sheng);
-                }
-                else if (fs1 == 0 && fs2) {
-                    conditions.double_ ();
-                    conditions.appendPrintf (0, conditions.size ()  >> 1,
-                                               "s%d=%d", i, p->pinyin_id[0].sheng);
-                    conditions.appendPrintf (conditions.size () >> 1, conditions.size (),
-                                               "s%d=%d", i, p->pinyin_id[2].sheng);
-                }
-                else {
-                    size_t len = conditions.size ();
-                    conditions.triple ();
-                    conditions.appendPrintf (0, len,
-                                               "s%d=%d", i, p->pinyin_id[0].sheng);
-                    conditions.appendPrintf (len, len << 1,
-                                               "s%d=%d", i, p->pinyin_id[1].sheng);
-                    conditions.appendPrintf (len << 1, conditions.size (),
-                                               "s%d=%d", i, p->pinyin_id[2].sheng);
-                }
-            }
-            else {
-                if (fs1 && fs2 == 0) {
-                    conditions.appendPrintf (0, conditions.size (),
-                                               "s%d IN (%d,%d)", i, p->pinyin_id[0].sheng, p->pinyin_id[1].sheng);
-                }
-                else if (fs1 == 0 && fs2) {
-                    conditions.appendPrintf (0, conditions.size (),
-                                               "s%d IN (%d,%d)", i, p->pinyin_id[0].sheng, p->pinyin_id[2].sheng);
-                }
-                else {
-                    conditions.appendPrintf (0, conditions.size (),
-                                               "s%d IN (%d,%d,%d)", i, p->pinyin_id[0].sheng, p->pinyin_id[1].sheng, p->pinyin_id[2].sheng);
-                }
-            }
+            sql << " AND ";
+        if (arm < 0) {
+            column_in_sql (sql, 's', i, shengs, DB_PARAM (i, 0));
         }
         else {
-            conditions.appendPrintf (0, conditions.size (),
-                                       "s%d=%d", i, p->pinyin_id[0].sheng);
-        }
-
-        if (p->pinyin_id[0].yun != PINYIN_ID_ZERO) {
-            if (pinyin_option_check_yun (option, p->pinyin_id[0].yun, p->pinyin_id[1].yun)) {
-                if (G_LIKELY (i < DB_INDEX_SIZE)) {
-                    conditions.double_ ();
-                    conditions.appendPrintf (0, conditions.size ()  >> 1,
-                                               " AND y%d=%d", i, p->pinyin_id[0].yun);
-                    conditions.appendPrintf (conditions.size () >> 1, conditions.size (),
-                                               " and y%d=%d", i, p->pinyin_id[1].yun);
-                }
-                else {
-                    conditions.appendPrintf (0, conditions.size (),
-                                               " AND y%d IN (%d,%d)", i, p->pinyin_id[0].yun, p->pinyin_id[1].yun);
-                }
-            }
-            else {
-                conditions.appendPrintf (0, conditions.size (),
-                                           " AND y%d=%d", i, p->pinyin_id[0].yun);
-            }
+            column_in_sql (sql, 's', i, 1, DB_PARAM (i, arm % shengs));
+            arm /= shengs;
+        }
+        if (yuns != 0) {
+            sql << " AND ";
+            column_in_sql (sql, 'y', i, yuns, DB_PARAM (i, DB_PARAM_YUN));
         }
     }
+}
 
-
-    m_buffer.clear ();
-    for (size_t i = 0; i < conditions.size (); i++) {
-        if (G_UNLIKELY (i == 0))
-            m_buffer << "  (" << conditions[i] << ")\n";
-        else
-            m_buffer << "  OR (" << conditions[i] << ")\n";
+/* the number of arms of an incomplete span of len syllables, or 0 for a
+ * span of complete syllables or with too many combinations of shengs */
+inline static long
+incomplete_arms (const char *shapes, size_t len)
+{
+    long arms = 1;
+    bool incomplete = false;
+    for (size_t i = 0; i < len; i++) {
+        arms *= (shapes[i] - '0') / DB_PARAM_STRIDE;
+        if ((shapes[i] - '0') % DB_PARAM_STRIDE == 0)
+            incomplete = true;
     }
+    return incomplete && arms <= DB_MAX_ARMS ? arms : 0;
+}
 
+void
+Database::Reader::querySql (const char *shapes, size_t pinyin_len, size_t pinyin_min_len,
+                            int m, bool userdb)
+{
+    /* all lengths have the columns of the longest one, and the length
+     * after them. sqlite runs the lengths of a UNION ALL one by one, so a
+     * shorter length is only looked up when the longer ones are read.
+     * Both databases are read as streams ordered by freq, Query merges
+     * them, so sqlite never sorts phrases of both.
+     *
+     * Every syllable is one conjunction with IN lists. Incomplete pinyin
+     * matches many phrases, which sqlite would sort, so such a length is
+     * a UNION ALL of one arm for every combination of the shengs. An arm
+     * reads the initials index index_N_2 in freq order, and sqlite merges
+     * the arms */
     m_sql.clear ();
-    int id = pinyin_len - 1;
-    m_sql << "SELECT * FROM ("
-                "SELECT 0 AS user_freq, * FROM main.py_phrase_" << id << " WHERE " << m_buffer << " UNION ALL "
-                "SELECT * FROM userdb.py_phrase_" << id << " WHERE " << m_buffer << ") "
-                    "GROUP BY phrase ORDER BY user_freq DESC, freq DESC";
+    for (size_t len = pinyin_len; len >= pinyin_min_len; len--) {
+        if (len < pinyin_len)
+            m_sql << " UNION ALL ";
+        if (pinyin_min_len < pinyin_len)
+            m_sql << "SELECT * FROM (";
+
+        long arms = incomplete_arms (shapes, len);
+        for (long arm = 0; arm < MAX (arms, 1); arm++) {
+            if (arm > 0)
+                m_sql << " UNION ALL ";
+            m_sql << "SELECT " << (userdb ? "user_freq" : "0 AS user_freq") << ",phrase,freq";
+            for (size_t i = 0; i < pinyin_len; i++) {
+                if (i < len)
+                    m_sql << ",s" << i << ",y" << i;
+                else
+                    m_sql << ",0,0";
+            }
+            m_sql << ',' << len << " AS len"
+                  << (userdb || m_database.m_main_trad ? ",trad" : ",NULL AS trad")
+                  << " FROM " << (userdb ? "userdb" : "main")
+                  << ".py_phrase_" << len - 1 << " WHERE ";
+            conditions_sql (m_sql, shapes, len, arms > 0 ? arm : -1);
+        }
+
+        if (userdb)
+            m_sql << " ORDER BY user_freq DESC, freq DESC";
+        else
+            m_sql << " ORDER BY freq DESC";
+        if (pinyin_min_len < pinyin_len)
+            m_sql << ')';
+    }
     if (m > 0)
         m_sql << " LIMIT " << m;
 #if 0
     g_debug ("sql =\n%s", m_sql.c_str ());
 #endif
+}
+
+PhraseStreamPtr
+Database::Reader::query (const PinyinArray &pinyin,
+                         size_t             pinyin_begin,
+                         size_t             pinyin_len,
+                         size_t             pinyin_min_len,
+                         int                m,
+                         unsigned int       option,
+                         bool               userdb)
+{
+    g_assert (pinyin_begin < pinyin.size ());
+    g_assert (pinyin_len <= pinyin.size () - pinyin_begin);
+    g_assert (pinyin_len <= MAX_PHRASE_LEN);
+    g_assert (pinyin_min_len > 0 && pinyin_min_len <= pinyin_len);
+
+    PinyinIdSet sets[MAX_PHRASE_LEN];
+    for (size_t i = 0; i < pinyin_len; i++)
+        sets[i] = pinyin_id_set (pinyin[i + pinyin_begin], option);
+
+    /* leave out the longest and the shortest lengths without phrases */
+    while (pinyin_len >= pinyin_min_len && !mayExist (sets, pinyin_len)) {
+        g_atomic_int_inc (&m_filter_skips);
+        pinyin_len --;
+    }
+    while (pinyin_min_len < pinyin_len && !mayExist (sets, pinyin_min_len)) {
+        g_atomic_int_inc (&m_filter_skips);
+        pinyin_min_len ++;
+    }
+    if (pinyin_len < pinyin_min_len)
+        return PhraseStreamPtr (new EmptyPhraseStream);
+
+    /* the cache key is the shape of every syllable, the shortest length
+     * and the limit */
+    char shapes[MAX_PHRASE_LEN + 1];
+    for (size_t i = 0; i < pinyin_len; i++)
+        shapes[i] = pinyin_id_set_shape (sets[i]);
+    shapes[pinyin_len] = '\0';
+
+    if (!userdb && m_database.m_dict.isOpen ())
+        return PhraseStreamPtr (new DictPhraseStream (m_database.m_dict, sets,
+                                                      pinyin_len, pinyin_min_len));
+
+    /* sqlite keeps the IN lists of every length of a stmt until it is
+     * reset, for the small user database that costs more than a stmt of
+     * every length */
+    if (userdb && pinyin_min_len < pinyin_len)
+        return PhraseStreamPtr (new LengthsPhraseStream (*this, pinyin, pinyin_begin, pinyin_len,
+                                                         pinyin_min_len, m, option, userdb));
+
+    String key (userdb ? "u:" : "m:");
+    key << shapes << ':' << pinyin_min_len << ':' << (m > 0 ? m : 0);
+
+    SQLStmtPtr stmt;
+    StmtCache::iterator it = m_stmt_cache.find (key);
+
+    /* a cached stmt may still be stepped by another Query */
+    if (it != m_stmt_cache.end () && it->second.unique ()) {
+        g_atomic_int_inc (&m_stmt_cache_hits);
+        stmt = it->second;
+        stmt->reset ();
+    }
+    else {
+        g_atomic_int_inc (&m_stmt_cache_misses);
+        querySql (shapes, pinyin_len, pinyin_min_len, m, userdb);
+
+        stmt.reset (new SQLStmt (m_db));
+        if (!stmt->prepare (m_sql))
+            return PhraseStreamPtr ();
+
+        if (it == m_stmt_cache.end ()) {
+            if (m_stmt_cache.size () >= DB_STMT_CACHE_SIZE)
+                flushStmtCache ();
+            m_stmt_cache[key] = stmt;
+        }
+    }
+
+    /* bind the ids, only parameters used by the shape exist in the stmt */
+    for (size_t i = 0; i < pinyin_len; i++) {
+        unsigned int ids[PINYIN_ID_NUM];
+        size_t n = pinyin_id_set_get (sets[i], PINYIN_SHENG_MASK, ids);
+        for (size_t j = 0; j < n; j++)
+            stmt->bindInt (DB_PARAM (i, j), ids[j]);
+
+        if ((sets[i] & PINYIN_YUN_MASK) == PINYIN_YUN_MASK)
+            continue;
+        n = pinyin_id_set_get (sets[i], PINYIN_YUN_MASK, ids);
+        for (size_t j = 0; j < n; j++)
+            stmt->bindInt (DB_PARAM (i, DB_PARAM_YUN + j), ids[j]);
+    }
+
+    return PhraseStreamPtr (new SQLPhraseStream (stmt, pinyin_len));
+}
+
+QueryResultPtr
+Database::Reader::queryResult (const PinyinArray &pinyin,
+                               size_t             pinyin_begin,
+                               size_t             pinyin_len,
+                               unsigned int       option)
+{
+    g_assert (pinyin_begin < pinyin.size ());
+    g_assert (pinyin_len <= pinyin.size () - pinyin_begin);
+
+    m_database.catchUp (*this);
+
+    size_t cache_size = g_atomic_int_get (&m_database.m_query_cache_size);
+    while (m_query_cache.size () > cache_size) {
+        m_query_cache.erase (m_query_cache_lru.back ());
+        m_query_cache_lru.pop_back ();
+    }
 
-    /* query database */
-    SQLStmtPtr stmt (new SQLStmt (m_db));
+    std::string key;
+    key.reserve (sizeof (option) + sizeof (m_generation) +
+                 pinyin_len * sizeof (pinyin[0]->pinyin_id));
+    key.append ((const char *) &option, sizeof (option));
+    key.append ((const char *) &m_generation, sizeof (m_generation));
+    for (size_t i = 0; i < pinyin_len; i++) {
+        const Pinyin *p = pinyin[i + pinyin_begin];
+        key.append ((const char *) p->pinyin_id, sizeof (p->pinyin_id));
+    }
 
-    if (!stmt->prepare (m_sql)) {
-        stmt.reset ();
+    QueryCache::iterator it = m_query_cache.find (key);
+    if (it != m_query_cache.end ()) {
+        g_atomic_int_inc (&m_query_cache_hits);
+        m_query_cache_lru.splice (m_query_cache_lru.begin (),
+                                  m_query_cache_lru, it->second.lru);
+        return it->second.result;
     }
 
-    return stmt;
+    g_atomic_int_inc (&m_query_cache_misses);
+    QueryResultPtr result (new QueryResult);
+    if (cache_size == 0)
+        return result;
+
+    if (m_query_cache.size () >= cache_size) {
+        m_query_cache.erase (m_query_cache_lru.back ());
+        m_query_cache_lru.pop_back ();
+    }
+    m_query_cache_lru.push_front (key);
+    QueryCacheItem &item = m_query_cache[key];
+    item.result = result;
+    item.lru = m_query_cache_lru.begin ();
+
+    return result;
+}
+
+void
+Database::Reader::flushQueryCache (void)
+{
+    m_query_cache.clear ();
+    m_query_cache_lru.clear ();
+}
+
+void
+Database::Reader::flushStmtCache (void)
+{
+    /* drop all stmts which are not used by any Query */
+    StmtCache::iterator it = m_stmt_cache.begin ();
+    while (it != m_stmt_cache.end ()) {
+        if (it->second.unique ())
+            m_stmt_cache.erase (it++);
+        else
+            ++it;
+    }
+}
+
+void
+Database::setQueryCacheSize (size_t size)
+{
+    /* the readers trim their caches at their next lookups */
+    g_atomic_int_set (&m_query_cache_size, size);
+}
+
+unsigned int
+Database::sumStatistic (volatile gint Reader::*counter) const
+{
+    unsigned int sum = 0;
+    g_mutex_lock (&m_mutex);
+    for (size_t i = 0; i < m_readers.size (); i++)
+        sum += g_atomic_int_get (&(m_readers[i]->*counter));
+    g_mutex_unlock (&m_mutex);
+    return sum;
+}
+
+unsigned int
+Database::stmtCacheHits (void) const
+{
+    return sumStatistic (&Reader::m_stmt_cache_hits);
+}
+
+unsigned int
+Database::stmtCacheMisses (void) const
+{
+    return sumStatistic (&Reader::m_stmt_cache_misses);
+}
+
+unsigned int
+Database::queryCacheHits (void) const
+{
+    return sumStatistic (&Reader::m_query_cache_hits);
+}
+
+unsigned int
+Database::queryCacheMisses (void) const
+{
+    return sumStatistic (&Reader::m_query_cache_misses);
+}
+
+unsigned int
+Database::filterSkips (void) const
+{
+    return sumStatistic (&Reader::m_filter_skips);
+}
+
+gsize
+Database::filterMemory (void)
+{
+    Reader &reader = this->reader ();
+    reader.lock ();
+    gsize memory = reader.m_filter.memory ();
+    reader.unlock ();
+    return memory;
+}
+
+double
+Database::filterFalsePositiveRate (void)
+{
+    Reader &reader = this->reader ();
+    reader.lock ();
+    double rate = reader.m_filter.falsePositiveRate ();
+    reader.unlock ();
+    return rate;
 }
 
 inline void
@@ -674,7 +1769,7 @@ Database::phraseWhereSql (const Phrase & p, String & sql)
 }
 
 inline void
-Database::phraseSql (const Phrase & p, String & sql)
+Database::phraseSql (const Phrase & p, const char *trad, String & sql)
 {
     sql << "INSERT OR IGNORE INTO userdb.py_phrase_" << p.len - 1
         << " VALUES(" << 0                  /* user_freq */
@@ -685,10 +1780,15 @@ Database::phraseSql (const Phrase & p, String & sql)
         sql << ',' << p.pinyin_id[i].sheng << ',' << p.pinyin_id[i].yun;
     }
 
-    sql << ");\n";
+    if (trad != NULL)
+        sql << ",\"" << trad << "\");\n";  /* trad */
+    else
+        sql << ",NULL);\n";
 
     sql << "UPDATE userdb.py_phrase_" << p.len - 1
         << " SET user_freq=user_freq+1";
+    if (trad != NULL)
+        sql << ",trad=\"" << trad << '"';
 
     phraseWhereSql (p, sql);
     sql << ";\n";
@@ -698,38 +1798,49 @@ void
 Database::commit (const PhraseArray  &phrases)
 {
     Phrase phrase = {""};
+    PhraseArray learned (phrases);
+    String trad;
+    bool trad_known = true;
 
-    m_sql = "BEGIN TRANSACTION;\n";
+    g_mutex_lock (&m_mutex);
+    m_sql.clear ();
     for (size_t i = 0; i < phrases.size (); i++) {
         phrase += phrases[i];
-        phraseSql (phrases[i], m_sql);
+        phraseSql (phrases[i], phrases[i].trad (), m_sql);
+        /* the sentence is known if all its phrases are */
+        if (phrases[i].trad () != NULL)
+            trad << phrases[i].trad ();
+        else
+            trad_known = false;
+    }
+    if (phrases.size () > 1) {
+        phraseSql (phrase, trad_known ? trad.c_str () : NULL, m_sql);
+        learned.push_back (phrase);
     }
-    if (phrases.size () > 1)
-        phraseSql (phrase, m_sql);
-    m_sql << "COMMIT;\n";
 
-    executeSQL (m_sql);
-    modified ();
+    modify (m_sql, learned);
+    g_mutex_unlock (&m_mutex);
 }
 
 void
 Database::remove (const Phrase & phrase)
 {
-    m_sql = "BEGIN TRANSACTION;\n";
-    m_sql << "DELETE FROM userdb.py_phrase_" << phrase.len - 1;
+    g_mutex_lock (&m_mutex);
+    m_sql = "DELETE FROM userdb.py_phrase_";
+    m_sql << phrase.len - 1;
     phraseWhereSql (phrase, m_sql);
     m_sql << ";\n";
-    m_sql << "COMMIT;\n";
 
-    executeSQL (m_sql);
-    modified ();
+    modify (m_sql, PhraseArray ());
+    g_mutex_unlock (&m_mutex);
 }
 
 void
-Database::init (const std::string & user_data_dir)
+Database::init (const std::string & user_data_dir, bool lazy_userdb,
+                const std::string & main_db)
 {
     if (m_instance.get () == NULL) {
-        m_instance.reset (new Database (user_data_dir));
+        m_instance.reset (new Database (user_data_dir, lazy_userdb, main_db));
     }
 }
 
@@ -22,9 +22,19 @@
 #ifndef __PYZY_DATABASE_H_
 #define __PYZY_DATABASE_H_
 
+#include <glib.h>
+#include <deque>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+
 #include "PhraseArray.h"
+#include "PhraseDict.h"
+#include "PhraseFilter.h"
 #include "String.h"
 #include "Types.h"
+#include "UserDBWriter.h"
 #include "Util.h"
 
 typedef struct sqlite3 sqlite3;
@@ -37,44 +47,91 @@ struct Phrase;
 class SQLStmt;
 typedef std::shared_ptr<SQLStmt> SQLStmtPtr;
 
+/* a source of phrases ordered by user_freq and freq */
+class PhraseStream {
+public:
+    virtual ~PhraseStream (void) { }
+    virtual bool next (Phrase &phrase) = 0;
+};
+typedef std::shared_ptr<PhraseStream> PhraseStreamPtr;
+
 class Database;
 
-class Query {
-public:
-    Query (const PinyinArray    & pinyin,
-           size_t                 pinyin_begin,
-           size_t                 pinyin_len,
-           unsigned int           option);
-    ~Query (void);
-    int fill (PhraseArray &phrases, int count);
+/* phrases of a pinyin span in one length, shared by Querys through the
+ * query cache of a Database::Reader */
+struct QueryResult {
+    PhraseArray phrases;
+    bool complete;          /* all phrases are in phrases */
 
-private:
-    const PinyinArray & m_pinyin;
-    size_t m_pinyin_begin;
-    size_t m_pinyin_len;
-    unsigned int m_option;
-    SQLStmtPtr m_stmt;
+    QueryResult (void) : complete (false) { }
 };
+typedef std::shared_ptr<QueryResult> QueryResultPtr;
 
+/*
+ * Database is shared by all threads. Every thread looks up phrases by its
+ * own Reader: a connection to the main database with a copy of the user
+ * database in memory, and the caches of its lookups. Changes of the user
+ * database are made by one writer under a lock, to a master copy, and are
+ * logged; a reader applies the logged changes before its next lookup.
+ * The first reader shares the connection of the writer instead of a copy.
+ */
 class Database {
 public:
+    class Reader;
+
     ~Database ();
 protected:
-    Database (const std::string & user_data_dir);
+    Database (const std::string & user_data_dir, bool lazy_userdb,
+              const std::string & main_db);
 
 public:
-    static void init (const std::string & data_dir);
+    /* with lazy_userdb, the user database is loaded by a thread, and only
+     * the main database is queried until it is merged. main_db is opened
+     * instead of the installed main databases if it is not empty */
+    static void init (const std::string & data_dir, bool lazy_userdb = false,
+                      const std::string & main_db = "");
+
+    /* the reader of the calling thread, it is reused by another thread
+     * once the thread exits */
+    Reader & reader (void);
 
-    SQLStmtPtr query (const PinyinArray   & pinyin,
-                      size_t                pinyin_begin,
-                      size_t                pinyin_len,
-                      int                   m,
-                      unsigned int          option);
     void commit (const PhraseArray  & phrases);
     void remove (const Phrase & phrase);
 
-    void conditionsDouble (void);
-    void conditionsTriple (void);
+    /* statistics of the prepared stmt caches of all readers */
+    unsigned int stmtCacheHits (void) const;
+    unsigned int stmtCacheMisses (void) const;
+
+    /* the query cache of a reader keeps phrases of pinyin spans across key
+     * strokes */
+    void setQueryCacheSize (size_t size);
+    unsigned int queryCacheHits (void) const;
+    unsigned int queryCacheMisses (void) const;
+
+    /* the existence filter leaves out the lengths of spans which have no
+     * phrases in both databases. The memory and the false positive rate
+     * are of the filter of the calling thread */
+    unsigned int filterSkips (void) const;
+    gsize filterMemory (void);
+    double filterFalsePositiveRate (void);
+
+    /* waits for the lazily loaded user database and merges it */
+    void waitUserDB (void);
+
+    /* reads the main dictionary by a thread in the order queries use it,
+     * until max_bytes are read or max_msec passed (0 for no limit), so the
+     * first queries do not wait for the disk. It is cancelled by the first
+     * query */
+    void warmUp (size_t max_bytes, unsigned int max_msec);
+
+    /* changes whenever the user database is modified */
+    unsigned int generation (void) const        { return g_atomic_int_get (&m_generation); }
+
+    /* the freq of a phrase of the main database is about freqPerE () times
+     * the log of its share of the texts, plus freqZero (). freqPerE () is 0
+     * if the main database does not tell */
+    guint32 freqPerE (void) const               { return m_freq_per_e; }
+    gint32 freqZero (void) const                { return m_freq_zero; }
 
     static void finalize (void);
     static Database & instance (void)
@@ -88,27 +145,207 @@ public:
 private:
     bool open (void);
     bool loadUserDB (void);
-    bool saveUserDB (void);
-    void prefetch (void);
-    void phraseSql (const Phrase & p, String & sql);
+    static gpointer loadUserDBThread (gpointer data);
+    void mergeUserDB (bool wait);
+    static gpointer warmUpThread (gpointer data);
+    static int warmUpProgress (gpointer data);
+    void warmUpDict (void);
+    void warmUpSQL (void);
+    bool warmUpStopped (gsize bytes) const;
+    void cancelWarmUp (bool wait);
+    void catchUp (Reader &reader);
+    void trimLog (void);
+    static void releaseReader (gpointer data);
+    void phraseSql (const Phrase & p, const char *trad, String & sql);
     void phraseWhereSql (const Phrase & p, String & sql);
     bool executeSQL (const char *sql, sqlite3 *db = NULL);
-    void modified (void);
-    static gboolean timeoutCallback (void * data);
+    void modify (const String & sql, const PhraseArray & phrases);
+    unsigned int sumStatistic (volatile gint Reader::*counter) const;
 
 private:
-    sqlite3 *m_db;              /* sqlite3 database */
+    /* the writer, guarded by m_mutex: the main database with the master
+     * copy of the user database */
+    sqlite3 *m_db;
+    const char *m_main_db;      /* file name of the main database */
+    std::string m_main_db_file; /* the main database given to init */
+    bool m_main_trad;           /* the main database has trad columns */
+    guint32 m_freq_per_e;
+    gint32 m_freq_zero;
+    PhraseDict m_dict;          /* compiled main dictionary, shared */
 
     String m_sql;        /* sql stmt */
     String m_buffer;     /* temp buffer */
-    unsigned int m_timeout_id;
-    GTimer *m_timer;
+
+    /* the changes not applied by every reader yet, m_log[0] is change
+     * number m_log_begin. A reader of an older epoch copies the master */
+    struct Change {
+        std::string sql;
+        PhraseArray phrases;    /* phrases added to the filters */
+    };
+    std::deque<Change> m_log;
+    guint64 m_log_begin;
+    unsigned int m_epoch;
+    std::vector<Reader *> m_readers;
+    Reader *m_shared_reader;    /* the reader using m_db */
+    unsigned int m_serial;
+
+    volatile gint m_generation;
+    volatile gint m_query_cache_size;
+
+    UserDBWriter m_writer;      /* writes changes to the user database file */
+
+    /* the user database loaded by a thread, and the changes made before it
+     * is merged */
+    bool m_lazy_userdb;
+    GThread * volatile m_loader;
+    volatile gint m_loader_done;
+    sqlite3 *m_loaded_db;
+    sqlite3 *m_retired_db;      /* the old m_db, closed by the shared reader */
+    String m_userdb_file;
+    String m_userdb_path;
+    std::vector<std::string> m_changes;
+
+    /* the warm up thread and its budget */
+    GThread * volatile m_warmer;
+    volatile gint m_warm_up_cancelled;
+    volatile gint m_warm_up_done;
+    gsize m_warm_up_max_bytes;
+    gint64 m_warm_up_deadline;
+
     String m_user_data_dir;
 
 private:
+    /* guards the writer, the log and the readers, it outlives instances
+     * for the threads releasing their readers */
+    static GMutex m_mutex;
+    static unsigned int m_serials;
+    static GPrivate m_thread_reader;
     static std::unique_ptr<Database> m_instance;
 };
 
+/*
+ * Reader looks up phrases for one thread. Its caches are only changed by
+ * lookups, under its lock, and by Database::catchUp before a lookup, and so
+ * is its copy of the user database unless it shares the master.
+ */
+class Database::Reader {
+public:
+    Reader (Database &database);
+    ~Reader (void);
+
+    void lock (void)    { g_mutex_lock (&m_mutex); }
+    void unlock (void)  { g_mutex_unlock (&m_mutex); }
+
+    /* phrases of pinyin_len down to pinyin_min_len syllables, longest
+     * first, by one lookup */
+    PhraseStreamPtr query (const PinyinArray   & pinyin,
+                           size_t                pinyin_begin,
+                           size_t                pinyin_len,
+                           size_t                pinyin_min_len,
+                           int                   m,
+                           unsigned int          option,
+                           bool                  userdb);
+    QueryResultPtr queryResult (const PinyinArray   & pinyin,
+                                size_t                pinyin_begin,
+                                size_t                pinyin_len,
+                                unsigned int          option);
+
+private:
+    friend class Database;
+    bool open (void);
+    void sync (void);
+    void close (void);
+    bool mayExist (const PinyinIdSet *sets, size_t len);
+    void buildFilter (size_t len);
+    void readFilterIds (const char *db, size_t len, std::vector<guint8> &ids);
+    void querySql (const char *shapes, size_t pinyin_len, size_t pinyin_min_len,
+                   int m, bool userdb);
+    void flushStmtCache (void);
+    void flushQueryCache (void);
+
+private:
+    Database & m_database;
+    GMutex m_mutex;
+    sqlite3 *m_db;
+
+    String m_sql;        /* sql stmt */
+    String m_buffer;     /* temp buffer */
+
+    /* prepared stmts keyed by the shape of the query */
+    typedef std::map<std::string, SQLStmtPtr> StmtCache;
+    StmtCache m_stmt_cache;
+
+    /* lru cache of query results keyed by the ids of a span and the
+     * option, flushed when the user database changes */
+    typedef std::list<std::string> QueryCacheList;
+    struct QueryCacheItem {
+        QueryResultPtr result;
+        QueryCacheList::iterator lru;
+    };
+    typedef std::map<std::string, QueryCacheItem> QueryCache;
+    QueryCache m_query_cache;
+    QueryCacheList m_query_cache_lru;
+
+    /* built for a length by its first query, and kept up to date by the
+     * logged changes */
+    PhraseFilter m_filter;
+
+    /* the changes applied to the copy of the user database, guarded by
+     * Database::m_mutex */
+    guint64 m_applied;
+    unsigned int m_epoch;
+    bool m_idle;                /* its thread has exited */
+    bool m_shared;              /* m_db is the connection of the writer */
+    gint m_generation;
+
+    /* statistics, read by other threads */
+    volatile gint m_stmt_cache_hits;
+    volatile gint m_stmt_cache_misses;
+    volatile gint m_query_cache_hits;
+    volatile gint m_query_cache_misses;
+    volatile gint m_filter_skips;
+};
+
+class Query {
+public:
+    /* phrases of pinyin_len syllables down to pinyin_min_len syllables,
+     * looked up by the reader of the calling thread */
+    Query (const PinyinArray    & pinyin,
+           size_t                 pinyin_begin,
+           size_t                 pinyin_len,
+           unsigned int           option,
+           size_t                 pinyin_min_len = 1);
+    ~Query (void);
+    int fill (PhraseArray &phrases, int count);
+
+private:
+    int fillPhrases (PhraseArray &phrases, int count);
+    bool next (Phrase &phrase);
+
+private:
+    const PinyinArray & m_pinyin;
+    size_t m_pinyin_begin;
+    size_t m_pinyin_len;
+    unsigned int m_option;
+    size_t m_pinyin_min_len;
+
+    /* the Query is used under the lock of the reader, so it may be moved
+     * to another thread */
+    Database::Reader & m_reader;
+
+    /* cached phrases of the current length */
+    QueryResultPtr m_result;
+    size_t m_result_pos;
+    size_t m_produced;
+
+    /* the user and the main dictionary are merged lazily, the heads
+     * hold the next phrase of every stream. The streams have all lengths
+     * down to m_pinyin_min_len, longest first */
+    std::vector<PhraseStreamPtr> m_streams;
+    PhraseArray m_heads;
+    std::set<std::string> m_phrases;
+};
+
 };  // namespace PyZy
 
 #endif  // __PYZY_DATABASE_H_
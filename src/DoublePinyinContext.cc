@@ -58,6 +58,8 @@ DoublePinyinContext::~DoublePinyinContext ()
 bool
 DoublePinyinContext::insert (char ch)
 {
+    ChangeBatch batch (this);
+
     const int id = ID (ch);
 
     if (id == -1) {
@@ -104,9 +106,58 @@ DoublePinyinContext::insert (char ch)
     }
 }
 
+bool
+DoublePinyinContext::insert (const std::string & text)
+{
+    ChangeBatch batch (this);
+
+    const size_t cursor = m_cursor;
+    size_t len = 0;
+
+    /* parses the characters as insert (char) does, and looks up the
+     * phrases once at last */
+    for (; len < text.length (); len++) {
+        const char ch = text[len];
+        const int id = ID (ch);
+
+        if (id == -1)
+            break;
+
+        if (G_UNLIKELY (m_text.empty () &&
+            ID_TO_SHENG (id) == PINYIN_ID_VOID))
+            break;
+
+        /* is full */
+        if (G_UNLIKELY (m_text.length () >= MAX_PINYIN_LEN)) {
+            len = text.length ();
+            break;
+        }
+
+        m_text.insert (m_cursor++, ch);
+
+        if ((m_cursor > m_pinyin_len + 2 || updatePinyin (false) == false) &&
+            !IS_ALPHA (ch)) {
+            m_text.erase (--m_cursor, 1);
+            break;
+        }
+    }
+
+    if (m_cursor != cursor) {
+        updateInputText ();
+        updateCursor ();
+        updateSpecialPhrases ();
+        updatePhraseEditor ();
+        update ();
+    }
+
+    return len == text.length ();
+}
+
 bool
 DoublePinyinContext::removeCharBefore (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -135,6 +186,8 @@ DoublePinyinContext::removeCharBefore (void)
 bool
 DoublePinyinContext::removeCharAfter (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -154,6 +207,8 @@ DoublePinyinContext::removeCharAfter (void)
 bool
 DoublePinyinContext::removeWordBefore (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -188,6 +243,8 @@ DoublePinyinContext::removeWordBefore (void)
 bool
 DoublePinyinContext::removeWordAfter (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -204,9 +261,51 @@ DoublePinyinContext::removeWordAfter (void)
     return true;
 }
 
+bool
+DoublePinyinContext::removeRange (size_t begin, size_t end)
+{
+    ChangeBatch batch (this);
+
+    end = MIN (end, m_text.length ());
+    if (G_UNLIKELY (begin >= end))
+        return false;
+
+    m_text.erase (begin, end - begin);
+    updateInputText ();
+
+    /* text after the cursor is not parsed */
+    if (begin >= m_cursor) {
+        if (updateSpecialPhrases ()) {
+            update ();
+        }
+        else {
+            updatePreeditText ();
+            updateAuxiliaryText ();
+        }
+        return true;
+    }
+
+    m_cursor = m_cursor >= end ? m_cursor - (end - begin) : begin;
+    updateCursor ();
+
+    /* parses again from the first removed character */
+    while (m_pinyin_len > begin) {
+        m_pinyin_len = m_pinyin.back ().begin;
+        m_pinyin.pop_back ();
+    }
+    updatePinyin (false);
+    updateSpecialPhrases ();
+    updatePhraseEditor ();
+    update ();
+
+    return true;
+}
+
 bool
 DoublePinyinContext::moveCursorLeft (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -245,6 +344,8 @@ DoublePinyinContext::moveCursorLeft (void)
 bool
 DoublePinyinContext::moveCursorRight (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -270,6 +371,8 @@ DoublePinyinContext::moveCursorRight (void)
 bool
 DoublePinyinContext::moveCursorLeftByWord (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -299,12 +402,16 @@ DoublePinyinContext::moveCursorLeftByWord (void)
 bool
 DoublePinyinContext::moveCursorRightByWord (void)
 {
+    ChangeBatch batch (this);
+
     return moveCursorToEnd ();
 }
 
 bool
 DoublePinyinContext::moveCursorToBegin (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -322,6 +429,8 @@ DoublePinyinContext::moveCursorToBegin (void)
 bool
 DoublePinyinContext::moveCursorToEnd (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -501,6 +610,8 @@ DoublePinyinContext::getProperty (PropertyName name) const
 bool
 DoublePinyinContext::setProperty (PropertyName name, const Variant &variant)
 {
+    ChangeBatch batch (this);
+
     if (name == PROPERTY_DOUBLE_PINYIN_SCHEMA) {
         if (variant.getType () != Variant::TYPE_UNSIGNED_INT) {
             return false;
@@ -33,11 +33,13 @@ public:
     virtual ~DoublePinyinContext ();
 
     virtual bool insert (char ch);
+    virtual bool insert (const std::string & text);
 
     virtual bool removeCharBefore (void);
     virtual bool removeCharAfter (void);
     virtual bool removeWordBefore (void);
     virtual bool removeWordAfter (void);
+    virtual bool removeRange (size_t begin, size_t end);
 
     virtual bool moveCursorLeft (void);
     virtual bool moveCursorRight (void);
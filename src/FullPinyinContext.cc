@@ -41,6 +41,8 @@ FullPinyinContext::~FullPinyinContext (void)
 bool
 FullPinyinContext::insert (char ch)
 {
+    ChangeBatch batch (this);
+
     if (!islower(ch) && ch != '\'') {
         /* it is not available ch */
         return false;
@@ -74,9 +76,35 @@ FullPinyinContext::insert (char ch)
     return true;
 }
 
+bool
+FullPinyinContext::insert (const std::string & text)
+{
+    ChangeBatch batch (this);
+
+    size_t len = 0;
+    while (len < text.length () && (islower (text[len]) || text[len] == '\''))
+        len++;
+
+    /* characters over MAX_PINYIN_LEN are dropped as insert (char) does */
+    const size_t n = MIN (len, MAX_PINYIN_LEN -
+                               MIN (m_text.length (), MAX_PINYIN_LEN));
+    if (n > 0) {
+        m_text.insert (m_cursor, text, n);
+        m_cursor += n;
+        updateInputText ();
+        updateCursor ();
+        updateSpecialPhrases ();
+        updatePinyin ();
+    }
+
+    return len == text.length ();
+}
+
 bool
 FullPinyinContext::removeCharBefore (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -93,6 +121,8 @@ FullPinyinContext::removeCharBefore (void)
 bool
 FullPinyinContext::removeCharAfter (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -107,6 +137,8 @@ FullPinyinContext::removeCharAfter (void)
 bool
 FullPinyinContext::removeWordBefore (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -135,6 +167,8 @@ FullPinyinContext::removeWordBefore (void)
 bool
 FullPinyinContext::removeWordAfter (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -145,9 +179,38 @@ FullPinyinContext::removeWordAfter (void)
     return true;
 }
 
+bool
+FullPinyinContext::removeRange (size_t begin, size_t end)
+{
+    ChangeBatch batch (this);
+
+    end = MIN (end, m_text.length ());
+    if (G_UNLIKELY (begin >= end))
+        return false;
+
+    m_text.erase (begin, end - begin);
+    updateInputText ();
+
+    /* text after the cursor is not parsed */
+    if (begin >= m_cursor) {
+        updatePreeditText ();
+        updateAuxiliaryText ();
+        return true;
+    }
+
+    m_cursor = m_cursor >= end ? m_cursor - (end - begin) : begin;
+    updateCursor ();
+    updateSpecialPhrases ();
+    updatePinyin ();
+
+    return true;
+}
+
 bool
 FullPinyinContext::moveCursorLeft (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -162,6 +225,8 @@ FullPinyinContext::moveCursorLeft (void)
 bool
 FullPinyinContext::moveCursorRight (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -176,6 +241,8 @@ FullPinyinContext::moveCursorRight (void)
 bool
 FullPinyinContext::moveCursorLeftByWord (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -199,12 +266,16 @@ FullPinyinContext::moveCursorLeftByWord (void)
 bool
 FullPinyinContext::moveCursorRightByWord (void)
 {
+    ChangeBatch batch (this);
+
     return moveCursorToEnd ();
 }
 
 bool
 FullPinyinContext::moveCursorToBegin (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == 0))
         return false;
 
@@ -222,6 +293,8 @@ FullPinyinContext::moveCursorToBegin (void)
 bool
 FullPinyinContext::moveCursorToEnd (void)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_cursor == m_text.length ()))
         return false;
 
@@ -241,13 +314,16 @@ FullPinyinContext::updatePinyin (void)
         m_pinyin_len = 0;
     }
     else {
+        size_t edit = unchangedTextLength ();
         m_pinyin_len = PinyinParser::parse (
             m_text,              // text
             m_cursor,            // text length
             m_config.option,     // option
             m_pinyin,            // result
-            MAX_PHRASE_LEN);     // max result length
+            MAX_PHRASE_LEN,      // max result length
+            edit);               // first changed char
     }
+    setParsedText ();
 
     updatePhraseEditor ();
     update ();
@@ -34,11 +34,13 @@ public:
 
 public:
     virtual bool insert (char ch);
+    virtual bool insert (const std::string & text);
 
     virtual bool removeCharBefore (void);
     virtual bool removeCharAfter (void);
     virtual bool removeWordBefore (void);
     virtual bool removeWordAfter (void);
+    virtual bool removeRange (size_t begin, size_t end);
 
     virtual bool moveCursorLeft (void);
     virtual bool moveCursorRight (void);
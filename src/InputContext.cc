@@ -46,6 +46,14 @@ InputContext::init ()
 void
 InputContext::init (const std::string & user_cache_dir,
                     const std::string & user_config_dir)
+{
+    init (user_cache_dir, user_config_dir, false);
+}
+
+void
+InputContext::init (const std::string & user_cache_dir,
+                    const std::string & user_config_dir,
+                    bool lazy_user_dictionary)
 {
     if (user_cache_dir.empty ()) {
         g_error ("Error: user_cache_dir should not be empty");
@@ -54,16 +62,100 @@ InputContext::init (const std::string & user_cache_dir,
         g_error ("Error: user_config_dir should not be empty");
     }
 
-    Database::init (user_cache_dir);
+    Database::init (user_cache_dir, lazy_user_dictionary);
     SpecialPhraseTable::init (user_config_dir);
 }
 
+void
+InputContext::warmUp (size_t max_bytes, unsigned int max_msec)
+{
+    Database::instance ().warmUp (max_bytes, max_msec);
+}
+
 void
 InputContext::finalize ()
 {
     Database::finalize ();
 }
 
+/* the contexts of pyzy convert the text once, these are for the others */
+bool
+InputContext::insert (const std::string & text)
+{
+    for (size_t i = 0; i < text.length (); i++) {
+        if (!insert (text[i]))
+            return false;
+    }
+    return true;
+}
+
+bool
+InputContext::removeRange (size_t begin, size_t end)
+{
+    end = MIN (end, inputText ().length ());
+    if (G_UNLIKELY (begin >= end))
+        return false;
+
+    const size_t cursor = this->cursor ();
+    while (this->cursor () < end && moveCursorRight ());
+    while (this->cursor () > end && moveCursorLeft ());
+    for (size_t i = begin; i < end; i++)
+        removeCharBefore ();
+
+    const size_t target = cursor >= end ? cursor - (end - begin) : MIN (cursor, begin);
+    while (this->cursor () < target && moveCursorRight ());
+    while (this->cursor () > target && moveCursorLeft ());
+    return true;
+}
+
+void
+InputContext::setQueryCacheSize (size_t size)
+{
+    Database::instance ().setQueryCacheSize (size);
+}
+
+unsigned int
+InputContext::queryCacheHits ()
+{
+    return Database::instance ().queryCacheHits ();
+}
+
+unsigned int
+InputContext::queryCacheMisses ()
+{
+    return Database::instance ().queryCacheMisses ();
+}
+
+unsigned int
+InputContext::stmtCacheHits ()
+{
+    return Database::instance ().stmtCacheHits ();
+}
+
+unsigned int
+InputContext::stmtCacheMisses ()
+{
+    return Database::instance ().stmtCacheMisses ();
+}
+
+unsigned int
+InputContext::phraseFilterSkips ()
+{
+    return Database::instance ().filterSkips ();
+}
+
+size_t
+InputContext::phraseFilterMemory ()
+{
+    return Database::instance ().filterMemory ();
+}
+
+double
+InputContext::phraseFilterFalsePositiveRate ()
+{
+    return Database::instance ().filterFalsePositiveRate ();
+}
+
 InputContext *
 InputContext::create (InputContext::InputType type,
                       InputContext::Observer * observer) {
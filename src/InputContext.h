@@ -30,6 +30,14 @@
  *
  * To use this class, you should call InputContext::init() at first and
  * InputContext::finalize() at last.
+ *
+ * Contexts may be used by several threads at the same time, one context
+ * by one thread at a time. Every thread looks up phrases by its own
+ * connection, and a phrase learned by one thread is seen by the others.
+ *
+ * The dictionaries are shared by all contexts. An idle context, after a
+ * commit or reset(), keeps no buffers; they are pooled for the contexts
+ * being typed in, so a process may serve many sessions.
  */
 #ifndef __PYZY_INPUT_CONTEXT_H_
 #define __PYZY_INPUT_CONTEXT_H_
@@ -78,6 +86,17 @@ public:
      */
     virtual ~InputContext (void) { }
 
+    /**
+     * \brief Flags of the changes notified by Observer::stateChanged ().
+     */
+    enum StateChange {
+        INPUT_TEXT_CHANGED      = 1 << 0,
+        CURSOR_CHANGED          = 1 << 1,
+        PREEDIT_TEXT_CHANGED    = 1 << 2,
+        AUXILIARY_TEXT_CHANGED  = 1 << 3,
+        CANDIDATES_CHANGED      = 1 << 4,
+    };
+
     /**
      * \brief Observer class of the InputContext.
      *
@@ -144,6 +163,21 @@ public:
          * changed.
          */
         virtual void candidatesChanged (InputContext * context) = 0;
+
+        /**
+         * \brief Notifies all changes of an operation at once.
+         * @param context InputContext instance which triggered this method.
+         * @param changes Bitwise OR of StateChange flags.
+         *
+         * This method is triggered instead of the other *Changed () methods
+         * when PROPERTY_BATCH_CHANGES is true, once at the end of every
+         * operation which changed something. The preedit and auxiliary
+         * texts are computed once per operation, and are not notified if
+         * they are the same as the last notified ones. commitText () is
+         * still triggered during the operation.
+         */
+        virtual void stateChanged (InputContext * context,
+                                   unsigned int changes) { }
     };
 
     /**
@@ -206,6 +240,12 @@ public:
          * Default value is true.
          */
         PROPERTY_MODE_SIMP,
+        /**
+         * \brief Notifies changes by one Observer::stateChanged () per
+         * operation.
+         * Default value is false.
+         */
+        PROPERTY_BATCH_CHANGES,
     };
 
     /**
@@ -399,6 +439,36 @@ public:
     static void init (const std::string & user_cache_dir,
                       const std::string & user_config_dir);
 
+    /**
+     * \brief Initializes a InputContext class.
+     * @param user_cache_dir Directory which stores a user cache data.
+     * @param user_config_dir Directory which stores a user config data.
+     * @param lazy_user_dictionary Loads the user dictionary in background.
+     *
+     * Same as init (user_cache_dir, user_config_dir), but if
+     * lazy_user_dictionary is true, it returns without reading the user
+     * dictionary. Conversion uses the system dictionary only until the user
+     * dictionary is loaded by a background thread, then the user phrases
+     * are merged, including phrases learned in the meantime.
+     */
+    static void init (const std::string & user_cache_dir,
+                      const std::string & user_config_dir,
+                      bool lazy_user_dictionary);
+
+    /**
+     * \brief Warms up the system dictionary in background.
+     * @param max_bytes Max number of bytes to read. 0 means no limit.
+     *        The operating system may read ahead more.
+     * @param max_msec Max time to spend in milliseconds. 0 means no limit.
+     *
+     * The first conversions after init () are slow if the system
+     * dictionary is not in the page cache of the operating system yet.
+     * This reads it by a background thread, most used parts first, while
+     * the user does not type. It stops at the first conversion.
+     * You should call it after init ().
+     */
+    static void warmUp (size_t max_bytes, unsigned int max_msec);
+
     /**
      * \brief Finalizes a InputContext class.
      *
@@ -406,6 +476,64 @@ public:
      */
     static void finalize ();
 
+    /**
+     * \brief Sets the size of the query cache.
+     * @param size Max number of cached phrase lists. 0 disables the cache.
+     *
+     * Phrase lists of pinyin spans are kept across key strokes, so editing
+     * the input does not query the dictionaries again. The cache is flushed
+     * when the user dictionary is modified. Every thread has its own cache.
+     * Default value is 256. You should call it after init ().
+     */
+    static void setQueryCacheSize (size_t size);
+
+    /**
+     * \brief Returns the number of lookups served by the query cache.
+     * @return number of cache hits.
+     */
+    static unsigned int queryCacheHits ();
+
+    /**
+     * \brief Returns the number of lookups which queried the dictionaries.
+     * @return number of cache misses.
+     */
+    static unsigned int queryCacheMisses ();
+
+    /**
+     * \brief Returns the number of queries which reused a prepared
+     * statement of the dictionaries.
+     * @return number of statement cache hits.
+     */
+    static unsigned int stmtCacheHits ();
+
+    /**
+     * \brief Returns the number of queries which prepared a statement.
+     * @return number of statement cache misses.
+     */
+    static unsigned int stmtCacheMisses ();
+
+    /**
+     * \brief Returns the number of phrase lengths left out by the filter.
+     * @return number of lengths which were not looked up.
+     *
+     * Spans of three or more syllables are tested against a bloom filter
+     * of the phrases in the dictionaries, and the lengths without phrases
+     * are not looked up.
+     */
+    static unsigned int phraseFilterSkips ();
+
+    /**
+     * \brief Returns the memory used by the phrase filter.
+     * @return size of the filter in bytes.
+     */
+    static size_t phraseFilterMemory ();
+
+    /**
+     * \brief Returns the estimated false positive rate of the phrase filter.
+     * @return probability that a span without phrases is looked up.
+     */
+    static double phraseFilterFalsePositiveRate ();
+
     /**
      * \brief Creates a new InputContext instance.
      * @param type The type of the input.
@@ -474,6 +602,31 @@ public:
      * @return true if the value is set successfully.
      */
     virtual bool setProperty (PropertyName name, const Variant &variant)= 0;
+
+    /* the methods below are added after the others, so the slots of the
+     * virtual table of older versions are kept */
+
+    /**
+     * \brief Inserts a text on cursor position.
+     * @param text Input text. It should be ASCII characters.
+     * @return true if all characters are inserted.
+     *
+     * Inserts the characters in order, and stops at the first character
+     * which insert (char) would refuse. The text is parsed and converted
+     * once, so pasting a text is faster than inserting it by characters.
+     */
+    virtual bool insert (const std::string & text);
+
+    /**
+     * \brief Removes input characters in a range.
+     * @param begin Index of the first character to remove.
+     * @param end Index after the last character to remove.
+     * @return true if any character is removed.
+     *
+     * The cursor stays on the same character, or moves to begin if the
+     * character is removed. The text is parsed and converted once.
+     */
+    virtual bool removeRange (size_t begin, size_t end);
 };
 
 }; // namespace PyZy
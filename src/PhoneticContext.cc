@@ -29,7 +29,13 @@ namespace PyZy {
 
 PhoneticContext::PhoneticContext (PhoneticContext::Observer *observer)
     : m_phrase_editor (m_config),
-      m_observer (observer)
+      m_observer (observer),
+      m_batch_changes (false),
+      m_flushing (false),
+      m_batch_depth (0),
+      m_changes (0),
+      m_deferred (0),
+      m_notified (0)
 {
     resetContext ();
 }
@@ -65,6 +71,8 @@ PhoneticContext::updateSpecialPhrases (void)
 void
 PhoneticContext::reset (void)
 {
+    ChangeBatch batch (this);
+
     resetContext ();
     update ();
     updateInputText ();
@@ -76,55 +84,132 @@ PhoneticContext::commitText (const std::string & commit_text)
     m_observer->commitText (this, commit_text);
 }
 
+void
+PhoneticContext::notifyChange (unsigned int change)
+{
+    if (G_LIKELY (!m_batch_changes)) {
+        switch (change) {
+        case INPUT_TEXT_CHANGED:
+            m_observer->inputTextChanged (this);
+            break;
+        case CURSOR_CHANGED:
+            m_observer->cursorChanged (this);
+            break;
+        case PREEDIT_TEXT_CHANGED:
+            m_observer->preeditTextChanged (this);
+            break;
+        case AUXILIARY_TEXT_CHANGED:
+            m_observer->auxiliaryTextChanged (this);
+            break;
+        case CANDIDATES_CHANGED:
+            m_observer->candidatesChanged (this);
+            break;
+        default:
+            g_assert_not_reached ();
+        }
+        return;
+    }
+
+    m_changes |= change;
+    if (m_batch_depth == 0 && !m_flushing)
+        flushChanges ();
+}
+
+void
+PhoneticContext::flushChanges (void)
+{
+    m_flushing = true;
+    if (m_deferred & PREEDIT_TEXT_CHANGED)
+        updatePreeditText ();
+    if (m_deferred & AUXILIARY_TEXT_CHANGED)
+        updateAuxiliaryText ();
+    m_deferred = 0;
+
+    /* the front end does not repaint the same texts */
+    if (m_changes & PREEDIT_TEXT_CHANGED) {
+        if ((m_notified & PREEDIT_TEXT_CHANGED) &&
+            m_preedit_text == m_notified_preedit_text)
+            m_changes &= ~PREEDIT_TEXT_CHANGED;
+        else
+            m_notified_preedit_text = m_preedit_text;
+    }
+    if (m_changes & AUXILIARY_TEXT_CHANGED) {
+        if ((m_notified & AUXILIARY_TEXT_CHANGED) &&
+            m_auxiliary_text == m_notified_auxiliary_text)
+            m_changes &= ~AUXILIARY_TEXT_CHANGED;
+        else
+            m_notified_auxiliary_text = m_auxiliary_text;
+    }
+    m_notified |= m_changes & (PREEDIT_TEXT_CHANGED | AUXILIARY_TEXT_CHANGED);
+
+    unsigned int changes = m_changes;
+    m_changes = 0;
+    m_flushing = false;
+    if (changes != 0)
+        m_observer->stateChanged (this, changes);
+}
+
 void
 PhoneticContext::updateInputText (void)
 {
-    m_observer->inputTextChanged (this);
+    notifyChange (INPUT_TEXT_CHANGED);
 }
 
 void
 PhoneticContext::updateCursor (void)
 {
-    m_observer->cursorChanged (this);
+    notifyChange (CURSOR_CHANGED);
 }
 
 void
 PhoneticContext::updateCandidates (void)
 {
     m_focused_candidate = 0;
-    m_observer->candidatesChanged (this);
+    notifyChange (CANDIDATES_CHANGED);
 }
 
 void
 PhoneticContext::updateAuxiliaryText (void)
 {
-    m_observer->auxiliaryTextChanged (this);
+    notifyChange (AUXILIARY_TEXT_CHANGED);
 }
 
 void
 PhoneticContext::updatePreeditText (void)
 {
-    m_observer->preeditTextChanged (this);
+    notifyChange (PREEDIT_TEXT_CHANGED);
 }
 
+/* an idle context keeps no storage but m_buffer, which may hold the text
+ * being committed */
 void
 PhoneticContext::resetContext (void)
 {
     m_cursor = 0;
     m_focused_candidate = 0;
-    m_pinyin.clear ();
+    PinyinArray ().swap (m_pinyin);
     m_pinyin_len = 0;
     m_phrase_editor.reset ();
-    m_special_phrases.clear ();
-    m_selected_special_phrase.clear ();
-    m_text.clear ();
-    m_preedit_text.clear ();
-    m_auxiliary_text.clear ();
+    std::vector<std::string> ().swap (m_special_phrases);
+    std::string ().swap (m_selected_special_phrase);
+    String ().swap (m_text);
+    m_preedit_text.release ();
+    std::string ().swap (m_auxiliary_text);
+    String ().swap (m_parsed_text);
+    m_parsed_option = 0;
+    m_parsed_size = 0;
+    /* the texts notified last are dropped too, so the next texts are
+     * notified even if they are the same */
+    m_notified_preedit_text.release ();
+    std::string ().swap (m_notified_auxiliary_text);
+    m_notified = 0;
 }
 
 bool
 PhoneticContext::focusCandidatePrevious ()
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_focused_candidate == 0)) {
         return false;
     }
@@ -134,6 +219,8 @@ PhoneticContext::focusCandidatePrevious ()
 bool
 PhoneticContext::focusCandidateNext ()
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (!hasCandidate (m_focused_candidate + 1))) {
         return false;
     }
@@ -143,6 +230,8 @@ PhoneticContext::focusCandidateNext ()
 bool
 PhoneticContext::focusCandidate (size_t i)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (!hasCandidate (i))) {
         g_warning ("Too big index. Can't focus to selected candidate.");
         return false;
@@ -165,6 +254,8 @@ PhoneticContext::update ()
 bool
 PhoneticContext::selectCandidate (size_t i)
 {
+    ChangeBatch batch (this);
+
     if (!hasCandidate (i)) {
         g_warning ("selectCandidate(%zd): Too big index!\n", i);
         return false;
@@ -205,6 +296,8 @@ PhoneticContext::selectCandidate (size_t i)
 bool
 PhoneticContext::resetCandidate (size_t i)
 {
+    ChangeBatch batch (this);
+
     if (i < m_special_phrases.size ()) {
         return false;
     }
@@ -220,6 +313,8 @@ PhoneticContext::resetCandidate (size_t i)
 bool
 PhoneticContext::unselectCandidates ()
 {
+    ChangeBatch batch (this);
+
     if (!m_phrase_editor.unselectCandidates ()) {
         return false;
     }
@@ -228,6 +323,49 @@ PhoneticContext::unselectCandidates ()
     return true;
 }
 
+size_t
+PhoneticContext::convertText (const std::string & text, String & result)
+{
+    size_t syllables = 0;
+    size_t pos = 0;
+
+    result.clear ();
+    while (pos < text.length ()) {
+        resetContext ();
+        insert (text.substr (pos, MAX_PINYIN_LEN));
+
+        const PhraseArray & phrases = m_phrase_editor.candidate0 ();
+        if (phrases.empty ()) {
+            result << text[pos++];
+            continue;
+        }
+
+        /* the last phrase of a sentence cut by the limits may go on in the
+         * rest text, so it is converted again with the rest */
+        size_t n = phrases.size ();
+        if (n > 1 && pos + m_pinyin_len < text.length () &&
+            (m_pinyin.size () == MAX_PHRASE_LEN ||
+             m_text.length () == MAX_PINYIN_LEN))
+            n--;
+
+        size_t len = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (m_config.modeSimp)
+                result << phrases[i].phrase;
+            else if (phrases[i].trad () != NULL)
+                result << phrases[i].trad ();
+            else
+                SimpTradConverter::simpToTrad (phrases[i].phrase, result);
+            len += phrases[i].len;
+        }
+        syllables += len;
+        pos += m_pinyin[len - 1].begin + m_pinyin[len - 1].len;
+    }
+    resetContext ();
+
+    return syllables;
+}
+
 bool
 PhoneticContext::hasCandidate (size_t i)
 {
@@ -263,14 +401,7 @@ PhoneticContext::getCandidate (size_t i, Candidate & candidate)
     }
 
     i -= m_special_phrases.size ();
-    if (m_config.modeSimp) {
-        candidate.text = m_phrase_editor.candidate (i).phrase;
-    } else {
-        String output;
-        SimpTradConverter::simpToTrad (m_phrase_editor.candidate (i).phrase,
-                                       output);
-        candidate.text = output;
-    }
+    candidate.text = m_phrase_editor.candidateText (i);
     candidate.type = m_phrase_editor.candidateIsUserPhrase (i)
         ? USER_PHRASE : NORMAL_PHRASE;
     return true;
@@ -296,6 +427,8 @@ PhoneticContext::getProperty (PropertyName name) const
         return Variant::fromBool (m_config.specialPhrases);
     case PROPERTY_MODE_SIMP:
         return Variant::fromBool (m_config.modeSimp);
+    case PROPERTY_BATCH_CHANGES:
+        return Variant::fromBool (m_batch_changes);
     default:
         return Variant::nullVariant ();
     }
@@ -324,6 +457,9 @@ PhoneticContext::setProperty (PropertyName name, const Variant &variant)
         case PROPERTY_MODE_SIMP:
             m_config.modeSimp = value;
             return true;
+        case PROPERTY_BATCH_CHANGES:
+            m_batch_changes = value;
+            return true;
         default:
             return false;
         }
@@ -47,6 +47,18 @@ struct Preedit {
         candidate_text.clear ();
         rest_text.clear ();
     }
+
+    void release () {
+        std::string ().swap (selected_text);
+        std::string ().swap (candidate_text);
+        std::string ().swap (rest_text);
+    }
+
+    bool operator == (const Preedit & p) const {
+        return selected_text == p.selected_text &&
+               candidate_text == p.candidate_text &&
+               rest_text == p.rest_text;
+    }
 };
 
 class PhoneticContext : public InputContext {
@@ -70,6 +82,10 @@ public:
     virtual Variant getProperty (PropertyName name) const;
     virtual bool setProperty (PropertyName name, const Variant &variant);
 
+    /* converts a text by the first candidates without learning, and copies
+     * the characters which are not pinyin; returns the count of syllables */
+    size_t convertText (const std::string & text, String & result);
+
     /* Accessors of InputContext. */
     virtual const std::string & inputText () const
     {
@@ -107,6 +123,39 @@ public:
     }
 
 protected:
+    /* every operation holds a batch; in batched mode its changes are sent
+     * by one stateChanged when the outermost batch ends */
+    class ChangeBatch {
+    public:
+        explicit ChangeBatch (PhoneticContext *context) : m_context (context)
+        {
+            m_context->m_batch_depth++;
+        }
+
+        ~ChangeBatch (void)
+        {
+            if (--m_context->m_batch_depth == 0 &&
+                (m_context->m_changes | m_context->m_deferred) != 0)
+                m_context->flushChanges ();
+        }
+
+    private:
+        PhoneticContext *m_context;
+    };
+
+    /* in batched mode the preedit and auxiliary texts are computed when the
+     * operation ends, returns true if the change is deferred */
+    bool deferChange (unsigned int change)
+    {
+        if (G_LIKELY (!m_batch_changes || m_batch_depth == 0 || m_flushing))
+            return false;
+        m_deferred |= change;
+        return true;
+    }
+
+    void notifyChange (unsigned int change);
+    void flushChanges (void);
+
     virtual void resetContext (void);
     virtual void update (void);
     virtual void commitText (const std::string & commit_text);
@@ -142,6 +191,27 @@ protected:
         return (const char *)m_text + m_cursor;
     }
 
+    /* the length of the head of m_text which is not changed since m_pinyin
+     * was parsed, the pinyin parsed from it can be reused */
+    size_t unchangedTextLength () const
+    {
+        if (m_parsed_option != m_config.option ||
+            m_parsed_size != m_pinyin.size ())
+            return 0;
+        size_t i = 0;
+        size_t n = MIN (m_parsed_text.size (), m_cursor);
+        while (i < n && m_parsed_text[i] == m_text[i])
+            i++;
+        return i;
+    }
+
+    void setParsedText (void)
+    {
+        m_parsed_text.assign (m_text, 0, m_cursor);
+        m_parsed_option = m_config.option;
+        m_parsed_size = m_pinyin.size ();
+    }
+
     /* variables */
     Config                      m_config;
     size_t                      m_cursor;
@@ -155,9 +225,23 @@ protected:
     String                      m_text;
     Preedit                     m_preedit_text;
     std::string                 m_auxiliary_text;
+    String                      m_parsed_text;
+    unsigned int                m_parsed_option;
+    size_t                      m_parsed_size;
 
 private:
     PhoneticContext::Observer  *m_observer;
+
+    /* the changes of the current operation in batched mode, and the texts
+     * notified last, m_notified tells which of them are kept */
+    bool                        m_batch_changes;
+    bool                        m_flushing;
+    unsigned int                m_batch_depth;
+    unsigned int                m_changes;
+    unsigned int                m_deferred;
+    unsigned int                m_notified;
+    Preedit                     m_notified_preedit_text;
+    std::string                 m_notified_auxiliary_text;
 };
 
 }; // namespace PyZy
@@ -33,6 +33,9 @@ namespace PyZy {
 
 struct Phrase {
     char phrase[PHRASE_LEN_IN_BYTE];
+    guint8 trad_pos;    /* the traditional text of the dictionaries follows
+                           the text in phrase at trad_pos, 0 if it is not
+                           known */
     unsigned int freq;
     unsigned int user_freq;
     struct {
@@ -44,6 +47,7 @@ struct Phrase {
     void reset (void)
     {
         phrase[0] = 0;
+        trad_pos = 0;
         freq = 0;
         user_freq = 0;
         len = 0;
@@ -57,6 +61,8 @@ struct Phrase {
     Phrase & operator += (const Phrase & a)
     {
         g_assert (len + a.len <= MAX_PHRASE_LEN);
+        /* the dictionaries do not know the joined text */
+        trad_pos = 0;
         g_strlcat (phrase, a.phrase, sizeof (phrase));
         std::memcpy (pinyin_id + len, a.pinyin_id, a.len << 1);
         len += a.len;
@@ -68,6 +74,27 @@ struct Phrase {
         return phrase;
     }
 
+    /* the traditional text, NULL if it is not known */
+    const char *trad (void) const
+    {
+        return trad_pos != 0 ? phrase + trad_pos : NULL;
+    }
+
+    /* keeps the traditional text of len bytes after the text, it is left
+     * unknown if both do not fit */
+    void setTrad (const char *text, size_t len)
+    {
+        size_t pos = std::strlen (phrase) + 1;
+        if (pos + len < sizeof (phrase)) {
+            std::memcpy (phrase + pos, text, len);
+            phrase[pos + len] = 0;
+            trad_pos = pos;
+        }
+        else {
+            trad_pos = 0;
+        }
+    }
+
 };
 
 };  // namespace PyZy
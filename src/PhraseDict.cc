@@ -0,0 +1,336 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#include "PhraseDict.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace PyZy {
+
+#define DICT_MAGIC          "PYZYDICT"
+#define DICT_BYTE_ORDER     (0x01020304)
+#define DICT_VERSION        (3)
+/* the strings of older versions have no traditional texts */
+#define DICT_MIN_VERSION    (1)
+#define DICT_VERSION_TRAD   (2)
+/* the header of newer versions ends with the flags and the freq scale */
+#define DICT_VERSION_FLAGS  (3)
+#define DICT_FLAG_TRAD      (1 << 0)
+
+/* the file layout, all integers are stored in host byte order */
+struct DictTable {
+    guint32 record_num;
+    guint32 record_size;
+    guint32 records_offset;     /* records grouped by (s0, s1) */
+    guint32 index_offset;       /* sheng_num * sheng_num + 1 record indexes */
+};
+
+struct DictHeader {
+    char magic[8];
+    guint32 byte_order;
+    guint32 version;
+    guint32 sheng_num;
+    guint32 strings_offset;     /* nul terminated phrases, every phrase is
+                                   followed by its traditional text, which
+                                   is empty if it is the same */
+    guint32 strings_size;
+    DictTable tables[MAX_PHRASE_LEN];
+    guint32 flags;              /* since DICT_VERSION_FLAGS */
+    guint32 freq_per_e;         /* 0 if the scale of freq is not known */
+    gint32 freq_zero;
+};
+
+/* a record is followed by 2 * len pinyin ids and padded to 4 bytes */
+struct DictRecord {
+    guint32 phrase;             /* offset in the strings */
+    guint32 freq;
+};
+
+PhraseDict::PhraseDict (void)
+    : m_file (NULL),
+      m_data (NULL),
+      m_size (0),
+      m_header (NULL),
+      m_trad (false),
+      m_freq_per_e (0),
+      m_freq_zero (0)
+{
+}
+
+PhraseDict::~PhraseDict (void)
+{
+    close ();
+}
+
+void
+PhraseDict::close (void)
+{
+    if (m_file != NULL)
+        g_mapped_file_unref (m_file);
+    m_file = NULL;
+    m_data = NULL;
+    m_size = 0;
+    m_header = NULL;
+    m_trad = false;
+    m_freq_per_e = 0;
+    m_freq_zero = 0;
+}
+
+bool
+PhraseDict::open (const char *filename)
+{
+    close ();
+
+    GError *error = NULL;
+    m_file = g_mapped_file_new (filename, FALSE, &error);
+    if (m_file == NULL) {
+        g_warning ("can not map dictionary %s: %s", filename, error->message);
+        g_error_free (error);
+        return false;
+    }
+
+    m_data = g_mapped_file_get_contents (m_file);
+    m_size = g_mapped_file_get_length (m_file);
+
+    do {
+        if (m_size < offsetof (DictHeader, flags))
+            break;
+
+        const DictHeader *header = (const DictHeader *) m_data;
+        if (std::memcmp (header->magic, DICT_MAGIC, sizeof (header->magic)) != 0 ||
+            header->byte_order != DICT_BYTE_ORDER ||
+            header->version < DICT_MIN_VERSION ||
+            header->version > DICT_VERSION ||
+            header->sheng_num == 0 || header->sheng_num > PINYIN_ID_A)
+            break;
+        if (header->version >= DICT_VERSION_FLAGS && m_size < sizeof (DictHeader))
+            break;
+
+        if (header->strings_size == 0 ||
+            header->strings_offset > m_size ||
+            header->strings_size > m_size - header->strings_offset ||
+            m_data[header->strings_offset + header->strings_size - 1] != '\0')
+            break;
+
+        gsize index_size = (header->sheng_num * header->sheng_num + 1) * sizeof (guint32);
+        size_t i;
+        for (i = 0; i < MAX_PHRASE_LEN; i++) {
+            const DictTable &table = header->tables[i];
+            if (table.record_size < sizeof (DictRecord) + 2 * (i + 1) ||
+                table.record_size % sizeof (guint32) != 0 ||
+                table.index_offset % sizeof (guint32) != 0 ||
+                table.records_offset % sizeof (guint32) != 0 ||
+                table.index_offset > m_size ||
+                index_size > m_size - table.index_offset ||
+                table.records_offset > m_size ||
+                (guint64) table.record_num * table.record_size > m_size - table.records_offset)
+                break;
+
+            /* the groups are ranges of the records, in order */
+            const guint32 *index = (const guint32 *) (m_data + table.index_offset);
+            const guint32 groups = header->sheng_num * header->sheng_num;
+            guint32 g;
+            for (g = 0; g < groups; g++) {
+                if (index[g] > index[g + 1])
+                    break;
+            }
+            if (g != groups || index[groups] != table.record_num)
+                break;
+        }
+        if (i != MAX_PHRASE_LEN)
+            break;
+
+        m_header = header;
+        if (header->version >= DICT_VERSION_FLAGS) {
+            m_trad = (header->flags & DICT_FLAG_TRAD) != 0;
+            m_freq_per_e = header->freq_per_e;
+            m_freq_zero = header->freq_zero;
+        }
+        else {
+            m_trad = header->version >= DICT_VERSION_TRAD;
+        }
+        return true;
+    } while (0);
+
+    g_warning ("%s is not a valid dictionary", filename);
+    close ();
+    return false;
+}
+
+inline const DictRecord *
+PhraseDict::record (size_t len, guint32 r) const
+{
+    const DictTable &table = m_header->tables[len - 1];
+    return (const DictRecord *) (m_data + table.records_offset + (gsize) r * table.record_size);
+}
+
+void
+PhraseDict::lookup (const PinyinIdSet *sets, size_t len, Cursor &cursor) const
+{
+    g_assert (len > 0 && len <= MAX_PHRASE_LEN);
+
+    cursor.m_dict = NULL;
+    cursor.m_len = len;
+    cursor.m_groups.clear ();
+    std::copy (sets, sets + len, cursor.m_sets);
+
+    if (G_UNLIKELY (m_header == NULL))
+        return;
+    cursor.m_dict = this;
+
+    const guint32 *index = (const guint32 *) (m_data + m_header->tables[len - 1].index_offset);
+    const guint32 sheng_num = m_header->sheng_num;
+
+    /* a single syllable phrase is grouped by (s0, 0) */
+    PinyinIdSet first = sets[0] & PINYIN_SHENG_MASK;
+    PinyinIdSet second = len > 1 ? sets[1] & PINYIN_SHENG_MASK : PINYIN_ID_BIT (0);
+
+    for (guint32 s0 = 0; s0 < sheng_num; s0++) {
+        if ((first & PINYIN_ID_BIT (s0)) == 0)
+            continue;
+
+        for (guint32 s1 = 0; s1 < sheng_num; s1++) {
+            if ((second & PINYIN_ID_BIT (s1)) == 0)
+                continue;
+
+            guint32 key = s0 * sheng_num + s1;
+            Cursor::Group group = { index[key], index[key + 1] };
+            cursor.seek (group);
+            if (group.pos != group.end)
+                cursor.m_groups.push_back (group);
+        }
+    }
+}
+
+guint32
+PhraseDict::size (size_t len) const
+{
+    g_assert (len > 0 && len <= MAX_PHRASE_LEN);
+    return m_header != NULL ? m_header->tables[len - 1].record_num : 0;
+}
+
+const guint8 *
+PhraseDict::ids (size_t len, guint32 r) const
+{
+    g_assert (r < size (len));
+    return (const guint8 *) (record (len, r) + 1);
+}
+
+void
+PhraseDict::ranges (std::vector<Range> &ranges) const
+{
+    ranges.clear ();
+    if (m_header == NULL)
+        return;
+
+    /* every lookup reads the indexes, most of them are of short phrases,
+     * and every phrase found reads the strings */
+    const gsize index_size = (m_header->sheng_num * m_header->sheng_num + 1) * sizeof (guint32);
+    ranges.push_back (Range (m_data, sizeof (DictHeader)));
+    for (size_t i = 0; i < MAX_PHRASE_LEN; i++)
+        ranges.push_back (Range (m_data + m_header->tables[i].index_offset, index_size));
+
+    for (size_t i = 0; i < MAX_PHRASE_LEN; i++) {
+        const DictTable &table = m_header->tables[i];
+        ranges.push_back (Range (m_data + table.records_offset,
+                                 (gsize) table.record_num * table.record_size));
+        if (i == 1)
+            ranges.push_back (Range (m_data + m_header->strings_offset,
+                                     m_header->strings_size));
+    }
+}
+
+inline bool
+PhraseDict::Cursor::match (const DictRecord *record) const
+{
+    const guint8 *id = (const guint8 *) (record + 1);
+
+    for (size_t k = 0; k < m_len; k++) {
+        /* ids are not validated on open, keep the shift defined */
+        PinyinIdSet ids = PINYIN_ID_BIT (id[k << 1] & 63) |
+                          PINYIN_ID_BIT (id[(k << 1) + 1] & 63);
+        if ((m_sets[k] & ids) != ids)
+            return false;
+    }
+
+    return G_LIKELY (record->phrase < m_dict->m_header->strings_size);
+}
+
+inline void
+PhraseDict::Cursor::seek (Group &group)
+{
+    /* move to the next matching record of the group */
+    while (group.pos < group.end && !match (m_dict->record (m_len, group.pos)))
+        group.pos ++;
+}
+
+bool
+PhraseDict::Cursor::next (Phrase &phrase)
+{
+    if (G_UNLIKELY (m_dict == NULL))
+        return false;
+
+    /* every group is sorted by freq, merge the heads of them */
+    Group *best = NULL;
+    guint32 best_freq = 0;
+    for (size_t i = 0; i < m_groups.size (); i++) {
+        Group &group = m_groups[i];
+        if (group.pos == group.end)
+            continue;
+        guint32 freq = m_dict->record (m_len, group.pos)->freq;
+        if (best == NULL || freq > best_freq) {
+            best = &group;
+            best_freq = freq;
+        }
+    }
+
+    if (best == NULL)
+        return false;
+
+    const DictRecord *record = m_dict->record (m_len, best->pos);
+    const char *strings = m_dict->m_data + m_dict->m_header->strings_offset;
+
+    const gsize n = g_strlcpy (phrase.phrase, strings + record->phrase,
+                               sizeof (phrase.phrase));
+    /* the strings end with a nul, so the text after a phrase is in them
+     * unless the phrase is the last */
+    phrase.trad_pos = 0;
+    if (m_dict->m_trad &&
+        record->phrase + n + 1 < m_dict->m_header->strings_size) {
+        const char *trad = strings + record->phrase + n + 1;
+        if (trad[0] != 0)
+            phrase.setTrad (trad, std::strlen (trad));
+        else
+            phrase.setTrad (phrase.phrase, n);
+    }
+    phrase.freq = record->freq;
+    phrase.user_freq = 0;
+    phrase.len = m_len;
+    std::memcpy (phrase.pinyin_id, record + 1, m_len << 1);
+
+    best->pos ++;
+    seek (*best);
+    return true;
+}
+
+};  // namespace PyZy
@@ -0,0 +1,110 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#ifndef __PYZY_PHRASE_DICT_H_
+#define __PYZY_PHRASE_DICT_H_
+
+#include <glib.h>
+#include <utility>
+#include <vector>
+
+#include "PhraseArray.h"
+#include "Types.h"
+
+namespace PyZy {
+
+struct DictHeader;
+struct DictRecord;
+
+/*
+ * PhraseDict is a read-only, memory mapped phrase dictionary compiled from
+ * the py_phrase_* tables of a main database by data/db/create_dict.py.
+ * Records of every phrase length are grouped by their first two shengs and
+ * sorted by freq, so a lookup only scans the groups the syllables allow.
+ * The phrases have the traditional texts of the trad columns when the
+ * database has them.
+ */
+class PhraseDict {
+public:
+    /* walks the phrases of a lookup in freq order */
+    class Cursor {
+    public:
+        Cursor (void) : m_dict (NULL), m_len (0) { }
+        bool next (Phrase &phrase);
+
+    private:
+        struct Group {
+            guint32 pos;
+            guint32 end;
+        };
+
+        bool match (const DictRecord *record) const;
+        void seek (Group &group);
+
+    private:
+        friend class PhraseDict;
+        const PhraseDict *m_dict;
+        size_t m_len;
+        PinyinIdSet m_sets[MAX_PHRASE_LEN];
+        std::vector<Group> m_groups;
+    };
+
+public:
+    PhraseDict (void);
+    ~PhraseDict (void);
+
+    bool open (const char *filename);
+    void close (void);
+    bool isOpen (void) const { return m_header != NULL; }
+
+    /* starts a walk over phrases of len syllables whose ids are in the
+     * id sets of the syllables */
+    void lookup (const PinyinIdSet *sets, size_t len, Cursor &cursor) const;
+
+    /* the number of phrases of len syllables, and the 2 * len sheng and
+     * yun ids of the r-th of them */
+    guint32 size (size_t len) const;
+    const guint8 *ids (size_t len, guint32 r) const;
+
+    /* byte ranges of the file in the order lookups read them */
+    typedef std::pair<const char *, gsize> Range;
+    void ranges (std::vector<Range> &ranges) const;
+
+    /* the scale of freq told by the main database, see Database::freqPerE */
+    guint32 freqPerE (void) const { return m_freq_per_e; }
+    gint32 freqZero (void) const { return m_freq_zero; }
+
+private:
+    const DictRecord *record (size_t len, guint32 r) const;
+
+private:
+    GMappedFile *m_file;
+    const char *m_data;
+    gsize m_size;
+    const DictHeader *m_header;
+    bool m_trad;                /* the strings have traditional texts */
+    guint32 m_freq_per_e;
+    gint32 m_freq_zero;
+};
+
+};  // namespace PyZy
+
+#endif  // __PYZY_PHRASE_DICT_H_
@@ -23,17 +23,13 @@
 
 #include "Config.h"
 #include "Database.h"
+#include "PhrasePool.h"
 #include "SimpTradConverter.h"
 
 namespace PyZy {
 
 PhraseEditor::PhraseEditor (const Config & config)
     : m_config(config),
-      m_candidates (32),
-      m_selected_phrases (8),
-      m_selected_string (32),
-      m_candidate_0_phrases (8),
-      m_pinyin (16),
       m_cursor (0)
 {
 }
@@ -42,12 +38,32 @@ PhraseEditor::~PhraseEditor (void)
 {
 }
 
+void
+PhraseEditor::reset (void)
+{
+    /* an idle editor keeps no storage */
+    PhrasePool::release (m_candidates);
+    PhrasePool::release (m_selected_phrases);
+    PhrasePool::release (m_candidate_0_phrases);
+    std::vector<std::string> ().swap (m_candidates_trad);
+    String ().swap (m_selected_string);
+    PinyinArray ().swap (m_pinyin);
+    m_cursor = 0;
+    m_query.reset ();
+    m_lattice.release ();
+}
+
 bool
 PhraseEditor::update (const PinyinArray &pinyin)
 {
     /* the size of pinyin must not bigger than MAX_PHRASE_LEN */
     g_assert (pinyin.size () <= MAX_PHRASE_LEN);
 
+    /* the arrays of an idle editor are in the pool */
+    PhrasePool::acquire (m_candidates);
+    PhrasePool::acquire (m_selected_phrases);
+    PhrasePool::acquire (m_candidate_0_phrases);
+
     m_pinyin = pinyin;
     m_cursor = 0;
 
@@ -84,18 +100,12 @@ PhraseEditor::selectCandidate (size_t i)
         m_selected_phrases.insert (m_selected_phrases.end (),
                                    m_candidate_0_phrases.begin (),
                                    m_candidate_0_phrases.end ());
-        if (G_LIKELY (m_config.modeSimp))
-            m_selected_string << m_candidates[0].phrase;
-        else
-            SimpTradConverter::simpToTrad (m_candidates[0].phrase, m_selected_string);
+        m_selected_string << candidateText (0);
         m_cursor = m_pinyin.size ();
     }
     else {
         m_selected_phrases.push_back (m_candidates[i]);
-        if (G_LIKELY (m_config.modeSimp))
-            m_selected_string << m_candidates[i].phrase;
-        else
-            SimpTradConverter::simpToTrad (m_candidates[i].phrase, m_selected_string);
+        m_selected_string << candidateText (i);
         m_cursor += m_candidates[i].len;
     }
 
@@ -103,10 +113,46 @@ PhraseEditor::selectCandidate (size_t i)
     return true;
 }
 
+const char *
+PhraseEditor::candidateText (size_t i)
+{
+    if (G_LIKELY (m_config.modeSimp))
+        return m_candidates[i].phrase;
+
+    /* the dictionaries keep the traditional texts of their phrases */
+    if (m_candidates[i].trad () != NULL)
+        return m_candidates[i].trad ();
+
+    if (m_candidates_trad.size () < m_candidates.size ())
+        m_candidates_trad.resize (m_candidates.size ());
+    std::string &trad = m_candidates_trad[i];
+    if (!trad.empty ())
+        return trad.c_str ();
+
+    if (i == 0 && m_candidate_0_phrases.size () > 1) {
+        /* the first candidate joins the texts of its phrases */
+        for (size_t j = 0; j < m_candidate_0_phrases.size (); j++) {
+            const Phrase &phrase = m_candidate_0_phrases[j];
+            if (phrase.trad () != NULL) {
+                trad += phrase.trad ();
+                continue;
+            }
+            std::string text;
+            SimpTradConverter::phraseToTrad (phrase.phrase, text);
+            trad += text;
+        }
+    }
+    else {
+        SimpTradConverter::phraseToTrad (m_candidates[i].phrase, trad);
+    }
+    return trad.c_str ();
+}
+
 void
 PhraseEditor::updateCandidates (void)
 {
     m_candidates.clear ();
+    m_candidates_trad.clear ();
     m_query.reset ();
     updateTheFirstCandidate ();
 
@@ -131,27 +177,13 @@ PhraseEditor::updateCandidates (void)
 void
 PhraseEditor::updateTheFirstCandidate (void)
 {
-    size_t begin;
-    size_t end;
-
     m_candidate_0_phrases.clear ();
 
     if (G_UNLIKELY (m_pinyin.size () == 0))
         return;
 
-    begin = m_cursor;
-    end = m_pinyin.size ();
-
-    while (begin != end) {
-        int ret;
-        Query query (m_pinyin,
-                     begin,
-                     end - begin,
-                     m_config.option);
-        ret = query.fill (m_candidate_0_phrases, 1);
-        g_assert (ret == 1);
-        begin += m_candidate_0_phrases.back ().len;
-    }
+    m_lattice.update (m_pinyin, m_config.option);
+    m_lattice.bestPath (m_cursor, m_candidate_0_phrases);
 }
 
 bool
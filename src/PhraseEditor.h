@@ -23,6 +23,7 @@
 #define __PYZY_PHRASE_EDITOR_H_
 
 #include "PhraseArray.h"
+#include "PhraseLattice.h"
 #include "PinyinArray.h"
 #include "String.h"
 #include "Util.h"
@@ -60,6 +61,11 @@ public:
         return m_candidates[i];
     }
 
+    /* the text of a candidate in the mode of the config; a traditional
+     * text not in the dictionaries is converted when it is first asked,
+     * and kept with the candidate */
+    const char * candidateText (size_t i);
+
     bool fillCandidates (void);
 
     const PhraseArray & candidate0 (void) const
@@ -87,16 +93,8 @@ public:
         }
     }
 
-    void reset (void)
-    {
-        m_candidates.clear ();
-        m_selected_phrases.clear ();
-        m_selected_string.truncate (0);
-        m_candidate_0_phrases.clear ();
-        m_pinyin.clear ();
-        m_cursor = 0;
-        m_query.reset ();
-    }
+    /* returns the storage of the arrays to the pool */
+    void reset (void);
 
     bool update (const PinyinArray &pinyin);
     bool selectCandidate (size_t i);
@@ -126,6 +124,10 @@ private:
     PinyinArray m_pinyin;
     size_t m_cursor;
     std::shared_ptr<Query> m_query;
+    PhraseLattice m_lattice;            // edges of the first candidate
+
+    /* traditional texts converted for the candidates which are asked */
+    std::vector<std::string> m_candidates_trad;
 };
 
 };  // namespace PyZy
@@ -0,0 +1,237 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#include "PhraseFilter.h"
+
+namespace PyZy {
+
+/* about 1% false positives for the keys of a full filter */
+#define FILTER_BITS_PER_KEY     (10)
+#define FILTER_HASHES           (7)
+/* a span matching more sequences is not tested, it may have phrases */
+#define FILTER_MAX_PROBES       (64)
+#define FILTER_MAX_TOKENS       (8)
+
+#define FILTER_SEED_FULL        (0xcbf29ce484222325ULL)
+#define FILTER_SEED_SHENG       (0x84222325cbf29ce4ULL)
+
+inline static guint64
+hash_step (guint64 hash, guint token)
+{
+    return (hash ^ token) * 0x100000001b3ULL;
+}
+
+inline static guint64
+hash_finish (guint64 hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/* writes the ids in set & mask to ids, returns the number of them, or
+ * max + 1 if there are more than max */
+inline static size_t
+id_set_get (PinyinIdSet set, PinyinIdSet mask, guint *ids, size_t max)
+{
+    size_t n = 0;
+    set &= mask;
+    for (guint id = 0; set != 0; id++, set >>= 1) {
+        if ((set & 1) == 0)
+            continue;
+        if (n == max)
+            return max + 1;
+        ids[n++] = id;
+    }
+    return n;
+}
+
+PhraseFilter::PhraseFilter (void)
+{
+    clear ();
+}
+
+void
+PhraseFilter::clear (void)
+{
+    for (size_t i = 0; i < MAX_PHRASE_LEN; i++) {
+        std::vector<guint64> ().swap (m_tables[i].bits);
+        m_tables[i].capacity = 0;
+        m_tables[i].size = 0;
+    }
+}
+
+void
+PhraseFilter::build (size_t len, size_t capacity)
+{
+    g_assert (len > 0 && len <= MAX_PHRASE_LEN);
+
+    /* every phrase has two keys */
+    Table &table = m_tables[len - 1];
+    table.bits.assign ((capacity * 2 * FILTER_BITS_PER_KEY + 63) / 64 + 1, 0);
+    table.capacity = capacity;
+    table.size = 0;
+}
+
+inline bool
+PhraseFilter::test (const Table &table, guint64 hash)
+{
+    const guint64 bits = table.bits.size () * 64;
+    guint32 h1 = hash;
+    guint32 h2 = (hash >> 32) | 1;
+    for (size_t i = 0; i < FILTER_HASHES; i++, h1 += h2) {
+        guint64 bit = (h1 * bits) >> 32;
+        if ((table.bits[bit >> 6] & (1ULL << (bit & 63))) == 0)
+            return false;
+    }
+    return true;
+}
+
+inline void
+PhraseFilter::set (Table &table, guint64 hash)
+{
+    const guint64 bits = table.bits.size () * 64;
+    guint32 h1 = hash;
+    guint32 h2 = (hash >> 32) | 1;
+    for (size_t i = 0; i < FILTER_HASHES; i++, h1 += h2) {
+        guint64 bit = (h1 * bits) >> 32;
+        table.bits[bit >> 6] |= 1ULL << (bit & 63);
+    }
+}
+
+bool
+PhraseFilter::add (size_t len, const guint8 *ids)
+{
+    g_assert (len > 0 && len <= MAX_PHRASE_LEN);
+
+    Table &table = m_tables[len - 1];
+    if (table.bits.empty ())
+        return true;
+    if (G_UNLIKELY (table.size == table.capacity)) {
+        std::vector<guint64> ().swap (table.bits);
+        return false;
+    }
+
+    guint64 full = FILTER_SEED_FULL;
+    guint64 sheng = FILTER_SEED_SHENG;
+    for (size_t i = 0; i < len; i++) {
+        full = hash_step (full, (ids[i << 1] << 8) | ids[(i << 1) + 1]);
+        sheng = hash_step (sheng, ids[i << 1]);
+    }
+    set (table, hash_finish (full));
+    set (table, hash_finish (sheng));
+    table.size ++;
+    return true;
+}
+
+bool
+PhraseFilter::mayExist (const PinyinIdSet *sets, size_t len) const
+{
+    g_assert (len > 0 && len <= MAX_PHRASE_LEN);
+
+    const Table &table = m_tables[len - 1];
+    g_assert (!table.bits.empty ());
+    if (table.size == 0)
+        return false;
+
+    /* test the (sheng, yun) sequences, or the sheng sequences if a
+     * syllable matches any yun */
+    bool full = true;
+    for (size_t i = 0; i < len; i++) {
+        if ((sets[i] & PINYIN_YUN_MASK) == PINYIN_YUN_MASK)
+            full = false;
+    }
+
+    guint tokens[MAX_PHRASE_LEN][FILTER_MAX_TOKENS];
+    size_t num[MAX_PHRASE_LEN];
+    size_t probes = 1;
+    for (size_t i = 0; i < len; i++) {
+        guint shengs[FILTER_MAX_TOKENS];
+        guint yuns[FILTER_MAX_TOKENS];
+        size_t n_shengs = id_set_get (sets[i], PINYIN_SHENG_MASK, shengs, FILTER_MAX_TOKENS);
+        size_t n_yuns = full ?
+                        id_set_get (sets[i], PINYIN_YUN_MASK, yuns, FILTER_MAX_TOKENS) : 1;
+
+        num[i] = n_shengs * n_yuns;
+        probes *= num[i];
+        if (num[i] > FILTER_MAX_TOKENS || probes > FILTER_MAX_PROBES)
+            return true;
+
+        size_t n = 0;
+        for (size_t s = 0; s < n_shengs; s++) {
+            for (size_t y = 0; y < n_yuns; y++)
+                tokens[i][n++] = full ? (shengs[s] << 8) | yuns[y] : shengs[s];
+        }
+    }
+
+    /* every combination of the tokens of the syllables */
+    size_t pos[MAX_PHRASE_LEN] = { 0 };
+    while (TRUE) {
+        guint64 hash = full ? FILTER_SEED_FULL : FILTER_SEED_SHENG;
+        for (size_t i = 0; i < len; i++)
+            hash = hash_step (hash, tokens[i][pos[i]]);
+        if (test (table, hash_finish (hash)))
+            return true;
+
+        size_t i = 0;
+        while (i < len && ++pos[i] == num[i])
+            pos[i++] = 0;
+        if (i == len)
+            return false;
+    }
+}
+
+gsize
+PhraseFilter::memory (void) const
+{
+    gsize bytes = 0;
+    for (size_t i = 0; i < MAX_PHRASE_LEN; i++)
+        bytes += m_tables[i].bits.size () * sizeof (guint64);
+    return bytes;
+}
+
+double
+PhraseFilter::falsePositiveRate (void) const
+{
+    /* a key is a false positive if all its bits are set by other keys */
+    gsize bits = 0;
+    gsize set = 0;
+    for (size_t i = 0; i < MAX_PHRASE_LEN; i++) {
+        const std::vector<guint64> &words = m_tables[i].bits;
+        bits += words.size () * 64;
+        for (size_t j = 0; j < words.size (); j++) {
+            for (guint64 w = words[j]; w != 0; w &= w - 1)
+                set ++;
+        }
+    }
+    if (bits == 0)
+        return 0.0;
+
+    double rate = 1.0;
+    for (size_t i = 0; i < FILTER_HASHES; i++)
+        rate *= (double) set / bits;
+    return rate;
+}
+
+};  // namespace PyZy
@@ -0,0 +1,79 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#ifndef __PYZY_PHRASE_FILTER_H_
+#define __PYZY_PHRASE_FILTER_H_
+
+#include <glib.h>
+#include <vector>
+
+#include "Types.h"
+
+namespace PyZy {
+
+/*
+ * PhraseFilter tells which pinyin spans can not have phrases, so they are
+ * not looked up. Every phrase length is a bloom filter of the (sheng, yun)
+ * sequences of the phrases, and of their sheng sequences for spans with
+ * incomplete syllables. Unlike a static filter it takes the phrases learned
+ * later; a length is forgotten when it is full, and is built again.
+ */
+class PhraseFilter {
+public:
+    PhraseFilter (void);
+
+    /* forgets all lengths */
+    void clear (void);
+    bool isBuilt (size_t len) const { return !m_tables[len - 1].bits.empty (); }
+
+    /* starts the filter of len syllables for up to capacity phrases */
+    void build (size_t len, size_t capacity);
+
+    /* adds a phrase by its 2 * len sheng and yun ids. If the filter of len
+     * is full, it is forgotten and false is returned */
+    bool add (size_t len, const guint8 *ids);
+
+    /* false if no phrase of len syllables matches the id sets, the filter
+     * of len must be built */
+    bool mayExist (const PinyinIdSet *sets, size_t len) const;
+
+    /* the bytes of all filters, and the estimated false positive rate of
+     * the built filters */
+    gsize memory (void) const;
+    double falsePositiveRate (void) const;
+
+private:
+    struct Table {
+        std::vector<guint64> bits;
+        size_t capacity;
+        size_t size;
+    };
+
+    static bool test (const Table &table, guint64 hash);
+    static void set (Table &table, guint64 hash);
+
+private:
+    Table m_tables[MAX_PHRASE_LEN];
+};
+
+};  // namespace PyZy
+
+#endif  // __PYZY_PHRASE_FILTER_H_
@@ -0,0 +1,169 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#include "PhraseLattice.h"
+
+#include <cmath>
+
+#include "Database.h"
+#include "PhrasePool.h"
+
+namespace PyZy {
+
+PhraseLattice::PhraseLattice (void)
+    : m_option (0),
+      m_generation (0),
+      m_freq_per_e (0),
+      m_freq_zero (0)
+{
+}
+
+void
+PhraseLattice::clear (void)
+{
+    m_pinyin.clear ();
+    m_edges.clear ();
+    m_nodes.clear ();
+}
+
+void
+PhraseLattice::release (void)
+{
+    PinyinArray ().swap (m_pinyin);
+    PhrasePool::release (m_edges);
+    std::vector<Node> ().swap (m_nodes);
+}
+
+/* the phrases of the user score at least as the most frequent phrases,
+ * about e^-8.4 of the texts, and more for every use */
+#define PHRASE_SCORE_USER   (-8.4)
+#define PHRASE_SCORE_EPS    (1e-9)
+
+/* the log share of a phrase in the texts by the freq scale of the main
+ * database (see data/db/android/create_db.py), so a path scores the sum of
+ * the log shares of its phrases, and a rare long phrase loses to common
+ * shorter ones. Without the scale every phrase scores 0 */
+inline double
+PhraseLattice::score (const Phrase &phrase) const
+{
+    if (m_freq_per_e == 0)
+        return 0;
+    double score = (phrase.freq - m_freq_zero) / m_freq_per_e;
+    if (phrase.user_freq == 0)
+        return score;
+    return MAX (score, PHRASE_SCORE_USER) + std::log ((double) phrase.user_freq);
+}
+
+inline bool
+PhraseLattice::better (const Node &a, const Node &b) const
+{
+    if (std::fabs (a.score - b.score) > PHRASE_SCORE_EPS)
+        return a.score > b.score;
+    if (a.phrases != b.phrases)
+        return a.phrases < b.phrases;
+    /* the rests of both paths are the best ones, so this prefers the
+     * longer phrase at the first different one, like a greedy match */
+    return a.len > b.len;
+}
+
+void
+PhraseLattice::update (const PinyinArray &pinyin, unsigned int option)
+{
+    g_assert (pinyin.size () <= MAX_PHRASE_LEN);
+
+    /* a modified user database or another option changes every edge */
+    Database &database = Database::instance ();
+    m_freq_per_e = database.freqPerE ();
+    m_freq_zero = database.freqZero ();
+    unsigned int generation = database.generation ();
+    if (option != m_option || generation != m_generation) {
+        clear ();
+        m_option = option;
+        m_generation = generation;
+    }
+
+    /* the length of the unchanged head */
+    size_t stable = 0;
+    while (stable < m_pinyin.size () && stable < pinyin.size () &&
+           m_pinyin[stable].pinyin == pinyin[stable].pinyin)
+        stable ++;
+
+    m_pinyin = pinyin;
+    PhrasePool::acquire (m_edges);
+    m_edges.resize (m_pinyin.size ());
+
+    for (size_t i = 0; i < m_pinyin.size (); i++) {
+        PhraseArray &edges = m_edges[i];
+
+        /* only spans in the head are kept */
+        size_t valid = i < stable ? MIN (edges.size (), stable - i) : 0;
+        edges.resize (valid);
+
+        for (size_t len = valid + 1; i + len <= m_pinyin.size (); len++) {
+            Query query (m_pinyin, i, len, m_option, len);
+            if (query.fill (edges, 1) == 0) {
+                edges.push_back (Phrase ());
+                edges.back ().reset ();
+            }
+        }
+    }
+
+    /* the best paths from every syllable to the end */
+    size_t end = m_pinyin.size ();
+    m_nodes.resize (end + 1);
+    m_nodes[end].score = 0;
+    m_nodes[end].phrases = 0;
+    m_nodes[end].len = 0;
+
+    for (size_t i = end; i-- > 0; ) {
+        Node &node = m_nodes[i];
+        node.len = 0;
+
+        for (size_t len = m_edges[i].size (); len > 0; len--) {
+            const Phrase &phrase = m_edges[i][len - 1];
+            const Node &next = m_nodes[i + len];
+            if (phrase.empty () || (next.len == 0 && i + len != end))
+                continue;
+
+            Node path;
+            path.score = next.score + score (phrase);
+            path.phrases = next.phrases + 1;
+            path.len = len;
+            if (node.len == 0 || better (path, node))
+                node = path;
+        }
+    }
+}
+
+void
+PhraseLattice::bestPath (size_t begin, PhraseArray &phrases) const
+{
+    g_assert (begin <= m_pinyin.size ());
+
+    for (size_t i = begin; i < m_pinyin.size (); ) {
+        const Node &node = m_nodes[i];
+        g_assert (node.len > 0);
+        phrases.push_back (m_edges[i][node.len - 1]);
+        i += node.len;
+    }
+}
+
+};  // namespace PyZy
@@ -0,0 +1,76 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#ifndef __PYZY_PHRASE_LATTICE_H_
+#define __PYZY_PHRASE_LATTICE_H_
+
+#include <vector>
+
+#include "PhraseArray.h"
+#include "PinyinArray.h"
+
+namespace PyZy {
+
+/*
+ * PhraseLattice finds the first candidate of a pinyin array. Its edges are
+ * the best phrases of every span of syllables, user phrases first, and the
+ * best path is the one with the highest sum of the log frequencies of its
+ * phrases, by the freq scale of the main database, or the one with the
+ * fewest phrases if the database does not tell its scale. Edges of
+ * the unchanged head of the pinyin array are kept between updates, so a key
+ * stroke only queries the spans touching the changed syllables.
+ */
+class PhraseLattice {
+public:
+    PhraseLattice (void);
+
+    void update (const PinyinArray &pinyin, unsigned int option);
+    void bestPath (size_t begin, PhraseArray &phrases) const;
+    void clear (void);
+    /* clears and returns the storage of the edges to the pool */
+    void release (void);
+
+private:
+    struct Node {
+        double score;           /* score of the path to the end */
+        size_t phrases;         /* number of phrases to the end */
+        size_t len;             /* length of the first phrase */
+    };
+
+    double score (const Phrase &phrase) const;
+
+    bool better (const Node &a, const Node &b) const;
+
+private:
+    PinyinArray m_pinyin;
+    unsigned int m_option;
+    unsigned int m_generation;
+    double m_freq_per_e;        /* 0 if the scale of freq is not known */
+    double m_freq_zero;
+    /* m_edges[i][len - 1] is the best phrase of the span, an empty phrase
+     * if there is none */
+    std::vector<PhraseArray> m_edges;
+    std::vector<Node> m_nodes;
+};
+
+};  // namespace PyZy
+
+#endif  // __PYZY_PHRASE_LATTICE_H_
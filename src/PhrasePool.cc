@@ -0,0 +1,116 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#include "PhrasePool.h"
+
+namespace PyZy {
+
+/* the storage of more idle contexts is freed */
+#define POOL_MAX_PHRASES    (256)
+#define POOL_MAX_ARRAYS     (64)
+
+GPrivate PhrasePool::m_thread_pool = G_PRIVATE_INIT (PhrasePool::freePool);
+
+/* the storage pooled by a thread is freed when the thread exits */
+void
+PhrasePool::freePool (gpointer data)
+{
+    delete static_cast<Pool *> (data);
+}
+
+inline PhrasePool::Pool &
+PhrasePool::pool (void)
+{
+    Pool *pool = static_cast<Pool *> (g_private_get (&m_thread_pool));
+    if (G_UNLIKELY (pool == NULL)) {
+        pool = new Pool;
+        g_private_set (&m_thread_pool, pool);
+    }
+    return *pool;
+}
+
+template <typename T>
+inline static void
+pool_acquire (std::vector<T> &pool, T &item)
+{
+    if (item.capacity () != 0 || pool.empty ())
+        return;
+    item.swap (pool.back ());
+    pool.pop_back ();
+}
+
+template <typename T>
+inline static void
+pool_release (std::vector<T> &pool, T &item, size_t max_size)
+{
+    if (item.capacity () == 0)
+        return;
+    if (pool.size () < max_size) {
+        pool.push_back (T ());
+        pool.back ().swap (item);
+    }
+    T ().swap (item);
+}
+
+void
+PhrasePool::acquire (PhraseArray &phrases)
+{
+    pool_acquire (pool ().phrases, phrases);
+}
+
+void
+PhrasePool::acquire (std::vector<PhraseArray> &arrays)
+{
+    pool_acquire (pool ().arrays, arrays);
+}
+
+void
+PhrasePool::release (PhraseArray &phrases)
+{
+    phrases.clear ();
+    pool_release (pool ().phrases, phrases, POOL_MAX_PHRASES);
+}
+
+void
+PhrasePool::release (std::vector<PhraseArray> &arrays)
+{
+    /* the arrays keep their storage for the spans of the next input */
+    for (size_t i = 0; i < arrays.size (); i++)
+        arrays[i].clear ();
+    pool_release (pool ().arrays, arrays, POOL_MAX_ARRAYS);
+}
+
+gsize
+PhrasePool::memory (void)
+{
+    const Pool &pool = PhrasePool::pool ();
+    gsize bytes = 0;
+    for (size_t i = 0; i < pool.phrases.size (); i++)
+        bytes += pool.phrases[i].capacity () * sizeof (Phrase);
+    for (size_t i = 0; i < pool.arrays.size (); i++) {
+        bytes += pool.arrays[i].capacity () * sizeof (PhraseArray);
+        for (size_t j = 0; j < pool.arrays[i].size (); j++)
+            bytes += pool.arrays[i][j].capacity () * sizeof (Phrase);
+    }
+    return bytes;
+}
+
+};  // namespace PyZy
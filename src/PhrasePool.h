@@ -0,0 +1,67 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#ifndef __PYZY_PHRASE_POOL_H_
+#define __PYZY_PHRASE_POOL_H_
+
+#include <glib.h>
+#include <vector>
+
+#include "PhraseArray.h"
+
+namespace PyZy {
+
+/*
+ * PhrasePool keeps the storage of the phrase arrays of idle contexts, and
+ * gives it to the contexts which start typing. A process serving many
+ * sessions then holds phrases for the sessions typing at the same time,
+ * not for every session. Each thread has its own pool, so the contexts
+ * of different threads, like the workers of a BatchConverter, do not wait
+ * for each other.
+ */
+class PhrasePool {
+public:
+    /* gives an array without storage the storage of a released one */
+    static void acquire (PhraseArray &phrases);
+    static void acquire (std::vector<PhraseArray> &arrays);
+
+    /* takes the storage of an array, which is left empty */
+    static void release (PhraseArray &phrases);
+    static void release (std::vector<PhraseArray> &arrays);
+
+    /* the bytes of the storage pooled by the calling thread */
+    static gsize memory (void);
+
+private:
+    struct Pool {
+        std::vector<PhraseArray> phrases;
+        std::vector<std::vector<PhraseArray> > arrays;
+    };
+
+    static Pool &pool (void);
+    static void freePool (gpointer data);
+
+    static GPrivate m_thread_pool;
+};
+
+};  // namespace PyZy
+
+#endif  // __PYZY_PHRASE_POOL_H_
@@ -20,7 +20,6 @@
  * USA
  */
 #include "PinyinContext.h"
-#include "SimpTradConverter.h"
 
 namespace PyZy {
 
@@ -36,6 +35,8 @@ PinyinContext::~PinyinContext ()
 void
 PinyinContext::commit (CommitType type)
 {
+    ChangeBatch batch (this);
+
     if (G_UNLIKELY (m_buffer.empty ()))
         return;
 
@@ -71,6 +72,9 @@ PinyinContext::commit (CommitType type)
 void
 PinyinContext::updatePreeditText ()
 {
+    if (deferChange (PREEDIT_TEXT_CHANGED))
+        return;
+
     /* preedit text = selected phrases + highlight candidate + rest text */
     if (G_UNLIKELY (m_phrase_editor.empty () && m_text.empty ())) {
         m_preedit_text.clear ();
@@ -116,10 +120,7 @@ PinyinContext::updatePreeditText ()
                 const Phrase & candidate = m_phrase_editor.candidate (index - m_special_phrases.size ());
                 if (m_text.size () == m_cursor) {
                     /* cursor at end */
-                    if (m_config.modeSimp)
-                        m_buffer << candidate;
-                    else
-                        SimpTradConverter::simpToTrad (candidate, m_buffer);
+                    m_buffer << m_phrase_editor.candidateText (index - m_special_phrases.size ());
                     edit_end_word = m_buffer.utf8Length ();
                     edit_end_byte = m_buffer.size ();
 
@@ -159,6 +160,9 @@ PinyinContext::updatePreeditText ()
 void
 PinyinContext::updateAuxiliaryText (void)
 {
+    if (deferChange (AUXILIARY_TEXT_CHANGED))
+        return;
+
     /* clear pinyin array */
     if (G_UNLIKELY (m_text.empty () || !hasCandidate (0))) {
         m_auxiliary_text = "";
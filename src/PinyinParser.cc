@@ -31,6 +31,8 @@ namespace PyZy {
 #include "Bopomofo.h"
 #include "PinyinParserTable.h"
 
+#define MAX_PINYIN_LEN (6)
+
 static bool
 check_flags (const Pinyin *pinyin, unsigned int option)
 {
@@ -48,13 +50,18 @@ check_flags (const Pinyin *pinyin, unsigned int option)
     return true;
 }
 
-static int
-py_cmp (const void *p1, const void *p2)
+static inline bool
+trie_check_flags (const PinyinTrieNode &node, unsigned int option)
 {
-    const char *str = (const char *) p1;
-    const Pinyin *py = (const Pinyin *) p2;
-
-    return std::strcmp (str, py->text);
+    if (node.flags != 0) {
+        unsigned int flags;
+        flags = node.flags & option;
+        if (flags == 0)
+            return false;
+        if ((flags != node.flags) && ((node.flags & PINYIN_CORRECT_ALL) != 0))
+            return false;
+    }
+    return true;
 }
 
 // TODO(hsumita): Replace "int len" to "size_t len"
@@ -64,64 +71,85 @@ is_pinyin (const char  *p,
            int          len,
            unsigned int option)
 {
-    char buf[8];
-    const Pinyin *result;
+    const Pinyin *result = NULL;
+    unsigned int n = 0;
+    bool exact;
 
-    if (G_UNLIKELY (len > 6))
+    if (G_UNLIKELY (len > MAX_PINYIN_LEN))
         return NULL;
 
     if (G_UNLIKELY (len > end - p))
         return NULL;
 
-    if (G_LIKELY (len > 0)) {
-        std::strncpy (buf, p, len);
-        buf[len] = 0;
-        result = (const Pinyin *) std::bsearch (buf, pinyin_table, G_N_ELEMENTS (pinyin_table),
-                                            sizeof (Pinyin), py_cmp);
-        if (check_flags (result, option))
-            return result;
-        return NULL;
+    /* walk the trie once, and keep the longest pinyin accepted by option,
+     * or the pinyin of exactly len chars if len > 0 */
+    exact = len > 0;
+    if (!exact)
+        len = MIN (MAX_PINYIN_LEN, end - p);
+
+    for (int i = 0; i < len; i++) {
+        const PinyinTrieNode &node = pinyin_trie[n];
+        unsigned char c = p[i];
+        if (c < node.lo || c > node.hi)
+            return exact ? NULL : result;
+        n = pinyin_trie_next[node.next + c - node.lo];
+        if (n == 0)
+            return exact ? NULL : result;
+        if (!exact && pinyin_trie[n].pinyin >= 0 &&
+            trie_check_flags (pinyin_trie[n], option))
+            result = &pinyin_table[pinyin_trie[n].pinyin];
     }
 
-    /* len < 0 */
-    len = MIN (6, end - p);
-    std::strncpy (buf, p, len);
-
-    for (; len > 0; len --) {
-        buf[len] = 0;
-
-        result = (const Pinyin *) std::bsearch (buf, pinyin_table, G_N_ELEMENTS (pinyin_table),
-                                                sizeof (Pinyin), py_cmp);
-        if (G_UNLIKELY (check_flags (result, option))) {
-            return result;
-        }
-    }
+    if (exact && pinyin_trie[n].pinyin >= 0 &&
+        trie_check_flags (pinyin_trie[n], option))
+        result = &pinyin_table[pinyin_trie[n].pinyin];
 
-    return NULL;
+    return result;
 }
 
-static int
-sp_cmp (const void *p1,
-        const void *p2)
+static const Pinyin **
+need_resplit(const Pinyin *p1,
+             const Pinyin *p2)
 {
-    const Pinyin **pys = (const Pinyin **) p1;
-    const Pinyin **e = (const Pinyin **) p2;
+    int row = special_row[p1 - pinyin_table];
+    int column = special_column[p2 - pinyin_table];
 
-    int retval = pys[0] - e[0];
+    if (G_LIKELY (row < 0 || column < 0))
+        return NULL;
 
-    if (retval != 0)
-        return retval;
-    return pys[1] - e[1];
+    int i = special_index[row][column];
+    if (i < 0)
+        return NULL;
+    return (const Pinyin **) special_table[i];
 }
 
-static const Pinyin **
-need_resplit(const Pinyin *p1,
-             const Pinyin *p2)
+size_t
+PinyinParser::parse (const String   &pinyin,
+                     size_t          len,
+                     unsigned int    option,
+                     PinyinArray    &result,
+                     size_t          max)
 {
-    const Pinyin * pys[] = {p1, p2};
+    result.clear ();
+    return parse (pinyin, len, option, result, max, 0);
+}
 
-    return (const Pinyin **) std::bsearch (pys, special_table, G_N_ELEMENTS (special_table),
-                                        sizeof (special_table[0]), sp_cmp);
+/* the segment next was resplit from the tail of the segment prev. Both
+ * resplits of parse (), by need_resplit () or by a shorter prev, move the
+ * last character of a longer pinyin to next, so the text of prev with the
+ * first character of next is a pinyin */
+static inline bool
+is_resplit (const String        &pinyin,
+            size_t               len,
+            const PinyinSegment &prev,
+            const PinyinSegment &next,
+            unsigned int         option)
+{
+    if (next.begin != prev.begin + prev.len)
+        return false;
+    return is_pinyin ((const char *) pinyin + prev.begin,
+                      (const char *) pinyin + len,
+                      prev.len + 1, option) != NULL;
 }
 
 size_t
@@ -129,25 +157,46 @@ PinyinParser::parse (const String   &pinyin,
                      size_t          len,
                      unsigned int    option,
                      PinyinArray    &result,
-                     size_t          max)
+                     size_t          max,
+                     size_t          edit)
 {
     const char *p;
     const char *end;
     const Pinyin *py;
     const Pinyin *prev_py;
     char prev_c;
-
-    result.clear ();
+    size_t keep;
 
     if (G_UNLIKELY (len < 0))
         len = pinyin.size ();
 
+    /* keep the segments which only looked at the text before edit, and
+     * which the segment after them did not resplit */
+    edit = MIN (edit, len);
+    for (keep = result.size (); keep > 0; keep --) {
+        const PinyinSegment & segment = result[keep - 1];
+        if (segment.begin + MAX_PINYIN_LEN > edit)
+            continue;
+        if (keep < result.size () &&
+            is_resplit (pinyin, len, segment, result[keep], option))
+            continue;
+        break;
+    }
+    result.erase (result.begin () + keep, result.end ());
+
     p = pinyin;
     end = p + len;
 
     prev_py = NULL;
-
     prev_c = 0;
+
+    if (keep > 0) {
+        const PinyinSegment & segment = result[keep - 1];
+        p += segment.begin + segment.len;
+        prev_py = segment.pinyin;
+        prev_c = prev_py->text[prev_py->len - 1];
+    }
+
     for (; p < end && result.size () < max; ) {
         if (G_UNLIKELY (*p == '\'')) {
             prev_c = '\'';
@@ -232,52 +281,14 @@ PinyinParser::parse (const String   &pinyin,
     return p - (const char *)pinyin;
 }
 
-static const char * const
-id_map[] = {
-    "", "b", "c", "ch",
-    "d", "f", "g", "h",
-    "j", "k", "l", "m",
-    "n", "p", "q", "r",
-    "s", "sh", "t", "w",
-    "x", "y", "z", "zh",
-    "a", "ai", "an", "ang", "ao",
-    "e", "ei", "en", "eng", "er",
-    "i", "ia", "ian", "iang", "iao",
-    "ie", "in", "ing", "iong", "iu",
-    "o", "ong", "ou",
-    "u", "ua", "uai", "uan", "uang",
-    0, /* it should be ue or ve */
-    "ui", "un", "uo", "v"
-};
-
 const Pinyin *
 PinyinParser::isPinyin (int sheng, int yun, unsigned int option)
 {
-    const Pinyin *result;
-    char buf[16];
-
-    std::strcpy (buf, id_map[sheng]);
-
-    if (yun == PINYIN_ID_UE) {
-        /* append ue or ve base on sheng */
-        switch (sheng) {
-        case PINYIN_ID_J:
-        case PINYIN_ID_Q:
-        case PINYIN_ID_X:
-        case PINYIN_ID_Y:
-            std::strcat (buf, "ue");
-            break;
-        default:
-            std::strcat (buf, "ve");
-            break;
-        }
-    }
-    else {
-        std::strcat (buf, id_map[yun]);
-    }
+    if (G_UNLIKELY (sheng < 0 || sheng >= (int) G_N_ELEMENTS (sheng_yun_table) ||
+                    yun < 0 || yun >= PINYIN_ID_NUM))
+        return NULL;
 
-    result = (const Pinyin *) bsearch (buf, pinyin_table, G_N_ELEMENTS (pinyin_table),
-                                            sizeof (Pinyin), py_cmp);
+    const Pinyin *result = sheng_yun_table[sheng][yun];
     if (check_flags (result, option))
         return result;
     return NULL;
@@ -308,16 +319,37 @@ PinyinParser::parseBopomofo (const std::wstring &bopomofo,
                              PinyinArray        &result,
                              size_t              max)
 {
+    result.clear ();
+    return parseBopomofo (bopomofo, len, option, result, max, 0);
+}
+
+size_t
+PinyinParser::parseBopomofo (const std::wstring &bopomofo,
+                             size_t              len,
+                             unsigned int        option,
+                             PinyinArray        &result,
+                             size_t              max,
+                             size_t              edit)
+{
+    if (G_UNLIKELY (len < 0))
+        len = bopomofo.length ();
+
     std::wstring::const_iterator bpmf = bopomofo.begin();
     const std::wstring::const_iterator end = bpmf + len;
     const Pinyin **bs_res = NULL;
     wchar_t buf[MAX_BOPOMOFO_LEN + 1];
     size_t i, j;
 
-    result.clear ();
+    /* keep the segments which only looked at the text before edit */
+    edit = MIN (edit, len);
+    for (i = result.size (); i > 0; i --) {
+        if (result[i - 1].begin + MAX_BOPOMOFO_LEN <= edit)
+            break;
+    }
+    result.erase (result.begin () + i, result.end ());
 
-    if (G_UNLIKELY (len < 0))
-        len = bopomofo.length ();
+    if (i > 0)
+        bpmf += result[i - 1].begin + result[i - 1].len;
 
     for (; bpmf < end && result.size () < max;) {
         for (i = MAX_BOPOMOFO_LEN; i > 0; i--){
@@ -34,12 +34,27 @@ public:
                          unsigned int  option,      // option
                          PinyinArray  &result,      // store pinyin in result
                          size_t        max);        // max length of the result
+    /* Parses pinyin like parse, but result holds the result of the last
+     * parse of a text which is same as pinyin before edit. Only the tail of
+     * result which may be changed by the edit is parsed again. */
+    static size_t parse (const String &pinyin,      // pinyin string
+                         size_t        len,         // length of pinyin string
+                         unsigned int  option,      // option
+                         PinyinArray  &result,      // last result, updated
+                         size_t        max,         // max length of the result
+                         size_t        edit);       // first changed char
     static const Pinyin * isPinyin (int sheng, int yun, unsigned int option);
     static size_t parseBopomofo (const std::wstring  &bopomofo,
                                  size_t               len,
                                  unsigned int         option,
                                  PinyinArray         &result,
                                  size_t               max);
+    static size_t parseBopomofo (const std::wstring  &bopomofo,
+                                 size_t               len,
+                                 unsigned int         option,
+                                 PinyinArray         &result,
+                                 size_t               max,
+                                 size_t               edit);
     static bool isBopomofoToneChar (const wchar_t ch);
 
 };
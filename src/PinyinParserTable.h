@@ -8087,3 +8087,1757 @@ static const Pinyin *special_table[][4] = {
     { &pinyin_table[731],  &pinyin_table[128],  &pinyin_table[723],  &pinyin_table[366],  }, /* zun e => zu ne */
     { &pinyin_table[731],  &pinyin_table[129],  &pinyin_table[723],  &pinyin_table[368],  }, /* zun ei => zu nei */
 };
+
+/* The resplit of pinyin p1 p2 is special_table[special_index[r][c]], where r is
+ * special_row[p1 - pinyin_table] and c is special_column[p2 - pinyin_table].
+ * -1 means no resplit. */
+static const short special_row[] = {
+    -1, -1, -1, -1, 0, 1, -1, -1, -1, -1, -1, -1, 2, 3, -1, -1,
+    -1, -1, -1, 4, -1, -1, 5, -1, 6, -1, -1, 7, 8, -1, -1, -1,
+    -1, -1, -1, -1, 9, 10, -1, -1, -1, -1, 11, 12, -1, -1, -1, -1,
+    -1, 13, 14, -1, -1, -1, -1, 15, 16, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, 17, -1, -1, -1, 18, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 19, -1, -1, -1, 20, -1, -1, -1, -1, -1, -1, 21, 22,
+    -1, -1, -1, -1, -1, 23, -1, -1, -1, -1, 24, -1, 25, -1, -1, 26,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 27, -1, -1, -1, 28, -1,
+    -1, -1, 29, 30, -1, -1, -1, -1, -1, 31, 32, -1, -1, -1, -1, -1,
+    -1, 33, -1, 34, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 35, -1,
+    -1, -1, -1, -1, -1, 36, 37, -1, -1, -1, -1, -1, 38, 39, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, 40, 41, -1, -1, -1, 42, -1, -1,
+    -1, -1, -1, -1, 43, 44, -1, -1, -1, -1, -1, 45, 46, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, 47, 48, -1, -1, -1, 49, -1, -1,
+    -1, -1, -1, -1, 50, 51, -1, 52, -1, -1, 53, 54, -1, -1, -1, -1,
+    -1, -1, -1, -1, 55, 56, 57, 58, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, 59, 60, -1, -1, -1, -1, -1, 61, 62, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, 63, 64, -1, -1, -1, 65, -1, -1, -1, -1,
+    -1, -1, 66, 67, -1, -1, -1, -1, -1, 68, -1, -1, -1, -1, -1, 69,
+    70, -1, 71, -1, -1, 72, 73, -1, -1, -1, -1, -1, 74, -1, -1, -1,
+    -1, 75, 76, -1, -1, -1, 77, -1, -1, 78, -1, -1, -1, -1, -1, 79,
+    80, -1, -1, -1, -1, -1, 81, 82, -1, -1, 83, -1, 84, -1, -1, 85,
+    86, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 87, 88, -1, -1, -1,
+    -1, -1, 89, 90, -1, -1, -1, -1, -1, 91, -1, 92, -1, -1, 93, 94,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 95, 96, -1, 97, -1, -1,
+    98, -1, -1, -1, -1, -1, -1, -1, 99, 100, -1, -1, -1, -1, -1, 101,
+    -1, -1, 102, -1, 103, -1, -1, 104, 105, -1, -1, -1, -1, -1, -1, -1,
+    -1, 106, 107, -1, 108, -1, -1, 109, 110, -1, -1, -1, -1, -1, -1, -1,
+    -1, 111, 112, 113, 114, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 115, -1, -1, -1, -1, -1, 116, 117, -1, -1, -1, -1, -1, 118, 119,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 120, 121, -1, -1, -1,
+    122, -1, -1, -1, -1, -1, -1, -1, -1, 123, 124, -1, -1, -1, -1, -1,
+    125, 126, -1, -1, -1, -1, -1, 127, 128, -1, -1, -1, -1, -1, 129, 130,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 131, 132, -1, -1, -1, 133, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 134, -1, -1, -1, 135, -1,
+    -1, -1, -1, -1, -1, 136, 137, -1, -1, -1, -1, 138, -1, -1, -1, 139,
+    -1, 140, -1, -1, 141, -1, -1, -1, -1, -1, -1, -1, -1, 142, -1, -1,
+    -1, 143, -1, -1, -1, -1, -1, -1, 144, 145, -1, -1, -1, -1, 146, -1,
+    -1, -1, -1, -1, -1, -1, 147, 148, -1, 149, -1, -1, 150, 151, -1, -1,
+    -1, -1, -1, -1, -1, -1, 152, 153, 154, 155, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, 156, 157, -1, -1, -1, -1, -1, 158, 159, -1, -1, -1,
+    160, -1, -1, -1, -1, 161, 162, 163, 164, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, 165, 166, -1, -1, -1, -1, -1, 167, 168, -1, -1, -1,
+    -1, -1, 169, 170, -1, -1, -1, -1, -1, 171, 172, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, 173, 174, -1, -1, -1, 175, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, 176, -1, -1, -1, 177, -1,
+};
+
+static const signed char special_column[] = {
+    0, -1, 1, -1, 2, 3, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    5, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 9, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+static const short special_index[][10] = {
+    { 0, 1, -1, -1, 2, 3, 4, -1, -1, -1 }, /* an */
+    { 5, 6, 7, 8, 9, 10, 11, 12, 13, -1 }, /* ang */
+    { 14, -1, -1, 15, 16, 17, 18, -1, -1, -1 }, /* ban */
+    { -1, 19, -1, 20, 21, 22, 23, 24, -1, -1 }, /* bang */
+    { 25, 26, 27, 28, 29, 30, 31, 32, 33, -1 }, /* beng */
+    { 34, 35, 36, 37, 38, 39, 40, 41, 42, -1 }, /* biang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 43 }, /* bie */
+    { 44, 45, 46, 47, 48, 49, 50, 51, -1, -1 }, /* bin */
+    { -1, -1, -1, -1, -1, 52, 53, -1, -1, -1 }, /* bing */
+    { -1, -1, -1, -1, -1, -1, 54, -1, -1, -1 }, /* can */
+    { -1, -1, 55, 56, -1, 57, 58, 59, 60, -1 }, /* cang */
+    { 61, 62, 63, 64, 65, 66, 67, 68, -1, -1 }, /* cen */
+    { -1, -1, -1, -1, -1, -1, 69, -1, -1, -1 }, /* ceng */
+    { 70, -1, -1, -1, 71, 72, 73, -1, -1, -1 }, /* chan */
+    { -1, -1, -1, 74, 75, -1, 76, 77, 78, -1 }, /* chang */
+    { 79, -1, 80, 81, 82, 83, 84, -1, -1, -1 }, /* chen */
+    { -1, -1, -1, 85, 86, -1, 87, -1, 88, -1 }, /* cheng */
+    { -1, -1, 89, 90, 91, 92, 93, 94, 95, -1 }, /* chuang */
+    { 96, -1, 97, 98, 99, 100, 101, -1, -1, -1 }, /* chun */
+    { 102, 103, 104, 105, 106, 107, 108, 109, 110, -1 }, /* cuang */
+    { -1, -1, -1, -1, -1, 111, 112, -1, -1, -1 }, /* cun */
+    { 113, 114, 115, 116, 117, 118, 119, -1, -1, -1 }, /* dan */
+    { -1, 120, -1, 121, 122, 123, 124, 125, -1, -1 }, /* dang */
+    { 126, 127, 128, 129, 130, 131, 132, 133, 134, -1 }, /* den */
+    { 135, 136, 137, 138, 139, 140, 141, 142, 143, -1 }, /* diang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 144 }, /* die */
+    { 145, 146, 147, 148, 149, 150, 151, 152, 153, -1 }, /* din */
+    { 154, 155, 156, 157, 158, 159, 160, 161, 162, -1 }, /* duang */
+    { 163, -1, 164, 165, 166, 167, 168, -1, -1, -1 }, /* dun */
+    { -1, -1, 169, 170, 171, 172, 173, -1, -1, -1 }, /* en */
+    { -1, -1, 174, 175, -1, -1, -1, 176, 177, -1 }, /* er */
+    { -1, -1, -1, 178, 179, -1, 180, -1, -1, -1 }, /* fan */
+    { -1, -1, -1, 181, 182, 183, 184, 185, -1, -1 }, /* fang */
+    { -1, -1, -1, 186, 187, 188, 189, 190, 191, -1 }, /* feng */
+    { 192, 193, 194, 195, 196, 197, 198, 199, 200, -1 }, /* fon */
+    { 201, 202, 203, 204, 205, 206, 207, 208, 209, -1 }, /* fun */
+    { -1, -1, -1, -1, -1, 210, 211, -1, -1, -1 }, /* gan */
+    { 212, 213, 214, 215, -1, 216, 217, 218, 219, -1 }, /* gang */
+    { 220, -1, 221, 222, 223, 224, 225, -1, -1, -1 }, /* gen */
+    { -1, -1, -1, 226, 227, 228, 229, 230, 231, -1 }, /* geng */
+    { -1, -1, -1, -1, -1, -1, 232, -1, -1, -1 }, /* guan */
+    { -1, 233, -1, 234, 235, 236, 237, 238, -1, -1 }, /* guang */
+    { -1, -1, 239, 240, 241, 242, 243, -1, -1, -1 }, /* gun */
+    { -1, -1, -1, 244, 245, -1, 246, -1, -1, -1 }, /* han */
+    { -1, 247, -1, 248, 249, 250, 251, 252, 253, -1 }, /* hang */
+    { 254, -1, 255, 256, 257, -1, 258, -1, -1, -1 }, /* hen */
+    { -1, 259, 260, 261, 262, -1, 263, 264, 265, -1 }, /* heng */
+    { 266, -1, 267, 268, 269, 270, 271, 272, -1, -1 }, /* huan */
+    { -1, 273, -1, 274, 275, 276, 277, -1, 278, -1 }, /* huang */
+    { -1, -1, 279, 280, 281, -1, 282, -1, -1, -1 }, /* hun */
+    { 283, 284, -1, 285, -1, 286, 287, -1, -1, -1 }, /* jian */
+    { -1, -1, -1, 288, 289, 290, 291, -1, 292, -1 }, /* jiang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 293 }, /* jie */
+    { 294, -1, 295, 296, 297, -1, 298, -1, -1, -1 }, /* jin */
+    { -1, -1, -1, 299, 300, -1, 301, 302, 303, -1 }, /* jing */
+    { 304, 305, 306, 307, 308, 309, 310, 311, 312, -1 }, /* juang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 313 }, /* jue */
+    { 314, 315, 316, 317, 318, 319, 320, 321, 322, -1 }, /* juen */
+    { 323, 324, -1, -1, -1, 325, 326, -1, -1, -1 }, /* jun */
+    { -1, -1, -1, -1, -1, -1, 327, -1, -1, -1 }, /* kan */
+    { -1, -1, 328, 329, 330, 331, 332, 333, 334, -1 }, /* kang */
+    { 335, 336, 337, 338, 339, 340, 341, -1, -1, -1 }, /* ken */
+    { -1, 342, 343, 344, 345, 346, 347, 348, 349, -1 }, /* keng */
+    { 350, -1, -1, -1, -1, -1, 351, -1, -1, -1 }, /* kuan */
+    { -1, -1, -1, 352, -1, 353, 354, 355, -1, -1 }, /* kuang */
+    { -1, -1, 356, 357, 358, 359, 360, -1, -1, -1 }, /* kun */
+    { 361, -1, 362, 363, 364, 365, 366, -1, -1, -1 }, /* lan */
+    { -1, -1, 367, 368, 369, 370, 371, 372, 373, -1 }, /* lang */
+    { 374, 375, 376, 377, 378, 379, 380, 381, 382, -1 }, /* len */
+    { -1, -1, -1, -1, -1, -1, 383, -1, -1, -1 }, /* lian */
+    { -1, -1, -1, 384, 385, 386, 387, 388, 389, -1 }, /* liang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 390 }, /* lie */
+    { 391, -1, 392, 393, 394, 395, 396, -1, -1, -1 }, /* lin */
+    { -1, -1, -1, 397, 398, 399, 400, 401, 402, -1 }, /* ling */
+    { 403, 404, 405, 406, 407, 408, 409, 410, 411, -1 }, /* lon */
+    { 412, 413, 414, 415, 416, 417, 418, 419, 420, -1 }, /* luang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 421 }, /* lue */
+    { 422, 423, 424, 425, 426, 427, 428, -1, -1, -1 }, /* lun */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 429 }, /* lve */
+    { -1, 430, 431, 432, 433, 434, 435, -1, -1, -1 }, /* man */
+    { -1, 436, 437, 438, 439, 440, 441, 442, 443, -1 }, /* mang */
+    { -1, -1, -1, 444, 445, 446, 447, -1, -1, -1 }, /* men */
+    { -1, 448, -1, 449, 450, 451, 452, -1, 453, -1 }, /* meng */
+    { 454, 455, 456, 457, 458, 459, 460, 461, 462, -1 }, /* miang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 463 }, /* mie */
+    { 464, -1, -1, -1, -1, 465, 466, -1, -1, -1 }, /* min */
+    { -1, -1, 467, 468, 469, 470, 471, -1, 472, -1 }, /* ming */
+    { 473, -1, -1, 474, -1, 475, 476, -1, -1, -1 }, /* nan */
+    { 477, 478, 479, 480, 481, 482, 483, 484, 485, -1 }, /* nang */
+    { 486, 487, 488, 489, 490, 491, 492, 493, -1, -1 }, /* nen */
+    { -1, -1, -1, -1, -1, 494, 495, -1, -1, -1 }, /* neng */
+    { -1, 496, 497, 498, 499, 500, 501, 502, 503, -1 }, /* niang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 504 }, /* nie */
+    { 505, -1, 506, 507, 508, 509, 510, -1, -1, -1 }, /* nin */
+    { -1, 511, -1, 512, 513, -1, 514, 515, 516, -1 }, /* ning */
+    { 517, 518, 519, 520, 521, 522, 523, 524, 525, -1 }, /* nuang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 526 }, /* nue */
+    { 527, 528, 529, 530, 531, 532, 533, 534, 535, -1 }, /* nun */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 536 }, /* nve */
+    { 537, -1, -1, 538, 539, 540, 541, -1, -1, -1 }, /* pan */
+    { -1, -1, -1, 542, 543, 544, 545, 546, 547, -1 }, /* pang */
+    { -1, -1, -1, 548, 549, 550, 551, -1, -1, -1 }, /* peng */
+    { 552, 553, 554, 555, 556, 557, 558, 559, 560, -1 }, /* piang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 561 }, /* pie */
+    { 562, -1, -1, 563, 564, 565, 566, -1, -1, -1 }, /* pin */
+    { -1, -1, -1, 567, 568, 569, 570, 571, 572, -1 }, /* ping */
+    { -1, -1, -1, -1, -1, -1, 573, -1, -1, -1 }, /* qian */
+    { -1, 574, 575, 576, 577, 578, 579, 580, 581, -1 }, /* qiang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 582 }, /* qie */
+    { 583, -1, -1, 584, 585, 586, 587, -1, -1, -1 }, /* qin */
+    { -1, -1, -1, 588, 589, 590, 591, 592, 593, -1 }, /* qing */
+    { 594, 595, 596, 597, 598, 599, 600, 601, 602, -1 }, /* quang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 603 }, /* que */
+    { 604, 605, 606, 607, 608, 609, 610, 611, 612, -1 }, /* quen */
+    { 613, -1, 614, 615, 616, 617, 618, -1, -1, -1 }, /* qun */
+    { -1, -1, -1, 619, 620, -1, 621, 622, -1, -1 }, /* rang */
+    { -1, -1, -1, -1, 623, 624, 625, -1, -1, -1 }, /* ren */
+    { 626, 627, 628, 629, 630, 631, 632, 633, 634, -1 }, /* reng */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 635 }, /* rie */
+    { 636, 637, 638, 639, 640, 641, 642, 643, 644, -1 }, /* rin */
+    { 645, 646, 647, 648, 649, 650, 651, 652, 653, -1 }, /* ruang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 654 }, /* rue */
+    { 655, 656, 657, 658, 659, 660, 661, 662, -1, -1 }, /* run */
+    { 663, -1, -1, -1, -1, -1, 664, -1, -1, -1 }, /* san */
+    { -1, 665, 666, 667, 668, 669, 670, 671, -1, -1 }, /* sang */
+    { 672, 673, 674, 675, 676, 677, 678, -1, -1, -1 }, /* sen */
+    { -1, 679, 680, 681, 682, 683, 684, 685, 686, -1 }, /* seng */
+    { 687, -1, 688, -1, -1, -1, 689, -1, -1, -1 }, /* shan */
+    { -1, 690, -1, 691, 692, 693, 694, 695, 696, -1 }, /* shang */
+    { -1, -1, -1, -1, -1, -1, 697, -1, -1, -1 }, /* shen */
+    { -1, -1, 698, 699, 700, 701, 702, -1, 703, -1 }, /* sheng */
+    { 704, 705, 706, 707, 708, 709, 710, -1, -1, -1 }, /* shuan */
+    { -1, -1, -1, -1, -1, -1, 711, -1, -1, -1 }, /* shuang */
+    { -1, -1, 712, 713, 714, 715, 716, -1, -1, -1 }, /* shun */
+    { 717, 718, 719, 720, 721, 722, 723, 724, 725, -1 }, /* suang */
+    { 726, -1, 727, 728, 729, 730, 731, -1, -1, -1 }, /* sun */
+    { 732, -1, -1, 733, 734, 735, 736, -1, -1, -1 }, /* tan */
+    { -1, 737, 738, 739, -1, 740, 741, -1, 742, -1 }, /* tang */
+    { 743, 744, 745, 746, 747, 748, 749, 750, 751, -1 }, /* ten */
+    { 752, 753, 754, 755, 756, 757, 758, 759, 760, -1 }, /* tiang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 761 }, /* tie */
+    { 762, 763, 764, 765, 766, 767, 768, 769, 770, -1 }, /* tin */
+    { 771, 772, 773, 774, 775, 776, 777, 778, 779, -1 }, /* tuang */
+    { 780, 781, 782, 783, 784, 785, 786, 787, -1, -1 }, /* tun */
+    { -1, -1, -1, -1, -1, -1, 788, -1, -1, -1 }, /* wan */
+    { -1, -1, -1, 789, 790, 791, 792, -1, 793, -1 }, /* wang */
+    { 794, 795, 796, 797, 798, 799, 800, 801, 802, -1 }, /* weng */
+    { 803, -1, -1, 804, 805, -1, 806, -1, -1, -1 }, /* xian */
+    { -1, -1, -1, 807, 808, -1, 809, 810, 811, -1 }, /* xiang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 812 }, /* xie */
+    { 813, -1, 814, -1, -1, 815, 816, 817, -1, -1 }, /* xin */
+    { -1, -1, 818, 819, 820, 821, 822, 823, 824, -1 }, /* xing */
+    { 825, 826, 827, 828, 829, 830, 831, 832, 833, -1 }, /* xuang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 834 }, /* xue */
+    { 835, 836, 837, 838, 839, 840, 841, 842, 843, -1 }, /* xuen */
+    { -1, -1, -1, 844, 845, 846, 847, -1, -1, -1 }, /* xun */
+    { 848, -1, -1, -1, -1, 849, 850, -1, -1, -1 }, /* yan */
+    { -1, 851, 852, 853, 854, 855, 856, -1, 857, -1 }, /* yang */
+    { 858, 859, 860, 861, 862, -1, 863, -1, -1, -1 }, /* yin */
+    { -1, 864, -1, 865, 866, -1, 867, 868, 869, -1 }, /* ying */
+    { 870, 871, 872, 873, 874, 875, 876, 877, 878, -1 }, /* yon */
+    { 879, 880, 881, 882, 883, 884, 885, 886, 887, -1 }, /* yuang */
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, 888 }, /* yue */
+    { 889, 890, 891, 892, 893, 894, 895, 896, 897, -1 }, /* yuen */
+    { 898, 899, 900, 901, 902, 903, 904, -1, -1, -1 }, /* yun */
+    { 905, -1, 906, 907, 908, 909, 910, -1, -1, -1 }, /* zan */
+    { -1, -1, 911, 912, 913, 914, 915, 916, 917, -1 }, /* zang */
+    { 918, -1, 919, -1, 920, 921, 922, -1, -1, -1 }, /* zen */
+    { -1, 923, 924, 925, 926, -1, 927, 928, 929, -1 }, /* zeng */
+    { -1, -1, -1, -1, -1, -1, 930, -1, -1, -1 }, /* zhan */
+    { -1, -1, 931, 932, 933, 934, 935, 936, 937, -1 }, /* zhang */
+    { 938, -1, 939, 940, 941, 942, 943, -1, -1, -1 }, /* zhen */
+    { -1, 944, 945, 946, 947, 948, 949, 950, 951, -1 }, /* zheng */
+    { -1, -1, -1, -1, 952, 953, 954, -1, -1, -1 }, /* zhuan */
+    { -1, 955, 956, 957, 958, 959, 960, 961, 962, -1 }, /* zhuang */
+    { 963, -1, 964, 965, 966, 967, 968, -1, -1, -1 }, /* zhun */
+    { 969, 970, 971, 972, 973, 974, 975, 976, 977, -1 }, /* zuang */
+    { 978, -1, 979, 980, 981, 982, 983, -1, -1, -1 }, /* zun */
+};
+
+/* The trie of the text of pinyin_table, pinyin_trie[0] is the root. The child
+ * of a node for char c is pinyin_trie_next[next + c - lo] if lo <= c <= hi,
+ * 0 means no child. A leaf has hi < lo. */
+struct PinyinTrieNode {
+    unsigned char   lo;
+    unsigned char   hi;
+    unsigned short  next;
+    short           pinyin;     /* index in pinyin_table, -1 if no pinyin ends here */
+    unsigned int    flags;      /* flags of the pinyin */
+};
+
+static const PinyinTrieNode pinyin_trie[] = {
+    { 'a', 'z', 0, -1, 0 }, /* "" */
+    { 'g', 'o', 26, 0, 0 }, /* "a" */
+    { 'n', 'n', 35, -1, 0 }, /* "ag" */
+    { 1, 0, 0, 1, PINYIN_CORRECT_GN_TO_NG }, /* "agn" */
+    { 1, 0, 0, 2, 0 }, /* "ai" */
+    { 'g', 'g', 36, -1, 0 }, /* "am" */
+    { 1, 0, 0, 3, PINYIN_CORRECT_MG_TO_NG }, /* "amg" */
+    { 'g', 'g', 37, 4, 0 }, /* "an" */
+    { 1, 0, 0, 5, 0 }, /* "ang" */
+    { 1, 0, 0, 6, 0 }, /* "ao" */
+    { 'a', 'u', 38, 7, PINYIN_INCOMPLETE_PINYIN }, /* "b" */
+    { 'g', 'o', 59, 8, 0 }, /* "ba" */
+    { 'n', 'n', 68, -1, 0 }, /* "bag" */
+    { 1, 0, 0, 9, PINYIN_CORRECT_GN_TO_NG }, /* "bagn" */
+    { 1, 0, 0, 10, 0 }, /* "bai" */
+    { 'g', 'g', 69, -1, 0 }, /* "bam" */
+    { 1, 0, 0, 11, PINYIN_CORRECT_MG_TO_NG }, /* "bamg" */
+    { 'g', 'g', 70, 12, 0 }, /* "ban" */
+    { 1, 0, 0, 13, 0 }, /* "bang" */
+    { 1, 0, 0, 14, 0 }, /* "bao" */
+    { 'g', 'n', 71, -1, 0 }, /* "be" */
+    { 'n', 'n', 79, -1, 0 }, /* "beg" */
+    { 1, 0, 0, 15, PINYIN_CORRECT_GN_TO_NG }, /* "begn" */
+    { 1, 0, 0, 16, 0 }, /* "bei" */
+    { 'g', 'g', 80, -1, 0 }, /* "bem" */
+    { 1, 0, 0, 17, PINYIN_CORRECT_MG_TO_NG }, /* "bemg" */
+    { 'g', 'g', 81, 18, 0 }, /* "ben" */
+    { 1, 0, 0, 19, 0 }, /* "beng" */
+    { 'a', 'n', 82, 20, 0 }, /* "bi" */
+    { 'n', 'o', 96, -1, 0 }, /* "bia" */
+    { 'g', 'g', 98, 21, 0 }, /* "bian" */
+    { 1, 0, 0, 22, PINYIN_FUZZY_IANG_IAN }, /* "biang" */
+    { 1, 0, 0, 23, 0 }, /* "biao" */
+    { 1, 0, 0, 24, 0 }, /* "bie" */
+    { 'n', 'n', 99, -1, 0 }, /* "big" */
+    { 1, 0, 0, 25, PINYIN_CORRECT_GN_TO_NG }, /* "bign" */
+    { 'g', 'g', 100, -1, 0 }, /* "bim" */
+    { 1, 0, 0, 26, PINYIN_CORRECT_MG_TO_NG }, /* "bimg" */
+    { 'g', 'g', 101, 27, 0 }, /* "bin" */
+    { 1, 0, 0, 28, 0 }, /* "bing" */
+    { 1, 0, 0, 29, 0 }, /* "bo" */
+    { 1, 0, 0, 30, 0 }, /* "bu" */
+    { 'a', 'u', 102, 31, PINYIN_INCOMPLETE_PINYIN }, /* "c" */
+    { 'g', 'o', 123, 32, 0 }, /* "ca" */
+    { 'n', 'n', 132, -1, 0 }, /* "cag" */
+    { 1, 0, 0, 33, PINYIN_CORRECT_GN_TO_NG }, /* "cagn" */
+    { 1, 0, 0, 34, 0 }, /* "cai" */
+    { 'g', 'g', 133, -1, 0 }, /* "cam" */
+    { 1, 0, 0, 35, PINYIN_CORRECT_MG_TO_NG }, /* "camg" */
+    { 'g', 'g', 134, 36, 0 }, /* "can" */
+    { 1, 0, 0, 37, 0 }, /* "cang" */
+    { 1, 0, 0, 38, 0 }, /* "cao" */
+    { 'g', 'n', 135, 39, 0 }, /* "ce" */
+    { 'n', 'n', 143, -1, 0 }, /* "ceg" */
+    { 1, 0, 0, 40, PINYIN_CORRECT_GN_TO_NG }, /* "cegn" */
+    { 'g', 'g', 144, -1, 0 }, /* "cem" */
+    { 1, 0, 0, 41, PINYIN_CORRECT_MG_TO_NG }, /* "cemg" */
+    { 'g', 'g', 145, 42, 0 }, /* "cen" */
+    { 1, 0, 0, 43, 0 }, /* "ceng" */
+    { 'a', 'u', 146, 44, PINYIN_INCOMPLETE_PINYIN }, /* "ch" */
+    { 'g', 'o', 167, 45, 0 }, /* "cha" */
+    { 'n', 'n', 176, -1, 0 }, /* "chag" */
+    { 1, 0, 0, 46, PINYIN_CORRECT_GN_TO_NG }, /* "chagn" */
+    { 1, 0, 0, 47, 0 }, /* "chai" */
+    { 'g', 'g', 177, -1, 0 }, /* "cham" */
+    { 1, 0, 0, 48, PINYIN_CORRECT_MG_TO_NG }, /* "chamg" */
+    { 'g', 'g', 178, 49, 0 }, /* "chan" */
+    { 1, 0, 0, 50, 0 }, /* "chang" */
+    { 1, 0, 0, 51, 0 }, /* "chao" */
+    { 'g', 'n', 179, 52, 0 }, /* "che" */
+    { 'n', 'n', 187, -1, 0 }, /* "cheg" */
+    { 1, 0, 0, 53, PINYIN_CORRECT_GN_TO_NG }, /* "chegn" */
+    { 'g', 'g', 188, -1, 0 }, /* "chem" */
+    { 1, 0, 0, 54, PINYIN_CORRECT_MG_TO_NG }, /* "chemg" */
+    { 'g', 'g', 189, 55, 0 }, /* "chen" */
+    { 1, 0, 0, 56, 0 }, /* "cheng" */
+    { 1, 0, 0, 57, 0 }, /* "chi" */
+    { 'g', 'u', 190, -1, 0 }, /* "cho" */
+    { 'n', 'n', 205, -1, 0 }, /* "chog" */
+    { 1, 0, 0, 58, PINYIN_CORRECT_GN_TO_NG }, /* "chogn" */
+    { 'g', 'g', 206, -1, 0 }, /* "chom" */
+    { 1, 0, 0, 59, PINYIN_CORRECT_MG_TO_NG }, /* "chomg" */
+    { 'g', 'g', 207, 60, PINYIN_CORRECT_ON_TO_ONG }, /* "chon" */
+    { 1, 0, 0, 61, 0 }, /* "chong" */
+    { 1, 0, 0, 62, 0 }, /* "chou" */
+    { 'a', 'o', 208, 63, 0 }, /* "chu" */
+    { 'g', 'n', 223, -1, 0 }, /* "chua" */
+    { 'n', 'n', 231, -1, 0 }, /* "chuag" */
+    { 1, 0, 0, 64, PINYIN_CORRECT_GN_TO_NG }, /* "chuagn" */
+    { 1, 0, 0, 65, 0 }, /* "chuai" */
+    { 'g', 'g', 232, -1, 0 }, /* "chuam" */
+    { 1, 0, 0, 66, PINYIN_CORRECT_MG_TO_NG }, /* "chuamg" */
+    { 'g', 'g', 233, 67, 0 }, /* "chuan" */
+    { 1, 0, 0, 68, 0 }, /* "chuang" */
+    { 'i', 'n', 234, -1, 0 }, /* "chue" */
+    { 1, 0, 0, 69, PINYIN_CORRECT_UEI_TO_UI }, /* "chuei" */
+    { 1, 0, 0, 70, PINYIN_CORRECT_UEN_TO_UN }, /* "chuen" */
+    { 1, 0, 0, 71, 0 }, /* "chui" */
+    { 1, 0, 0, 72, 0 }, /* "chun" */
+    { 1, 0, 0, 73, 0 }, /* "chuo" */
+    { 1, 0, 0, 74, 0 }, /* "ci" */
+    { 'g', 'u', 240, -1, 0 }, /* "co" */
+    { 'n', 'n', 255, -1, 0 }, /* "cog" */
+    { 1, 0, 0, 75, PINYIN_CORRECT_GN_TO_NG }, /* "cogn" */
+    { 'g', 'g', 256, -1, 0 }, /* "com" */
+    { 1, 0, 0, 76, PINYIN_CORRECT_MG_TO_NG }, /* "comg" */
+    { 'g', 'g', 257, 77, PINYIN_CORRECT_ON_TO_ONG }, /* "con" */
+    { 1, 0, 0, 78, 0 }, /* "cong" */
+    { 1, 0, 0, 79, 0 }, /* "cou" */
+    { 'a', 'o', 258, 80, 0 }, /* "cu" */
+    { 'i', 'n', 273, -1, 0 }, /* "cua" */
+    { 1, 0, 0, 81, PINYIN_FUZZY_C_CH }, /* "cuai" */
+    { 'g', 'g', 279, 82, 0 }, /* "cuan" */
+    { 1, 0, 0, 83, PINYIN_FUZZY_C_CH | PINYIN_FUZZY_UANG_UAN }, /* "cuang" */
+    { 'i', 'n', 280, -1, 0 }, /* "cue" */
+    { 1, 0, 0, 84, PINYIN_CORRECT_UEI_TO_UI }, /* "cuei" */
+    { 1, 0, 0, 85, PINYIN_CORRECT_UEN_TO_UN }, /* "cuen" */
+    { 1, 0, 0, 86, 0 }, /* "cui" */
+    { 1, 0, 0, 87, 0 }, /* "cun" */
+    { 1, 0, 0, 88, 0 }, /* "cuo" */
+    { 'a', 'u', 286, 89, PINYIN_INCOMPLETE_PINYIN }, /* "d" */
+    { 'g', 'o', 307, 90, 0 }, /* "da" */
+    { 'n', 'n', 316, -1, 0 }, /* "dag" */
+    { 1, 0, 0, 91, PINYIN_CORRECT_GN_TO_NG }, /* "dagn" */
+    { 1, 0, 0, 92, 0 }, /* "dai" */
+    { 'g', 'g', 317, -1, 0 }, /* "dam" */
+    { 1, 0, 0, 93, PINYIN_CORRECT_MG_TO_NG }, /* "damg" */
+    { 'g', 'g', 318, 94, 0 }, /* "dan" */
+    { 1, 0, 0, 95, 0 }, /* "dang" */
+    { 1, 0, 0, 96, 0 }, /* "dao" */
+    { 'g', 'n', 319, 97, 0 }, /* "de" */
+    { 'n', 'n', 327, -1, 0 }, /* "deg" */
+    { 1, 0, 0, 98, PINYIN_CORRECT_GN_TO_NG }, /* "degn" */
+    { 1, 0, 0, 99, 0 }, /* "dei" */
+    { 'g', 'g', 328, -1, 0 }, /* "dem" */
+    { 1, 0, 0, 100, PINYIN_CORRECT_MG_TO_NG }, /* "demg" */
+    { 'g', 'g', 329, 101, PINYIN_FUZZY_EN_ENG }, /* "den" */
+    { 1, 0, 0, 102, 0 }, /* "deng" */
+    { 'a', 'u', 330, 103, 0 }, /* "di" */
+    { 'n', 'o', 351, 104, 0 }, /* "dia" */
+    { 'g', 'g', 353, 105, 0 }, /* "dian" */
+    { 1, 0, 0, 106, PINYIN_FUZZY_IANG_IAN }, /* "diang" */
+    { 1, 0, 0, 107, 0 }, /* "diao" */
+    { 1, 0, 0, 108, 0 }, /* "die" */
+    { 'n', 'n', 354, -1, 0 }, /* "dig" */
+    { 1, 0, 0, 109, PINYIN_CORRECT_GN_TO_NG }, /* "dign" */
+    { 'g', 'g', 355, -1, 0 }, /* "dim" */
+    { 1, 0, 0, 110, PINYIN_CORRECT_MG_TO_NG }, /* "dimg" */
+    { 'g', 'g', 356, 111, PINYIN_FUZZY_IN_ING }, /* "din" */
+    { 1, 0, 0, 112, 0 }, /* "ding" */
+    { 'u', 'u', 357, -1, 0 }, /* "dio" */
+    { 1, 0, 0, 113, PINYIN_CORRECT_IOU_TO_IU }, /* "diou" */
+    { 1, 0, 0, 114, 0 }, /* "diu" */
+    { 'g', 'u', 358, -1, 0 }, /* "do" */
+    { 'n', 'n', 373, -1, 0 }, /* "dog" */
+    { 1, 0, 0, 115, PINYIN_CORRECT_GN_TO_NG }, /* "dogn" */
+    { 'g', 'g', 374, -1, 0 }, /* "dom" */
+    { 1, 0, 0, 116, PINYIN_CORRECT_MG_TO_NG }, /* "domg" */
+    { 'g', 'g', 375, 117, PINYIN_CORRECT_ON_TO_ONG }, /* "don" */
+    { 1, 0, 0, 118, 0 }, /* "dong" */
+    { 1, 0, 0, 119, 0 }, /* "dou" */
+    { 'a', 'o', 376, 120, 0 }, /* "du" */
+    { 'n', 'n', 391, -1, 0 }, /* "dua" */
+    { 'g', 'g', 392, 121, 0 }, /* "duan" */
+    { 1, 0, 0, 122, PINYIN_FUZZY_UANG_UAN }, /* "duang" */
+    { 'i', 'n', 393, -1, 0 }, /* "due" */
+    { 1, 0, 0, 123, PINYIN_CORRECT_UEI_TO_UI }, /* "duei" */
+    { 1, 0, 0, 124, PINYIN_CORRECT_UEN_TO_UN }, /* "duen" */
+    { 1, 0, 0, 125, 0 }, /* "dui" */
+    { 1, 0, 0, 126, 0 }, /* "dun" */
+    { 1, 0, 0, 127, 0 }, /* "duo" */
+    { 'i', 'r', 399, 128, 0 }, /* "e" */
+    { 1, 0, 0, 129, 0 }, /* "ei" */
+    { 1, 0, 0, 130, 0 }, /* "en" */
+    { 1, 0, 0, 131, 0 }, /* "er" */
+    { 'a', 'u', 409, 132, PINYIN_INCOMPLETE_PINYIN }, /* "f" */
+    { 'g', 'o', 430, 133, 0 }, /* "fa" */
+    { 'n', 'n', 439, -1, 0 }, /* "fag" */
+    { 1, 0, 0, 134, PINYIN_CORRECT_GN_TO_NG }, /* "fagn" */
+    { 1, 0, 0, 135, PINYIN_FUZZY_F_H }, /* "fai" */
+    { 'g', 'g', 440, -1, 0 }, /* "fam" */
+    { 1, 0, 0, 136, PINYIN_CORRECT_MG_TO_NG }, /* "famg" */
+    { 'g', 'g', 441, 137, 0 }, /* "fan" */
+    { 1, 0, 0, 138, 0 }, /* "fang" */
+    { 1, 0, 0, 139, PINYIN_FUZZY_F_H }, /* "fao" */
+    { 'g', 'n', 442, 140, PINYIN_FUZZY_F_H }, /* "fe" */
+    { 'n', 'n', 450, -1, 0 }, /* "feg" */
+    { 1, 0, 0, 141, PINYIN_CORRECT_GN_TO_NG }, /* "fegn" */
+    { 1, 0, 0, 142, 0 }, /* "fei" */
+    { 'g', 'g', 451, -1, 0 }, /* "fem" */
+    { 1, 0, 0, 143, PINYIN_CORRECT_MG_TO_NG }, /* "femg" */
+    { 'g', 'g', 452, 144, 0 }, /* "fen" */
+    { 1, 0, 0, 145, 0 }, /* "feng" */
+    { 'n', 'u', 453, 146, 0 }, /* "fo" */
+    { 'g', 'g', 461, 147, PINYIN_FUZZY_F_H | PINYIN_CORRECT_ON_TO_ONG }, /* "fon" */
+    { 1, 0, 0, 148, PINYIN_FUZZY_F_H }, /* "fong" */
+    { 1, 0, 0, 149, 0 }, /* "fou" */
+    { 'a', 'o', 462, 150, 0 }, /* "fu" */
+    { 'i', 'n', 477, 151, PINYIN_FUZZY_F_H }, /* "fua" */
+    { 1, 0, 0, 152, PINYIN_FUZZY_F_H }, /* "fuai" */
+    { 'g', 'g', 483, 153, PINYIN_FUZZY_F_H }, /* "fuan" */
+    { 1, 0, 0, 154, PINYIN_FUZZY_F_H }, /* "fuang" */
+    { 'i', 'n', 484, -1, 0 }, /* "fue" */
+    { 1, 0, 0, 155, PINYIN_FUZZY_F_H | PINYIN_CORRECT_UEI_TO_UI }, /* "fuei" */
+    { 1, 0, 0, 156, PINYIN_FUZZY_F_H | PINYIN_CORRECT_UEN_TO_UN }, /* "fuen" */
+    { 1, 0, 0, 157, PINYIN_FUZZY_F_H }, /* "fui" */
+    { 1, 0, 0, 158, PINYIN_FUZZY_F_H }, /* "fun" */
+    { 1, 0, 0, 159, PINYIN_FUZZY_F_H }, /* "fuo" */
+    { 'a', 'u', 490, 160, PINYIN_INCOMPLETE_PINYIN }, /* "g" */
+    { 'g', 'o', 511, 161, 0 }, /* "ga" */
+    { 'n', 'n', 520, -1, 0 }, /* "gag" */
+    { 1, 0, 0, 162, PINYIN_CORRECT_GN_TO_NG }, /* "gagn" */
+    { 1, 0, 0, 163, 0 }, /* "gai" */
+    { 'g', 'g', 521, -1, 0 }, /* "gam" */
+    { 1, 0, 0, 164, PINYIN_CORRECT_MG_TO_NG }, /* "gamg" */
+    { 'g', 'g', 522, 165, 0 }, /* "gan" */
+    { 1, 0, 0, 166, 0 }, /* "gang" */
+    { 1, 0, 0, 167, 0 }, /* "gao" */
+    { 'g', 'n', 523, 168, 0 }, /* "ge" */
+    { 'n', 'n', 531, -1, 0 }, /* "geg" */
+    { 1, 0, 0, 169, PINYIN_CORRECT_GN_TO_NG }, /* "gegn" */
+    { 1, 0, 0, 170, 0 }, /* "gei" */
+    { 'g', 'g', 532, -1, 0 }, /* "gem" */
+    { 1, 0, 0, 171, PINYIN_CORRECT_MG_TO_NG }, /* "gemg" */
+    { 'g', 'g', 533, 172, 0 }, /* "gen" */
+    { 1, 0, 0, 173, 0 }, /* "geng" */
+    { 'g', 'u', 534, -1, 0 }, /* "go" */
+    { 'n', 'n', 549, -1, 0 }, /* "gog" */
+    { 1, 0, 0, 174, PINYIN_CORRECT_GN_TO_NG }, /* "gogn" */
+    { 'g', 'g', 550, -1, 0 }, /* "gom" */
+    { 1, 0, 0, 175, PINYIN_CORRECT_MG_TO_NG }, /* "gomg" */
+    { 'g', 'g', 551, 176, PINYIN_CORRECT_ON_TO_ONG }, /* "gon" */
+    { 1, 0, 0, 177, 0 }, /* "gong" */
+    { 1, 0, 0, 178, 0 }, /* "gou" */
+    { 'a', 'o', 552, 179, 0 }, /* "gu" */
+    { 'g', 'n', 567, 180, 0 }, /* "gua" */
+    { 'n', 'n', 575, -1, 0 }, /* "guag" */
+    { 1, 0, 0, 181, PINYIN_CORRECT_GN_TO_NG }, /* "guagn" */
+    { 1, 0, 0, 182, 0 }, /* "guai" */
+    { 'g', 'g', 576, -1, 0 }, /* "guam" */
+    { 1, 0, 0, 183, PINYIN_CORRECT_MG_TO_NG }, /* "guamg" */
+    { 'g', 'g', 577, 184, 0 }, /* "guan" */
+    { 1, 0, 0, 185, 0 }, /* "guang" */
+    { 'i', 'n', 578, -1, 0 }, /* "gue" */
+    { 1, 0, 0, 186, PINYIN_CORRECT_UEI_TO_UI }, /* "guei" */
+    { 1, 0, 0, 187, PINYIN_CORRECT_UEN_TO_UN }, /* "guen" */
+    { 1, 0, 0, 188, 0 }, /* "gui" */
+    { 1, 0, 0, 189, 0 }, /* "gun" */
+    { 1, 0, 0, 190, 0 }, /* "guo" */
+    { 'a', 'u', 584, 191, PINYIN_INCOMPLETE_PINYIN }, /* "h" */
+    { 'g', 'o', 605, 192, 0 }, /* "ha" */
+    { 'n', 'n', 614, -1, 0 }, /* "hag" */
+    { 1, 0, 0, 193, PINYIN_CORRECT_GN_TO_NG }, /* "hagn" */
+    { 1, 0, 0, 194, 0 }, /* "hai" */
+    { 'g', 'g', 615, -1, 0 }, /* "ham" */
+    { 1, 0, 0, 195, PINYIN_CORRECT_MG_TO_NG }, /* "hamg" */
+    { 'g', 'g', 616, 196, 0 }, /* "han" */
+    { 1, 0, 0, 197, 0 }, /* "hang" */
+    { 1, 0, 0, 198, 0 }, /* "hao" */
+    { 'g', 'n', 617, 199, 0 }, /* "he" */
+    { 'n', 'n', 625, -1, 0 }, /* "heg" */
+    { 1, 0, 0, 200, PINYIN_CORRECT_GN_TO_NG }, /* "hegn" */
+    { 1, 0, 0, 201, 0 }, /* "hei" */
+    { 'g', 'g', 626, -1, 0 }, /* "hem" */
+    { 1, 0, 0, 202, PINYIN_CORRECT_MG_TO_NG }, /* "hemg" */
+    { 'g', 'g', 627, 203, 0 }, /* "hen" */
+    { 1, 0, 0, 204, 0 }, /* "heng" */
+    { 'g', 'u', 628, 205, PINYIN_FUZZY_H_F }, /* "ho" */
+    { 'n', 'n', 643, -1, 0 }, /* "hog" */
+    { 1, 0, 0, 206, PINYIN_CORRECT_GN_TO_NG }, /* "hogn" */
+    { 'g', 'g', 644, -1, 0 }, /* "hom" */
+    { 1, 0, 0, 207, PINYIN_CORRECT_MG_TO_NG }, /* "homg" */
+    { 'g', 'g', 645, 208, PINYIN_CORRECT_ON_TO_ONG }, /* "hon" */
+    { 1, 0, 0, 209, 0 }, /* "hong" */
+    { 1, 0, 0, 210, 0 }, /* "hou" */
+    { 'a', 'o', 646, 211, 0 }, /* "hu" */
+    { 'g', 'n', 661, 212, 0 }, /* "hua" */
+    { 'n', 'n', 669, -1, 0 }, /* "huag" */
+    { 1, 0, 0, 213, PINYIN_CORRECT_GN_TO_NG }, /* "huagn" */
+    { 1, 0, 0, 214, 0 }, /* "huai" */
+    { 'g', 'g', 670, -1, 0 }, /* "huam" */
+    { 1, 0, 0, 215, PINYIN_CORRECT_MG_TO_NG }, /* "huamg" */
+    { 'g', 'g', 671, 216, 0 }, /* "huan" */
+    { 1, 0, 0, 217, 0 }, /* "huang" */
+    { 'i', 'n', 672, -1, 0 }, /* "hue" */
+    { 1, 0, 0, 218, PINYIN_CORRECT_UEI_TO_UI }, /* "huei" */
+    { 1, 0, 0, 219, PINYIN_CORRECT_UEN_TO_UN }, /* "huen" */
+    { 1, 0, 0, 220, 0 }, /* "hui" */
+    { 1, 0, 0, 221, 0 }, /* "hun" */
+    { 1, 0, 0, 222, 0 }, /* "huo" */
+    { 'i', 'v', 678, 223, PINYIN_INCOMPLETE_PINYIN }, /* "j" */
+    { 'a', 'u', 692, 224, 0 }, /* "ji" */
+    { 'g', 'o', 713, 225, 0 }, /* "jia" */
+    { 'n', 'n', 722, -1, 0 }, /* "jiag" */
+    { 1, 0, 0, 226, PINYIN_CORRECT_GN_TO_NG }, /* "jiagn" */
+    { 'g', 'g', 723, -1, 0 }, /* "jiam" */
+    { 1, 0, 0, 227, PINYIN_CORRECT_MG_TO_NG }, /* "jiamg" */
+    { 'g', 'g', 724, 228, 0 }, /* "jian" */
+    { 1, 0, 0, 229, 0 }, /* "jiang" */
+    { 1, 0, 0, 230, 0 }, /* "jiao" */
+    { 1, 0, 0, 231, 0 }, /* "jie" */
+    { 'n', 'n', 725, -1, 0 }, /* "jig" */
+    { 1, 0, 0, 232, PINYIN_CORRECT_GN_TO_NG }, /* "jign" */
+    { 'g', 'g', 726, -1, 0 }, /* "jim" */
+    { 1, 0, 0, 233, PINYIN_CORRECT_MG_TO_NG }, /* "jimg" */
+    { 'g', 'g', 727, 234, 0 }, /* "jin" */
+    { 1, 0, 0, 235, 0 }, /* "jing" */
+    { 'g', 'u', 728, -1, 0 }, /* "jio" */
+    { 'n', 'n', 743, -1, 0 }, /* "jiog" */
+    { 1, 0, 0, 236, PINYIN_CORRECT_GN_TO_NG }, /* "jiogn" */
+    { 'g', 'g', 744, -1, 0 }, /* "jiom" */
+    { 1, 0, 0, 237, PINYIN_CORRECT_MG_TO_NG }, /* "jiomg" */
+    { 'g', 'g', 745, 238, PINYIN_CORRECT_ON_TO_ONG }, /* "jion" */
+    { 1, 0, 0, 239, 0 }, /* "jiong" */
+    { 1, 0, 0, 240, PINYIN_CORRECT_IOU_TO_IU }, /* "jiou" */
+    { 1, 0, 0, 241, 0 }, /* "jiu" */
+    { 'a', 'n', 746, 242, 0 }, /* "ju" */
+    { 'n', 'n', 760, -1, 0 }, /* "jua" */
+    { 'g', 'g', 761, 243, 0 }, /* "juan" */
+    { 1, 0, 0, 244, PINYIN_FUZZY_UANG_UAN }, /* "juang" */
+    { 'n', 'n', 762, 245, 0 }, /* "jue" */
+    { 1, 0, 0, 246, PINYIN_CORRECT_UEN_TO_UN }, /* "juen" */
+    { 1, 0, 0, 247, 0 }, /* "jun" */
+    { 'a', 'n', 763, 248, PINYIN_CORRECT_V_TO_U }, /* "jv" */
+    { 'n', 'n', 777, -1, 0 }, /* "jva" */
+    { 'g', 'g', 778, 249, PINYIN_CORRECT_V_TO_U }, /* "jvan" */
+    { 1, 0, 0, 250, PINYIN_FUZZY_UANG_UAN | PINYIN_CORRECT_V_TO_U }, /* "jvang" */
+    { 'n', 'n', 779, 251, PINYIN_CORRECT_V_TO_U }, /* "jve" */
+    { 1, 0, 0, 252, PINYIN_CORRECT_UEN_TO_UN | PINYIN_CORRECT_V_TO_U }, /* "jven" */
+    { 1, 0, 0, 253, PINYIN_CORRECT_V_TO_U }, /* "jvn" */
+    { 'a', 'u', 780, 254, PINYIN_INCOMPLETE_PINYIN }, /* "k" */
+    { 'g', 'o', 801, 255, 0 }, /* "ka" */
+    { 'n', 'n', 810, -1, 0 }, /* "kag" */
+    { 1, 0, 0, 256, PINYIN_CORRECT_GN_TO_NG }, /* "kagn" */
+    { 1, 0, 0, 257, 0 }, /* "kai" */
+    { 'g', 'g', 811, -1, 0 }, /* "kam" */
+    { 1, 0, 0, 258, PINYIN_CORRECT_MG_TO_NG }, /* "kamg" */
+    { 'g', 'g', 812, 259, 0 }, /* "kan" */
+    { 1, 0, 0, 260, 0 }, /* "kang" */
+    { 1, 0, 0, 261, 0 }, /* "kao" */
+    { 'g', 'n', 813, 262, 0 }, /* "ke" */
+    { 'n', 'n', 821, -1, 0 }, /* "keg" */
+    { 1, 0, 0, 263, PINYIN_CORRECT_GN_TO_NG }, /* "kegn" */
+    { 1, 0, 0, 264, PINYIN_FUZZY_K_G }, /* "kei" */
+    { 'g', 'g', 822, -1, 0 }, /* "kem" */
+    { 1, 0, 0, 265, PINYIN_CORRECT_MG_TO_NG }, /* "kemg" */
+    { 'g', 'g', 823, 266, 0 }, /* "ken" */
+    { 1, 0, 0, 267, 0 }, /* "keng" */
+    { 'g', 'u', 824, -1, 0 }, /* "ko" */
+    { 'n', 'n', 839, -1, 0 }, /* "kog" */
+    { 1, 0, 0, 268, PINYIN_CORRECT_GN_TO_NG }, /* "kogn" */
+    { 'g', 'g', 840, -1, 0 }, /* "kom" */
+    { 1, 0, 0, 269, PINYIN_CORRECT_MG_TO_NG }, /* "komg" */
+    { 'g', 'g', 841, 270, PINYIN_CORRECT_ON_TO_ONG }, /* "kon" */
+    { 1, 0, 0, 271, 0 }, /* "kong" */
+    { 1, 0, 0, 272, 0 }, /* "kou" */
+    { 'a', 'o', 842, 273, 0 }, /* "ku" */
+    { 'g', 'n', 857, 274, 0 }, /* "kua" */
+    { 'n', 'n', 865, -1, 0 }, /* "kuag" */
+    { 1, 0, 0, 275, PINYIN_CORRECT_GN_TO_NG }, /* "kuagn" */
+    { 1, 0, 0, 276, 0 }, /* "kuai" */
+    { 'g', 'g', 866, -1, 0 }, /* "kuam" */
+    { 1, 0, 0, 277, PINYIN_CORRECT_MG_TO_NG }, /* "kuamg" */
+    { 'g', 'g', 867, 278, 0 }, /* "kuan" */
+    { 1, 0, 0, 279, 0 }, /* "kuang" */
+    { 'i', 'n', 868, -1, 0 }, /* "kue" */
+    { 1, 0, 0, 280, PINYIN_CORRECT_UEI_TO_UI }, /* "kuei" */
+    { 1, 0, 0, 281, PINYIN_CORRECT_UEN_TO_UN }, /* "kuen" */
+    { 1, 0, 0, 282, 0 }, /* "kui" */
+    { 1, 0, 0, 283, 0 }, /* "kun" */
+    { 1, 0, 0, 284, 0 }, /* "kuo" */
+    { 'a', 'v', 874, 285, PINYIN_INCOMPLETE_PINYIN }, /* "l" */
+    { 'g', 'o', 896, 286, 0 }, /* "la" */
+    { 'n', 'n', 905, -1, 0 }, /* "lag" */
+    { 1, 0, 0, 287, PINYIN_CORRECT_GN_TO_NG }, /* "lagn" */
+    { 1, 0, 0, 288, 0 }, /* "lai" */
+    { 'g', 'g', 906, -1, 0 }, /* "lam" */
+    { 1, 0, 0, 289, PINYIN_CORRECT_MG_TO_NG }, /* "lamg" */
+    { 'g', 'g', 907, 290, 0 }, /* "lan" */
+    { 1, 0, 0, 291, 0 }, /* "lang" */
+    { 1, 0, 0, 292, 0 }, /* "lao" */
+    { 'g', 'n', 908, 293, 0 }, /* "le" */
+    { 'n', 'n', 916, -1, 0 }, /* "leg" */
+    { 1, 0, 0, 294, PINYIN_CORRECT_GN_TO_NG }, /* "legn" */
+    { 1, 0, 0, 295, 0 }, /* "lei" */
+    { 'g', 'g', 917, -1, 0 }, /* "lem" */
+    { 1, 0, 0, 296, PINYIN_CORRECT_MG_TO_NG }, /* "lemg" */
+    { 'g', 'g', 918, 297, PINYIN_FUZZY_L_N | PINYIN_FUZZY_L_R | PINYIN_FUZZY_EN_ENG }, /* "len" */
+    { 1, 0, 0, 298, 0 }, /* "leng" */
+    { 'a', 'u', 919, 299, 0 }, /* "li" */
+    { 'g', 'o', 940, 300, 0 }, /* "lia" */
+    { 'n', 'n', 949, -1, 0 }, /* "liag" */
+    { 1, 0, 0, 301, PINYIN_CORRECT_GN_TO_NG }, /* "liagn" */
+    { 'g', 'g', 950, -1, 0 }, /* "liam" */
+    { 1, 0, 0, 302, PINYIN_CORRECT_MG_TO_NG }, /* "liamg" */
+    { 'g', 'g', 951, 303, 0 }, /* "lian" */
+    { 1, 0, 0, 304, 0 }, /* "liang" */
+    { 1, 0, 0, 305, 0 }, /* "liao" */
+    { 1, 0, 0, 306, 0 }, /* "lie" */
+    { 'n', 'n', 952, -1, 0 }, /* "lig" */
+    { 1, 0, 0, 307, PINYIN_CORRECT_GN_TO_NG }, /* "lign" */
+    { 'g', 'g', 953, -1, 0 }, /* "lim" */
+    { 1, 0, 0, 308, PINYIN_CORRECT_MG_TO_NG }, /* "limg" */
+    { 'g', 'g', 954, 309, 0 }, /* "lin" */
+    { 1, 0, 0, 310, 0 }, /* "ling" */
+    { 'u', 'u', 955, -1, 0 }, /* "lio" */
+    { 1, 0, 0, 311, PINYIN_CORRECT_IOU_TO_IU }, /* "liou" */
+    { 1, 0, 0, 312, 0 }, /* "liu" */
+    { 'g', 'u', 956, 313, 0 }, /* "lo" */
+    { 'n', 'n', 971, -1, 0 }, /* "log" */
+    { 1, 0, 0, 314, PINYIN_CORRECT_GN_TO_NG }, /* "logn" */
+    { 'g', 'g', 972, -1, 0 }, /* "lom" */
+    { 1, 0, 0, 315, PINYIN_CORRECT_MG_TO_NG }, /* "lomg" */
+    { 'g', 'g', 973, 316, PINYIN_CORRECT_ON_TO_ONG }, /* "lon" */
+    { 1, 0, 0, 317, 0 }, /* "long" */
+    { 1, 0, 0, 318, 0 }, /* "lou" */
+    { 'a', 'o', 974, 319, 0 }, /* "lu" */
+    { 'n', 'n', 989, -1, 0 }, /* "lua" */
+    { 'g', 'g', 990, 320, 0 }, /* "luan" */
+    { 1, 0, 0, 321, PINYIN_FUZZY_UANG_UAN }, /* "luang" */
+    { 'i', 'n', 991, 322, PINYIN_CORRECT_UE_TO_VE }, /* "lue" */
+    { 1, 0, 0, 323, PINYIN_FUZZY_L_R | PINYIN_CORRECT_UEI_TO_UI }, /* "luei" */
+    { 1, 0, 0, 324, PINYIN_CORRECT_UEN_TO_UN }, /* "luen" */
+    { 1, 0, 0, 325, PINYIN_FUZZY_L_R }, /* "lui" */
+    { 1, 0, 0, 326, 0 }, /* "lun" */
+    { 1, 0, 0, 327, 0 }, /* "luo" */
+    { 'e', 'e', 997, 328, 0 }, /* "lv" */
+    { 1, 0, 0, 329, 0 }, /* "lve" */
+    { 'a', 'u', 998, 330, PINYIN_INCOMPLETE_PINYIN }, /* "m" */
+    { 'g', 'o', 1019, 331, 0 }, /* "ma" */
+    { 'n', 'n', 1028, -1, 0 }, /* "mag" */
+    { 1, 0, 0, 332, PINYIN_CORRECT_GN_TO_NG }, /* "magn" */
+    { 1, 0, 0, 333, 0 }, /* "mai" */
+    { 'g', 'g', 1029, -1, 0 }, /* "mam" */
+    { 1, 0, 0, 334, PINYIN_CORRECT_MG_TO_NG }, /* "mamg" */
+    { 'g', 'g', 1030, 335, 0 }, /* "man" */
+    { 1, 0, 0, 336, 0 }, /* "mang" */
+    { 1, 0, 0, 337, 0 }, /* "mao" */
+    { 'g', 'n', 1031, 338, 0 }, /* "me" */
+    { 'n', 'n', 1039, -1, 0 }, /* "meg" */
+    { 1, 0, 0, 339, PINYIN_CORRECT_GN_TO_NG }, /* "megn" */
+    { 1, 0, 0, 340, 0 }, /* "mei" */
+    { 'g', 'g', 1040, -1, 0 }, /* "mem" */
+    { 1, 0, 0, 341, PINYIN_CORRECT_MG_TO_NG }, /* "memg" */
+    { 'g', 'g', 1041, 342, 0 }, /* "men" */
+    { 1, 0, 0, 343, 0 }, /* "meng" */
+    { 'a', 'u', 1042, 344, 0 }, /* "mi" */
+    { 'n', 'o', 1063, -1, 0 }, /* "mia" */
+    { 'g', 'g', 1065, 345, 0 }, /* "mian" */
+    { 1, 0, 0, 346, PINYIN_FUZZY_IANG_IAN }, /* "miang" */
+    { 1, 0, 0, 347, 0 }, /* "miao" */
+    { 1, 0, 0, 348, 0 }, /* "mie" */
+    { 'n', 'n', 1066, -1, 0 }, /* "mig" */
+    { 1, 0, 0, 349, PINYIN_CORRECT_GN_TO_NG }, /* "mign" */
+    { 'g', 'g', 1067, -1, 0 }, /* "mim" */
+    { 1, 0, 0, 350, PINYIN_CORRECT_MG_TO_NG }, /* "mimg" */
+    { 'g', 'g', 1068, 351, 0 }, /* "min" */
+    { 1, 0, 0, 352, 0 }, /* "ming" */
+    { 'u', 'u', 1069, -1, 0 }, /* "mio" */
+    { 1, 0, 0, 353, PINYIN_CORRECT_IOU_TO_IU }, /* "miou" */
+    { 1, 0, 0, 354, 0 }, /* "miu" */
+    { 'u', 'u', 1070, 355, 0 }, /* "mo" */
+    { 1, 0, 0, 356, 0 }, /* "mou" */
+    { 1, 0, 0, 357, 0 }, /* "mu" */
+    { 'a', 'v', 1071, 358, PINYIN_INCOMPLETE_PINYIN }, /* "n" */
+    { 'g', 'o', 1093, 359, 0 }, /* "na" */
+    { 'n', 'n', 1102, -1, 0 }, /* "nag" */
+    { 1, 0, 0, 360, PINYIN_CORRECT_GN_TO_NG }, /* "nagn" */
+    { 1, 0, 0, 361, 0 }, /* "nai" */
+    { 'g', 'g', 1103, -1, 0 }, /* "nam" */
+    { 1, 0, 0, 362, PINYIN_CORRECT_MG_TO_NG }, /* "namg" */
+    { 'g', 'g', 1104, 363, 0 }, /* "nan" */
+    { 1, 0, 0, 364, 0 }, /* "nang" */
+    { 1, 0, 0, 365, 0 }, /* "nao" */
+    { 'g', 'n', 1105, 366, 0 }, /* "ne" */
+    { 'n', 'n', 1113, -1, 0 }, /* "neg" */
+    { 1, 0, 0, 367, PINYIN_CORRECT_GN_TO_NG }, /* "negn" */
+    { 1, 0, 0, 368, 0 }, /* "nei" */
+    { 'g', 'g', 1114, -1, 0 }, /* "nem" */
+    { 1, 0, 0, 369, PINYIN_CORRECT_MG_TO_NG }, /* "nemg" */
+    { 'g', 'g', 1115, 370, 0 }, /* "nen" */
+    { 1, 0, 0, 371, 0 }, /* "neng" */
+    { 'a', 'u', 1116, 372, 0 }, /* "ni" */
+    { 'g', 'o', 1137, 373, PINYIN_FUZZY_N_L }, /* "nia" */
+    { 'n', 'n', 1146, -1, 0 }, /* "niag" */
+    { 1, 0, 0, 374, PINYIN_CORRECT_GN_TO_NG }, /* "niagn" */
+    { 'g', 'g', 1147, -1, 0 }, /* "niam" */
+    { 1, 0, 0, 375, PINYIN_CORRECT_MG_TO_NG }, /* "niamg" */
+    { 'g', 'g', 1148, 376, 0 }, /* "nian" */
+    { 1, 0, 0, 377, 0 }, /* "niang" */
+    { 1, 0, 0, 378, 0 }, /* "niao" */
+    { 1, 0, 0, 379, 0 }, /* "nie" */
+    { 'n', 'n', 1149, -1, 0 }, /* "nig" */
+    { 1, 0, 0, 380, PINYIN_CORRECT_GN_TO_NG }, /* "nign" */
+    { 'g', 'g', 1150, -1, 0 }, /* "nim" */
+    { 1, 0, 0, 381, PINYIN_CORRECT_MG_TO_NG }, /* "nimg" */
+    { 'g', 'g', 1151, 382, 0 }, /* "nin" */
+    { 1, 0, 0, 383, 0 }, /* "ning" */
+    { 'u', 'u', 1152, -1, 0 }, /* "nio" */
+    { 1, 0, 0, 384, PINYIN_CORRECT_IOU_TO_IU }, /* "niou" */
+    { 1, 0, 0, 385, 0 }, /* "niu" */
+    { 'g', 'u', 1153, 386, PINYIN_FUZZY_N_L }, /* "no" */
+    { 'n', 'n', 1168, -1, 0 }, /* "nog" */
+    { 1, 0, 0, 387, PINYIN_CORRECT_GN_TO_NG }, /* "nogn" */
+    { 'g', 'g', 1169, -1, 0 }, /* "nom" */
+    { 1, 0, 0, 388, PINYIN_CORRECT_MG_TO_NG }, /* "nomg" */
+    { 'g', 'g', 1170, 389, PINYIN_CORRECT_ON_TO_ONG }, /* "non" */
+    { 1, 0, 0, 390, 0 }, /* "nong" */
+    { 1, 0, 0, 391, 0 }, /* "nou" */
+    { 'a', 'o', 1171, 392, 0 }, /* "nu" */
+    { 'n', 'n', 1186, -1, 0 }, /* "nua" */
+    { 'g', 'g', 1187, 393, 0 }, /* "nuan" */
+    { 1, 0, 0, 394, PINYIN_FUZZY_UANG_UAN }, /* "nuang" */
+    { 'n', 'n', 1188, 395, PINYIN_CORRECT_UE_TO_VE }, /* "nue" */
+    { 1, 0, 0, 396, PINYIN_FUZZY_N_L | PINYIN_CORRECT_UEN_TO_UN }, /* "nuen" */
+    { 1, 0, 0, 397, PINYIN_FUZZY_N_L }, /* "nun" */
+    { 1, 0, 0, 398, 0 }, /* "nuo" */
+    { 'e', 'e', 1189, 399, 0 }, /* "nv" */
+    { 1, 0, 0, 400, 0 }, /* "nve" */
+    { 'u', 'u', 1190, 401, 0 }, /* "o" */
+    { 1, 0, 0, 402, 0 }, /* "ou" */
+    { 'a', 'u', 1191, 403, PINYIN_INCOMPLETE_PINYIN }, /* "p" */
+    { 'g', 'o', 1212, 404, 0 }, /* "pa" */
+    { 'n', 'n', 1221, -1, 0 }, /* "pag" */
+    { 1, 0, 0, 405, PINYIN_CORRECT_GN_TO_NG }, /* "pagn" */
+    { 1, 0, 0, 406, 0 }, /* "pai" */
+    { 'g', 'g', 1222, -1, 0 }, /* "pam" */
+    { 1, 0, 0, 407, PINYIN_CORRECT_MG_TO_NG }, /* "pamg" */
+    { 'g', 'g', 1223, 408, 0 }, /* "pan" */
+    { 1, 0, 0, 409, 0 }, /* "pang" */
+    { 1, 0, 0, 410, 0 }, /* "pao" */
+    { 'g', 'n', 1224, -1, 0 }, /* "pe" */
+    { 'n', 'n', 1232, -1, 0 }, /* "peg" */
+    { 1, 0, 0, 411, PINYIN_CORRECT_GN_TO_NG }, /* "pegn" */
+    { 1, 0, 0, 412, 0 }, /* "pei" */
+    { 'g', 'g', 1233, -1, 0 }, /* "pem" */
+    { 1, 0, 0, 413, PINYIN_CORRECT_MG_TO_NG }, /* "pemg" */
+    { 'g', 'g', 1234, 414, 0 }, /* "pen" */
+    { 1, 0, 0, 415, 0 }, /* "peng" */
+    { 'a', 'n', 1235, 416, 0 }, /* "pi" */
+    { 'n', 'o', 1249, -1, 0 }, /* "pia" */
+    { 'g', 'g', 1251, 417, 0 }, /* "pian" */
+    { 1, 0, 0, 418, PINYIN_FUZZY_IANG_IAN }, /* "piang" */
+    { 1, 0, 0, 419, 0 }, /* "piao" */
+    { 1, 0, 0, 420, 0 }, /* "pie" */
+    { 'n', 'n', 1252, -1, 0 }, /* "pig" */
+    { 1, 0, 0, 421, PINYIN_CORRECT_GN_TO_NG }, /* "pign" */
+    { 'g', 'g', 1253, -1, 0 }, /* "pim" */
+    { 1, 0, 0, 422, PINYIN_CORRECT_MG_TO_NG }, /* "pimg" */
+    { 'g', 'g', 1254, 423, 0 }, /* "pin" */
+    { 1, 0, 0, 424, 0 }, /* "ping" */
+    { 'u', 'u', 1255, 425, 0 }, /* "po" */
+    { 1, 0, 0, 426, 0 }, /* "pou" */
+    { 1, 0, 0, 427, 0 }, /* "pu" */
+    { 'i', 'v', 1256, 428, PINYIN_INCOMPLETE_PINYIN }, /* "q" */
+    { 'a', 'u', 1270, 429, 0 }, /* "qi" */
+    { 'g', 'o', 1291, 430, 0 }, /* "qia" */
+    { 'n', 'n', 1300, -1, 0 }, /* "qiag" */
+    { 1, 0, 0, 431, PINYIN_CORRECT_GN_TO_NG }, /* "qiagn" */
+    { 'g', 'g', 1301, -1, 0 }, /* "qiam" */
+    { 1, 0, 0, 432, PINYIN_CORRECT_MG_TO_NG }, /* "qiamg" */
+    { 'g', 'g', 1302, 433, 0 }, /* "qian" */
+    { 1, 0, 0, 434, 0 }, /* "qiang" */
+    { 1, 0, 0, 435, 0 }, /* "qiao" */
+    { 1, 0, 0, 436, 0 }, /* "qie" */
+    { 'n', 'n', 1303, -1, 0 }, /* "qig" */
+    { 1, 0, 0, 437, PINYIN_CORRECT_GN_TO_NG }, /* "qign" */
+    { 'g', 'g', 1304, -1, 0 }, /* "qim" */
+    { 1, 0, 0, 438, PINYIN_CORRECT_MG_TO_NG }, /* "qimg" */
+    { 'g', 'g', 1305, 439, 0 }, /* "qin" */
+    { 1, 0, 0, 440, 0 }, /* "qing" */
+    { 'g', 'u', 1306, -1, 0 }, /* "qio" */
+    { 'n', 'n', 1321, -1, 0 }, /* "qiog" */
+    { 1, 0, 0, 441, PINYIN_CORRECT_GN_TO_NG }, /* "qiogn" */
+    { 'g', 'g', 1322, -1, 0 }, /* "qiom" */
+    { 1, 0, 0, 442, PINYIN_CORRECT_MG_TO_NG }, /* "qiomg" */
+    { 'g', 'g', 1323, 443, PINYIN_CORRECT_ON_TO_ONG }, /* "qion" */
+    { 1, 0, 0, 444, 0 }, /* "qiong" */
+    { 1, 0, 0, 445, PINYIN_CORRECT_IOU_TO_IU }, /* "qiou" */
+    { 1, 0, 0, 446, 0 }, /* "qiu" */
+    { 'a', 'n', 1324, 447, 0 }, /* "qu" */
+    { 'n', 'n', 1338, -1, 0 }, /* "qua" */
+    { 'g', 'g', 1339, 448, 0 }, /* "quan" */
+    { 1, 0, 0, 449, PINYIN_FUZZY_UANG_UAN }, /* "quang" */
+    { 'n', 'n', 1340, 450, 0 }, /* "que" */
+    { 1, 0, 0, 451, PINYIN_CORRECT_UEN_TO_UN }, /* "quen" */
+    { 1, 0, 0, 452, 0 }, /* "qun" */
+    { 'a', 'n', 1341, 453, PINYIN_CORRECT_V_TO_U }, /* "qv" */
+    { 'n', 'n', 1355, -1, 0 }, /* "qva" */
+    { 'g', 'g', 1356, 454, PINYIN_CORRECT_V_TO_U }, /* "qvan" */
+    { 1, 0, 0, 455, PINYIN_FUZZY_UANG_UAN | PINYIN_CORRECT_V_TO_U }, /* "qvang" */
+    { 'n', 'n', 1357, 456, PINYIN_CORRECT_V_TO_U }, /* "qve" */
+    { 1, 0, 0, 457, PINYIN_CORRECT_UEN_TO_UN | PINYIN_CORRECT_V_TO_U }, /* "qven" */
+    { 1, 0, 0, 458, PINYIN_CORRECT_V_TO_U }, /* "qvn" */
+    { 'a', 'v', 1358, 459, PINYIN_INCOMPLETE_PINYIN }, /* "r" */
+    { 'g', 'o', 1380, 460, PINYIN_FUZZY_R_L }, /* "ra" */
+    { 'n', 'n', 1389, -1, 0 }, /* "rag" */
+    { 1, 0, 0, 461, PINYIN_CORRECT_GN_TO_NG }, /* "ragn" */
+    { 1, 0, 0, 462, PINYIN_FUZZY_R_L }, /* "rai" */
+    { 'g', 'g', 1390, -1, 0 }, /* "ram" */
+    { 1, 0, 0, 463, PINYIN_CORRECT_MG_TO_NG }, /* "ramg" */
+    { 'g', 'g', 1391, 464, 0 }, /* "ran" */
+    { 1, 0, 0, 465, 0 }, /* "rang" */
+    { 1, 0, 0, 466, 0 }, /* "rao" */
+    { 'g', 'n', 1392, 467, 0 }, /* "re" */
+    { 'n', 'n', 1400, -1, 0 }, /* "reg" */
+    { 1, 0, 0, 468, PINYIN_CORRECT_GN_TO_NG }, /* "regn" */
+    { 1, 0, 0, 469, PINYIN_FUZZY_R_L }, /* "rei" */
+    { 'g', 'g', 1401, -1, 0 }, /* "rem" */
+    { 1, 0, 0, 470, PINYIN_CORRECT_MG_TO_NG }, /* "remg" */
+    { 'g', 'g', 1402, 471, 0 }, /* "ren" */
+    { 1, 0, 0, 472, 0 }, /* "reng" */
+    { 'a', 'u', 1403, 473, 0 }, /* "ri" */
+    { 'n', 'o', 1424, 474, PINYIN_FUZZY_R_L }, /* "ria" */
+    { 'g', 'g', 1426, 475, PINYIN_FUZZY_R_L }, /* "rian" */
+    { 1, 0, 0, 476, PINYIN_FUZZY_R_L }, /* "riang" */
+    { 1, 0, 0, 477, PINYIN_FUZZY_R_L }, /* "riao" */
+    { 1, 0, 0, 478, PINYIN_FUZZY_R_L }, /* "rie" */
+    { 'g', 'g', 1427, 479, PINYIN_FUZZY_R_L }, /* "rin" */
+    { 1, 0, 0, 480, PINYIN_FUZZY_R_L }, /* "ring" */
+    { 'u', 'u', 1428, -1, 0 }, /* "rio" */
+    { 1, 0, 0, 481, PINYIN_FUZZY_R_L | PINYIN_CORRECT_IOU_TO_IU }, /* "riou" */
+    { 1, 0, 0, 482, PINYIN_FUZZY_R_L }, /* "riu" */
+    { 'g', 'u', 1429, 483, PINYIN_FUZZY_R_L }, /* "ro" */
+    { 'n', 'n', 1444, -1, 0 }, /* "rog" */
+    { 1, 0, 0, 484, PINYIN_CORRECT_GN_TO_NG }, /* "rogn" */
+    { 'g', 'g', 1445, -1, 0 }, /* "rom" */
+    { 1, 0, 0, 485, PINYIN_CORRECT_MG_TO_NG }, /* "romg" */
+    { 'g', 'g', 1446, 486, PINYIN_CORRECT_ON_TO_ONG }, /* "ron" */
+    { 1, 0, 0, 487, 0 }, /* "rong" */
+    { 1, 0, 0, 488, 0 }, /* "rou" */
+    { 'a', 'o', 1447, 489, 0 }, /* "ru" */
+    { 'n', 'n', 1462, -1, 0 }, /* "rua" */
+    { 'g', 'g', 1463, 490, 0 }, /* "ruan" */
+    { 1, 0, 0, 491, PINYIN_FUZZY_UANG_UAN }, /* "ruang" */
+    { 'i', 'n', 1464, 492, PINYIN_FUZZY_R_L | PINYIN_CORRECT_UE_TO_VE }, /* "rue" */
+    { 1, 0, 0, 493, PINYIN_CORRECT_UEI_TO_UI }, /* "ruei" */
+    { 1, 0, 0, 494, PINYIN_CORRECT_UEN_TO_UN }, /* "ruen" */
+    { 1, 0, 0, 495, 0 }, /* "rui" */
+    { 1, 0, 0, 496, 0 }, /* "run" */
+    { 1, 0, 0, 497, 0 }, /* "ruo" */
+    { 'e', 'e', 1470, 498, PINYIN_FUZZY_R_L }, /* "rv" */
+    { 1, 0, 0, 499, PINYIN_FUZZY_R_L }, /* "rve" */
+    { 'a', 'u', 1471, 500, PINYIN_INCOMPLETE_PINYIN }, /* "s" */
+    { 'g', 'o', 1492, 501, 0 }, /* "sa" */
+    { 'n', 'n', 1501, -1, 0 }, /* "sag" */
+    { 1, 0, 0, 502, PINYIN_CORRECT_GN_TO_NG }, /* "sagn" */
+    { 1, 0, 0, 503, 0 }, /* "sai" */
+    { 'g', 'g', 1502, -1, 0 }, /* "sam" */
+    { 1, 0, 0, 504, PINYIN_CORRECT_MG_TO_NG }, /* "samg" */
+    { 'g', 'g', 1503, 505, 0 }, /* "san" */
+    { 1, 0, 0, 506, 0 }, /* "sang" */
+    { 1, 0, 0, 507, 0 }, /* "sao" */
+    { 'g', 'n', 1504, 508, 0 }, /* "se" */
+    { 'n', 'n', 1512, -1, 0 }, /* "seg" */
+    { 1, 0, 0, 509, PINYIN_CORRECT_GN_TO_NG }, /* "segn" */
+    { 1, 0, 0, 510, PINYIN_FUZZY_S_SH }, /* "sei" */
+    { 'g', 'g', 1513, -1, 0 }, /* "sem" */
+    { 1, 0, 0, 511, PINYIN_CORRECT_MG_TO_NG }, /* "semg" */
+    { 'g', 'g', 1514, 512, 0 }, /* "sen" */
+    { 1, 0, 0, 513, 0 }, /* "seng" */
+    { 'a', 'u', 1515, 514, PINYIN_INCOMPLETE_PINYIN }, /* "sh" */
+    { 'g', 'o', 1536, 515, 0 }, /* "sha" */
+    { 'n', 'n', 1545, -1, 0 }, /* "shag" */
+    { 1, 0, 0, 516, PINYIN_CORRECT_GN_TO_NG }, /* "shagn" */
+    { 1, 0, 0, 517, 0 }, /* "shai" */
+    { 'g', 'g', 1546, -1, 0 }, /* "sham" */
+    { 1, 0, 0, 518, PINYIN_CORRECT_MG_TO_NG }, /* "shamg" */
+    { 'g', 'g', 1547, 519, 0 }, /* "shan" */
+    { 1, 0, 0, 520, 0 }, /* "shang" */
+    { 1, 0, 0, 521, 0 }, /* "shao" */
+    { 'g', 'n', 1548, 522, 0 }, /* "she" */
+    { 'n', 'n', 1556, -1, 0 }, /* "sheg" */
+    { 1, 0, 0, 523, PINYIN_CORRECT_GN_TO_NG }, /* "shegn" */
+    { 1, 0, 0, 524, 0 }, /* "shei" */
+    { 'g', 'g', 1557, -1, 0 }, /* "shem" */
+    { 1, 0, 0, 525, PINYIN_CORRECT_MG_TO_NG }, /* "shemg" */
+    { 'g', 'g', 1558, 526, 0 }, /* "shen" */
+    { 1, 0, 0, 527, 0 }, /* "sheng" */
+    { 1, 0, 0, 528, 0 }, /* "shi" */
+    { 'n', 'u', 1559, -1, 0 }, /* "sho" */
+    { 'g', 'g', 1567, 529, PINYIN_FUZZY_SH_S | PINYIN_CORRECT_ON_TO_ONG }, /* "shon" */
+    { 1, 0, 0, 530, PINYIN_FUZZY_SH_S }, /* "shong" */
+    { 1, 0, 0, 531, 0 }, /* "shou" */
+    { 'a', 'o', 1568, 532, 0 }, /* "shu" */
+    { 'g', 'n', 1583, 533, 0 }, /* "shua" */
+    { 'n', 'n', 1591, -1, 0 }, /* "shuag" */
+    { 1, 0, 0, 534, PINYIN_CORRECT_GN_TO_NG }, /* "shuagn" */
+    { 1, 0, 0, 535, 0 }, /* "shuai" */
+    { 'g', 'g', 1592, -1, 0 }, /* "shuam" */
+    { 1, 0, 0, 536, PINYIN_CORRECT_MG_TO_NG }, /* "shuamg" */
+    { 'g', 'g', 1593, 537, 0 }, /* "shuan" */
+    { 1, 0, 0, 538, 0 }, /* "shuang" */
+    { 'i', 'n', 1594, -1, 0 }, /* "shue" */
+    { 1, 0, 0, 539, PINYIN_CORRECT_UEI_TO_UI }, /* "shuei" */
+    { 1, 0, 0, 540, PINYIN_CORRECT_UEN_TO_UN }, /* "shuen" */
+    { 1, 0, 0, 541, 0 }, /* "shui" */
+    { 1, 0, 0, 542, 0 }, /* "shun" */
+    { 1, 0, 0, 543, 0 }, /* "shuo" */
+    { 1, 0, 0, 544, 0 }, /* "si" */
+    { 'g', 'u', 1600, -1, 0 }, /* "so" */
+    { 'n', 'n', 1615, -1, 0 }, /* "sog" */
+    { 1, 0, 0, 545, PINYIN_CORRECT_GN_TO_NG }, /* "sogn" */
+    { 'g', 'g', 1616, -1, 0 }, /* "som" */
+    { 1, 0, 0, 546, PINYIN_CORRECT_MG_TO_NG }, /* "somg" */
+    { 'g', 'g', 1617, 547, PINYIN_CORRECT_ON_TO_ONG }, /* "son" */
+    { 1, 0, 0, 548, 0 }, /* "song" */
+    { 1, 0, 0, 549, 0 }, /* "sou" */
+    { 'a', 'o', 1618, 550, 0 }, /* "su" */
+    { 'i', 'n', 1633, 551, PINYIN_FUZZY_S_SH }, /* "sua" */
+    { 1, 0, 0, 552, PINYIN_FUZZY_S_SH }, /* "suai" */
+    { 'g', 'g', 1639, 553, 0 }, /* "suan" */
+    { 1, 0, 0, 554, PINYIN_FUZZY_S_SH | PINYIN_FUZZY_UANG_UAN }, /* "suang" */
+    { 'i', 'n', 1640, -1, 0 }, /* "sue" */
+    { 1, 0, 0, 555, PINYIN_CORRECT_UEI_TO_UI }, /* "suei" */
+    { 1, 0, 0, 556, PINYIN_CORRECT_UEN_TO_UN }, /* "suen" */
+    { 1, 0, 0, 557, 0 }, /* "sui" */
+    { 1, 0, 0, 558, 0 }, /* "sun" */
+    { 1, 0, 0, 559, 0 }, /* "suo" */
+    { 'a', 'u', 1646, 560, PINYIN_INCOMPLETE_PINYIN }, /* "t" */
+    { 'g', 'o', 1667, 561, 0 }, /* "ta" */
+    { 'n', 'n', 1676, -1, 0 }, /* "tag" */
+    { 1, 0, 0, 562, PINYIN_CORRECT_GN_TO_NG }, /* "tagn" */
+    { 1, 0, 0, 563, 0 }, /* "tai" */
+    { 'g', 'g', 1677, -1, 0 }, /* "tam" */
+    { 1, 0, 0, 564, PINYIN_CORRECT_MG_TO_NG }, /* "tamg" */
+    { 'g', 'g', 1678, 565, 0 }, /* "tan" */
+    { 1, 0, 0, 566, 0 }, /* "tang" */
+    { 1, 0, 0, 567, 0 }, /* "tao" */
+    { 'g', 'n', 1679, 568, 0 }, /* "te" */
+    { 'n', 'n', 1687, -1, 0 }, /* "teg" */
+    { 1, 0, 0, 569, PINYIN_CORRECT_GN_TO_NG }, /* "tegn" */
+    { 'g', 'g', 1688, -1, 0 }, /* "tem" */
+    { 1, 0, 0, 570, PINYIN_CORRECT_MG_TO_NG }, /* "temg" */
+    { 'g', 'g', 1689, 571, PINYIN_FUZZY_EN_ENG }, /* "ten" */
+    { 1, 0, 0, 572, 0 }, /* "teng" */
+    { 'a', 'n', 1690, 573, 0 }, /* "ti" */
+    { 'n', 'o', 1704, -1, 0 }, /* "tia" */
+    { 'g', 'g', 1706, 574, 0 }, /* "tian" */
+    { 1, 0, 0, 575, PINYIN_FUZZY_IANG_IAN }, /* "tiang" */
+    { 1, 0, 0, 576, 0 }, /* "tiao" */
+    { 1, 0, 0, 577, 0 }, /* "tie" */
+    { 'n', 'n', 1707, -1, 0 }, /* "tig" */
+    { 1, 0, 0, 578, PINYIN_CORRECT_GN_TO_NG }, /* "tign" */
+    { 'g', 'g', 1708, -1, 0 }, /* "tim" */
+    { 1, 0, 0, 579, PINYIN_CORRECT_MG_TO_NG }, /* "timg" */
+    { 'g', 'g', 1709, 580, PINYIN_FUZZY_IN_ING }, /* "tin" */
+    { 1, 0, 0, 581, 0 }, /* "ting" */
+    { 'g', 'u', 1710, -1, 0 }, /* "to" */
+    { 'n', 'n', 1725, -1, 0 }, /* "tog" */
+    { 1, 0, 0, 582, PINYIN_CORRECT_GN_TO_NG }, /* "togn" */
+    { 'g', 'g', 1726, -1, 0 }, /* "tom" */
+    { 1, 0, 0, 583, PINYIN_CORRECT_MG_TO_NG }, /* "tomg" */
+    { 'g', 'g', 1727, 584, PINYIN_CORRECT_ON_TO_ONG }, /* "ton" */
+    { 1, 0, 0, 585, 0 }, /* "tong" */
+    { 1, 0, 0, 586, 0 }, /* "tou" */
+    { 'a', 'o', 1728, 587, 0 }, /* "tu" */
+    { 'n', 'n', 1743, -1, 0 }, /* "tua" */
+    { 'g', 'g', 1744, 588, 0 }, /* "tuan" */
+    { 1, 0, 0, 589, PINYIN_FUZZY_UANG_UAN }, /* "tuang" */
+    { 'i', 'n', 1745, -1, 0 }, /* "tue" */
+    { 1, 0, 0, 590, PINYIN_CORRECT_UEI_TO_UI }, /* "tuei" */
+    { 1, 0, 0, 591, PINYIN_CORRECT_UEN_TO_UN }, /* "tuen" */
+    { 1, 0, 0, 592, 0 }, /* "tui" */
+    { 1, 0, 0, 593, 0 }, /* "tun" */
+    { 1, 0, 0, 594, 0 }, /* "tuo" */
+    { 'a', 'u', 1751, 595, PINYIN_INCOMPLETE_PINYIN }, /* "w" */
+    { 'g', 'n', 1772, 596, 0 }, /* "wa" */
+    { 'n', 'n', 1780, -1, 0 }, /* "wag" */
+    { 1, 0, 0, 597, PINYIN_CORRECT_GN_TO_NG }, /* "wagn" */
+    { 1, 0, 0, 598, 0 }, /* "wai" */
+    { 'g', 'g', 1781, -1, 0 }, /* "wam" */
+    { 1, 0, 0, 599, PINYIN_CORRECT_MG_TO_NG }, /* "wamg" */
+    { 'g', 'g', 1782, 600, 0 }, /* "wan" */
+    { 1, 0, 0, 601, 0 }, /* "wang" */
+    { 'g', 'n', 1783, -1, 0 }, /* "we" */
+    { 'n', 'n', 1791, -1, 0 }, /* "weg" */
+    { 1, 0, 0, 602, PINYIN_CORRECT_GN_TO_NG }, /* "wegn" */
+    { 1, 0, 0, 603, 0 }, /* "wei" */
+    { 'g', 'g', 1792, -1, 0 }, /* "wem" */
+    { 1, 0, 0, 604, PINYIN_CORRECT_MG_TO_NG }, /* "wemg" */
+    { 'g', 'g', 1793, 605, 0 }, /* "wen" */
+    { 1, 0, 0, 606, 0 }, /* "weng" */
+    { 1, 0, 0, 607, 0 }, /* "wo" */
+    { 1, 0, 0, 608, 0 }, /* "wu" */
+    { 'i', 'v', 1794, 609, PINYIN_INCOMPLETE_PINYIN }, /* "x" */
+    { 'a', 'u', 1808, 610, 0 }, /* "xi" */
+    { 'g', 'o', 1829, 611, 0 }, /* "xia" */
+    { 'n', 'n', 1838, -1, 0 }, /* "xiag" */
+    { 1, 0, 0, 612, PINYIN_CORRECT_GN_TO_NG }, /* "xiagn" */
+    { 'g', 'g', 1839, -1, 0 }, /* "xiam" */
+    { 1, 0, 0, 613, PINYIN_CORRECT_MG_TO_NG }, /* "xiamg" */
+    { 'g', 'g', 1840, 614, 0 }, /* "xian" */
+    { 1, 0, 0, 615, 0 }, /* "xiang" */
+    { 1, 0, 0, 616, 0 }, /* "xiao" */
+    { 1, 0, 0, 617, 0 }, /* "xie" */
+    { 'n', 'n', 1841, -1, 0 }, /* "xig" */
+    { 1, 0, 0, 618, PINYIN_CORRECT_GN_TO_NG }, /* "xign" */
+    { 'g', 'g', 1842, -1, 0 }, /* "xim" */
+    { 1, 0, 0, 619, PINYIN_CORRECT_MG_TO_NG }, /* "ximg" */
+    { 'g', 'g', 1843, 620, 0 }, /* "xin" */
+    { 1, 0, 0, 621, 0 }, /* "xing" */
+    { 'g', 'u', 1844, -1, 0 }, /* "xio" */
+    { 'n', 'n', 1859, -1, 0 }, /* "xiog" */
+    { 1, 0, 0, 622, PINYIN_CORRECT_GN_TO_NG }, /* "xiogn" */
+    { 'g', 'g', 1860, -1, 0 }, /* "xiom" */
+    { 1, 0, 0, 623, PINYIN_CORRECT_MG_TO_NG }, /* "xiomg" */
+    { 'g', 'g', 1861, 624, PINYIN_CORRECT_ON_TO_ONG }, /* "xion" */
+    { 1, 0, 0, 625, 0 }, /* "xiong" */
+    { 1, 0, 0, 626, PINYIN_CORRECT_IOU_TO_IU }, /* "xiou" */
+    { 1, 0, 0, 627, 0 }, /* "xiu" */
+    { 'a', 'n', 1862, 628, 0 }, /* "xu" */
+    { 'n', 'n', 1876, -1, 0 }, /* "xua" */
+    { 'g', 'g', 1877, 629, 0 }, /* "xuan" */
+    { 1, 0, 0, 630, PINYIN_FUZZY_UANG_UAN }, /* "xuang" */
+    { 'n', 'n', 1878, 631, 0 }, /* "xue" */
+    { 1, 0, 0, 632, PINYIN_CORRECT_UEN_TO_UN }, /* "xuen" */
+    { 1, 0, 0, 633, 0 }, /* "xun" */
+    { 'a', 'n', 1879, 634, PINYIN_CORRECT_V_TO_U }, /* "xv" */
+    { 'n', 'n', 1893, -1, 0 }, /* "xva" */
+    { 'g', 'g', 1894, 635, PINYIN_CORRECT_V_TO_U }, /* "xvan" */
+    { 1, 0, 0, 636, PINYIN_FUZZY_UANG_UAN | PINYIN_CORRECT_V_TO_U }, /* "xvang" */
+    { 'n', 'n', 1895, 637, PINYIN_CORRECT_V_TO_U }, /* "xve" */
+    { 1, 0, 0, 638, PINYIN_CORRECT_UEN_TO_UN | PINYIN_CORRECT_V_TO_U }, /* "xven" */
+    { 1, 0, 0, 639, PINYIN_CORRECT_V_TO_U }, /* "xvn" */
+    { 'a', 'v', 1896, 640, PINYIN_INCOMPLETE_PINYIN }, /* "y" */
+    { 'g', 'o', 1918, 641, 0 }, /* "ya" */
+    { 'n', 'n', 1927, -1, 0 }, /* "yag" */
+    { 1, 0, 0, 642, PINYIN_CORRECT_GN_TO_NG }, /* "yagn" */
+    { 'g', 'g', 1928, -1, 0 }, /* "yam" */
+    { 1, 0, 0, 643, PINYIN_CORRECT_MG_TO_NG }, /* "yamg" */
+    { 'g', 'g', 1929, 644, 0 }, /* "yan" */
+    { 1, 0, 0, 645, 0 }, /* "yang" */
+    { 1, 0, 0, 646, 0 }, /* "yao" */
+    { 1, 0, 0, 647, 0 }, /* "ye" */
+    { 'g', 'n', 1930, 648, 0 }, /* "yi" */
+    { 'n', 'n', 1938, -1, 0 }, /* "yig" */
+    { 1, 0, 0, 649, PINYIN_CORRECT_GN_TO_NG }, /* "yign" */
+    { 'g', 'g', 1939, -1, 0 }, /* "yim" */
+    { 1, 0, 0, 650, PINYIN_CORRECT_MG_TO_NG }, /* "yimg" */
+    { 'g', 'g', 1940, 651, 0 }, /* "yin" */
+    { 1, 0, 0, 652, 0 }, /* "ying" */
+    { 'g', 'u', 1941, 653, 0 }, /* "yo" */
+    { 'n', 'n', 1956, -1, 0 }, /* "yog" */
+    { 1, 0, 0, 654, PINYIN_CORRECT_GN_TO_NG }, /* "yogn" */
+    { 'g', 'g', 1957, -1, 0 }, /* "yom" */
+    { 1, 0, 0, 655, PINYIN_CORRECT_MG_TO_NG }, /* "yomg" */
+    { 'g', 'g', 1958, 656, PINYIN_CORRECT_ON_TO_ONG }, /* "yon" */
+    { 1, 0, 0, 657, 0 }, /* "yong" */
+    { 1, 0, 0, 658, 0 }, /* "you" */
+    { 'a', 'n', 1959, 659, 0 }, /* "yu" */
+    { 'n', 'n', 1973, -1, 0 }, /* "yua" */
+    { 'g', 'g', 1974, 660, 0 }, /* "yuan" */
+    { 1, 0, 0, 661, PINYIN_FUZZY_UANG_UAN }, /* "yuang" */
+    { 'n', 'n', 1975, 662, 0 }, /* "yue" */
+    { 1, 0, 0, 663, PINYIN_CORRECT_UEN_TO_UN }, /* "yuen" */
+    { 1, 0, 0, 664, 0 }, /* "yun" */
+    { 'a', 'n', 1976, 665, PINYIN_CORRECT_V_TO_U }, /* "yv" */
+    { 'n', 'n', 1990, -1, 0 }, /* "yva" */
+    { 'g', 'g', 1991, 666, PINYIN_CORRECT_V_TO_U }, /* "yvan" */
+    { 1, 0, 0, 667, PINYIN_FUZZY_UANG_UAN | PINYIN_CORRECT_V_TO_U }, /* "yvang" */
+    { 'n', 'n', 1992, 668, PINYIN_CORRECT_V_TO_U }, /* "yve" */
+    { 1, 0, 0, 669, PINYIN_CORRECT_UEN_TO_UN | PINYIN_CORRECT_V_TO_U }, /* "yven" */
+    { 1, 0, 0, 670, PINYIN_CORRECT_V_TO_U }, /* "yvn" */
+    { 'a', 'u', 1993, 671, PINYIN_INCOMPLETE_PINYIN }, /* "z" */
+    { 'g', 'o', 2014, 672, 0 }, /* "za" */
+    { 'n', 'n', 2023, -1, 0 }, /* "zag" */
+    { 1, 0, 0, 673, PINYIN_CORRECT_GN_TO_NG }, /* "zagn" */
+    { 1, 0, 0, 674, 0 }, /* "zai" */
+    { 'g', 'g', 2024, -1, 0 }, /* "zam" */
+    { 1, 0, 0, 675, PINYIN_CORRECT_MG_TO_NG }, /* "zamg" */
+    { 'g', 'g', 2025, 676, 0 }, /* "zan" */
+    { 1, 0, 0, 677, 0 }, /* "zang" */
+    { 1, 0, 0, 678, 0 }, /* "zao" */
+    { 'g', 'n', 2026, 679, 0 }, /* "ze" */
+    { 'n', 'n', 2034, -1, 0 }, /* "zeg" */
+    { 1, 0, 0, 680, PINYIN_CORRECT_GN_TO_NG }, /* "zegn" */
+    { 1, 0, 0, 681, 0 }, /* "zei" */
+    { 'g', 'g', 2035, -1, 0 }, /* "zem" */
+    { 1, 0, 0, 682, PINYIN_CORRECT_MG_TO_NG }, /* "zemg" */
+    { 'g', 'g', 2036, 683, 0 }, /* "zen" */
+    { 1, 0, 0, 684, 0 }, /* "zeng" */
+    { 'a', 'u', 2037, 685, PINYIN_INCOMPLETE_PINYIN }, /* "zh" */
+    { 'g', 'o', 2058, 686, 0 }, /* "zha" */
+    { 'n', 'n', 2067, -1, 0 }, /* "zhag" */
+    { 1, 0, 0, 687, PINYIN_CORRECT_GN_TO_NG }, /* "zhagn" */
+    { 1, 0, 0, 688, 0 }, /* "zhai" */
+    { 'g', 'g', 2068, -1, 0 }, /* "zham" */
+    { 1, 0, 0, 689, PINYIN_CORRECT_MG_TO_NG }, /* "zhamg" */
+    { 'g', 'g', 2069, 690, 0 }, /* "zhan" */
+    { 1, 0, 0, 691, 0 }, /* "zhang" */
+    { 1, 0, 0, 692, 0 }, /* "zhao" */
+    { 'g', 'n', 2070, 693, 0 }, /* "zhe" */
+    { 'n', 'n', 2078, -1, 0 }, /* "zheg" */
+    { 1, 0, 0, 694, PINYIN_CORRECT_GN_TO_NG }, /* "zhegn" */
+    { 1, 0, 0, 695, PINYIN_FUZZY_ZH_Z }, /* "zhei" */
+    { 'g', 'g', 2079, -1, 0 }, /* "zhem" */
+    { 1, 0, 0, 696, PINYIN_CORRECT_MG_TO_NG }, /* "zhemg" */
+    { 'g', 'g', 2080, 697, 0 }, /* "zhen" */
+    { 1, 0, 0, 698, 0 }, /* "zheng" */
+    { 1, 0, 0, 699, 0 }, /* "zhi" */
+    { 'g', 'u', 2081, -1, 0 }, /* "zho" */
+    { 'n', 'n', 2096, -1, 0 }, /* "zhog" */
+    { 1, 0, 0, 700, PINYIN_CORRECT_GN_TO_NG }, /* "zhogn" */
+    { 'g', 'g', 2097, -1, 0 }, /* "zhom" */
+    { 1, 0, 0, 701, PINYIN_CORRECT_MG_TO_NG }, /* "zhomg" */
+    { 'g', 'g', 2098, 702, PINYIN_CORRECT_ON_TO_ONG }, /* "zhon" */
+    { 1, 0, 0, 703, 0 }, /* "zhong" */
+    { 1, 0, 0, 704, 0 }, /* "zhou" */
+    { 'a', 'o', 2099, 705, 0 }, /* "zhu" */
+    { 'g', 'n', 2114, 706, 0 }, /* "zhua" */
+    { 'n', 'n', 2122, -1, 0 }, /* "zhuag" */
+    { 1, 0, 0, 707, PINYIN_CORRECT_GN_TO_NG }, /* "zhuagn" */
+    { 1, 0, 0, 708, 0 }, /* "zhuai" */
+    { 'g', 'g', 2123, -1, 0 }, /* "zhuam" */
+    { 1, 0, 0, 709, PINYIN_CORRECT_MG_TO_NG }, /* "zhuamg" */
+    { 'g', 'g', 2124, 710, 0 }, /* "zhuan" */
+    { 1, 0, 0, 711, 0 }, /* "zhuang" */
+    { 'i', 'n', 2125, -1, 0 }, /* "zhue" */
+    { 1, 0, 0, 712, PINYIN_CORRECT_UEI_TO_UI }, /* "zhuei" */
+    { 1, 0, 0, 713, PINYIN_CORRECT_UEN_TO_UN }, /* "zhuen" */
+    { 1, 0, 0, 714, 0 }, /* "zhui" */
+    { 1, 0, 0, 715, 0 }, /* "zhun" */
+    { 1, 0, 0, 716, 0 }, /* "zhuo" */
+    { 1, 0, 0, 717, 0 }, /* "zi" */
+    { 'g', 'u', 2131, -1, 0 }, /* "zo" */
+    { 'n', 'n', 2146, -1, 0 }, /* "zog" */
+    { 1, 0, 0, 718, PINYIN_CORRECT_GN_TO_NG }, /* "zogn" */
+    { 'g', 'g', 2147, -1, 0 }, /* "zom" */
+    { 1, 0, 0, 719, PINYIN_CORRECT_MG_TO_NG }, /* "zomg" */
+    { 'g', 'g', 2148, 720, PINYIN_CORRECT_ON_TO_ONG }, /* "zon" */
+    { 1, 0, 0, 721, 0 }, /* "zong" */
+    { 1, 0, 0, 722, 0 }, /* "zou" */
+    { 'a', 'o', 2149, 723, 0 }, /* "zu" */
+    { 'i', 'n', 2164, 724, PINYIN_FUZZY_Z_ZH }, /* "zua" */
+    { 1, 0, 0, 725, PINYIN_FUZZY_Z_ZH }, /* "zuai" */
+    { 'g', 'g', 2170, 726, 0 }, /* "zuan" */
+    { 1, 0, 0, 727, PINYIN_FUZZY_Z_ZH | PINYIN_FUZZY_UANG_UAN }, /* "zuang" */
+    { 'i', 'n', 2171, -1, 0 }, /* "zue" */
+    { 1, 0, 0, 728, PINYIN_CORRECT_UEI_TO_UI }, /* "zuei" */
+    { 1, 0, 0, 729, PINYIN_CORRECT_UEN_TO_UN }, /* "zuen" */
+    { 1, 0, 0, 730, 0 }, /* "zui" */
+    { 1, 0, 0, 731, 0 }, /* "zun" */
+    { 1, 0, 0, 732, 0 }, /* "zuo" */
+};
+
+static const unsigned short pinyin_trie_next[] = {
+    1, 10, 42, 120, 171, 175, 208, 249, 0, 290,
+    330, 371, 428, 464, 519, 521, 554, 594, 643, 719,
+    0, 0, 766, 785, 825, 864, 2, 0, 4, 0,
+    0, 0, 5, 7, 9, 3, 6, 8, 11, 0,
+    0, 0, 20, 0, 0, 0, 28, 0, 0, 0,
+    0, 0, 40, 0, 0, 0, 0, 0, 41, 12,
+    0, 14, 0, 0, 0, 15, 17, 19, 13, 16,
+    18, 21, 0, 23, 0, 0, 0, 24, 26, 22,
+    25, 27, 29, 0, 0, 0, 33, 0, 34, 0,
+    0, 0, 0, 0, 36, 38, 30, 32, 31, 35,
+    37, 39, 43, 0, 0, 0, 52, 0, 0, 59,
+    100, 0, 0, 0, 0, 0, 101, 0, 0, 0,
+    0, 0, 109, 44, 0, 46, 0, 0, 0, 47,
+    49, 51, 45, 48, 50, 53, 0, 0, 0, 0,
+    0, 55, 57, 54, 56, 58, 60, 0, 0, 0,
+    69, 0, 0, 0, 76, 0, 0, 0, 0, 0,
+    77, 0, 0, 0, 0, 0, 85, 61, 0, 63,
+    0, 0, 0, 64, 66, 68, 62, 65, 67, 70,
+    0, 0, 0, 0, 0, 72, 74, 71, 73, 75,
+    78, 0, 0, 0, 0, 0, 80, 82, 0, 0,
+    0, 0, 0, 0, 84, 79, 81, 83, 86, 0,
+    0, 0, 94, 0, 0, 0, 97, 0, 0, 0,
+    0, 98, 99, 87, 0, 89, 0, 0, 0, 90,
+    92, 88, 91, 93, 95, 0, 0, 0, 0, 96,
+    102, 0, 0, 0, 0, 0, 104, 106, 0, 0,
+    0, 0, 0, 0, 108, 103, 105, 107, 110, 0,
+    0, 0, 114, 0, 0, 0, 117, 0, 0, 0,
+    0, 118, 119, 111, 0, 0, 0, 0, 112, 113,
+    115, 0, 0, 0, 0, 116, 121, 0, 0, 0,
+    130, 0, 0, 0, 138, 0, 0, 0, 0, 0,
+    153, 0, 0, 0, 0, 0, 161, 122, 0, 124,
+    0, 0, 0, 125, 127, 129, 123, 126, 128, 131,
+    0, 133, 0, 0, 0, 134, 136, 132, 135, 137,
+    139, 0, 0, 0, 143, 0, 144, 0, 0, 0,
+    0, 0, 146, 148, 150, 0, 0, 0, 0, 0,
+    152, 140, 142, 141, 145, 147, 149, 151, 154, 0,
+    0, 0, 0, 0, 156, 158, 0, 0, 0, 0,
+    0, 0, 160, 155, 157, 159, 162, 0, 0, 0,
+    165, 0, 0, 0, 168, 0, 0, 0, 0, 169,
+    170, 163, 164, 166, 0, 0, 0, 0, 167, 172,
+    0, 0, 0, 0, 173, 0, 0, 0, 174, 176,
+    0, 0, 0, 185, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 193, 0, 0, 0, 0, 0, 197,
+    177, 0, 179, 0, 0, 0, 180, 182, 184, 178,
+    181, 183, 186, 0, 188, 0, 0, 0, 189, 191,
+    187, 190, 192, 194, 0, 0, 0, 0, 0, 0,
+    196, 195, 198, 0, 0, 0, 202, 0, 0, 0,
+    205, 0, 0, 0, 0, 206, 207, 199, 0, 0,
+    0, 0, 200, 201, 203, 0, 0, 0, 0, 204,
+    209, 0, 0, 0, 218, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 226, 0, 0, 0, 0, 0,
+    234, 210, 0, 212, 0, 0, 0, 213, 215, 217,
+    211, 214, 216, 219, 0, 221, 0, 0, 0, 222,
+    224, 220, 223, 225, 227, 0, 0, 0, 0, 0,
+    229, 231, 0, 0, 0, 0, 0, 0, 233, 228,
+    230, 232, 235, 0, 0, 0, 243, 0, 0, 0,
+    246, 0, 0, 0, 0, 247, 248, 236, 0, 238,
+    0, 0, 0, 239, 241, 237, 240, 242, 244, 0,
+    0, 0, 0, 245, 250, 0, 0, 0, 259, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 267, 0,
+    0, 0, 0, 0, 275, 251, 0, 253, 0, 0,
+    0, 254, 256, 258, 252, 255, 257, 260, 0, 262,
+    0, 0, 0, 263, 265, 261, 264, 266, 268, 0,
+    0, 0, 0, 0, 270, 272, 0, 0, 0, 0,
+    0, 0, 274, 269, 271, 273, 276, 0, 0, 0,
+    284, 0, 0, 0, 287, 0, 0, 0, 0, 288,
+    289, 277, 0, 279, 0, 0, 0, 280, 282, 278,
+    281, 283, 285, 0, 0, 0, 0, 286, 291, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    316, 323, 292, 0, 0, 0, 300, 0, 301, 0,
+    0, 0, 0, 0, 303, 305, 307, 0, 0, 0,
+    0, 0, 315, 293, 0, 0, 0, 0, 0, 295,
+    297, 299, 294, 296, 298, 302, 304, 306, 308, 0,
+    0, 0, 0, 0, 310, 312, 0, 0, 0, 0,
+    0, 0, 314, 309, 311, 313, 317, 0, 0, 0,
+    320, 0, 0, 0, 0, 0, 0, 0, 0, 322,
+    318, 319, 321, 324, 0, 0, 0, 327, 0, 0,
+    0, 0, 0, 0, 0, 0, 329, 325, 326, 328,
+    331, 0, 0, 0, 340, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 348, 0, 0, 0, 0, 0,
+    356, 332, 0, 334, 0, 0, 0, 335, 337, 339,
+    333, 336, 338, 341, 0, 343, 0, 0, 0, 344,
+    346, 342, 345, 347, 349, 0, 0, 0, 0, 0,
+    351, 353, 0, 0, 0, 0, 0, 0, 355, 350,
+    352, 354, 357, 0, 0, 0, 365, 0, 0, 0,
+    368, 0, 0, 0, 0, 369, 370, 358, 0, 360,
+    0, 0, 0, 361, 363, 359, 362, 364, 366, 0,
+    0, 0, 0, 367, 372, 0, 0, 0, 381, 0,
+    0, 0, 389, 0, 0, 0, 0, 0, 408, 0,
+    0, 0, 0, 0, 416, 426, 373, 0, 375, 0,
+    0, 0, 376, 378, 380, 374, 377, 379, 382, 0,
+    384, 0, 0, 0, 385, 387, 383, 386, 388, 390,
+    0, 0, 0, 398, 0, 399, 0, 0, 0, 0,
+    0, 401, 403, 405, 0, 0, 0, 0, 0, 407,
+    391, 0, 0, 0, 0, 0, 393, 395, 397, 392,
+    394, 396, 400, 402, 404, 406, 409, 0, 0, 0,
+    0, 0, 411, 413, 0, 0, 0, 0, 0, 0,
+    415, 410, 412, 414, 417, 0, 0, 0, 420, 0,
+    0, 0, 423, 0, 0, 0, 0, 424, 425, 418,
+    419, 421, 0, 0, 0, 0, 422, 427, 429, 0,
+    0, 0, 438, 0, 0, 0, 446, 0, 0, 0,
+    0, 0, 461, 0, 0, 0, 0, 0, 463, 430,
+    0, 432, 0, 0, 0, 433, 435, 437, 431, 434,
+    436, 439, 0, 441, 0, 0, 0, 442, 444, 440,
+    443, 445, 447, 0, 0, 0, 451, 0, 452, 0,
+    0, 0, 0, 0, 454, 456, 458, 0, 0, 0,
+    0, 0, 460, 448, 450, 449, 453, 455, 457, 459,
+    462, 465, 0, 0, 0, 474, 0, 0, 0, 482,
+    0, 0, 0, 0, 0, 501, 0, 0, 0, 0,
+    0, 509, 517, 466, 0, 468, 0, 0, 0, 469,
+    471, 473, 467, 470, 472, 475, 0, 477, 0, 0,
+    0, 478, 480, 476, 479, 481, 483, 0, 0, 0,
+    491, 0, 492, 0, 0, 0, 0, 0, 494, 496,
+    498, 0, 0, 0, 0, 0, 500, 484, 0, 0,
+    0, 0, 0, 486, 488, 490, 485, 487, 489, 493,
+    495, 497, 499, 502, 0, 0, 0, 0, 0, 504,
+    506, 0, 0, 0, 0, 0, 0, 508, 503, 505,
+    507, 510, 0, 0, 0, 513, 0, 0, 0, 0,
+    0, 0, 0, 0, 515, 516, 511, 512, 514, 518,
+    520, 522, 0, 0, 0, 531, 0, 0, 0, 539,
+    0, 0, 0, 0, 0, 551, 0, 0, 0, 0,
+    0, 553, 523, 0, 525, 0, 0, 0, 526, 528,
+    530, 524, 527, 529, 532, 0, 534, 0, 0, 0,
+    535, 537, 533, 536, 538, 540, 0, 0, 0, 544,
+    0, 545, 0, 0, 0, 0, 0, 547, 549, 541,
+    543, 542, 546, 548, 550, 552, 555, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 580, 587,
+    556, 0, 0, 0, 564, 0, 565, 0, 0, 0,
+    0, 0, 567, 569, 571, 0, 0, 0, 0, 0,
+    579, 557, 0, 0, 0, 0, 0, 559, 561, 563,
+    558, 560, 562, 566, 568, 570, 572, 0, 0, 0,
+    0, 0, 574, 576, 0, 0, 0, 0, 0, 0,
+    578, 573, 575, 577, 581, 0, 0, 0, 584, 0,
+    0, 0, 0, 0, 0, 0, 0, 586, 582, 583,
+    585, 588, 0, 0, 0, 591, 0, 0, 0, 0,
+    0, 0, 0, 0, 593, 589, 590, 592, 595, 0,
+    0, 0, 604, 0, 0, 0, 612, 0, 0, 0,
+    0, 0, 623, 0, 0, 0, 0, 0, 631, 641,
+    596, 0, 598, 0, 0, 0, 599, 601, 603, 597,
+    600, 602, 605, 0, 607, 0, 0, 0, 608, 610,
+    606, 609, 611, 613, 0, 0, 0, 617, 0, 0,
+    0, 0, 0, 0, 0, 0, 618, 620, 0, 0,
+    0, 0, 0, 622, 614, 616, 615, 619, 621, 624,
+    0, 0, 0, 0, 0, 626, 628, 0, 0, 0,
+    0, 0, 0, 630, 625, 627, 629, 632, 0, 0,
+    0, 635, 0, 0, 0, 638, 0, 0, 0, 0,
+    639, 640, 633, 634, 636, 0, 0, 0, 0, 637,
+    642, 644, 0, 0, 0, 653, 0, 0, 661, 699,
+    0, 0, 0, 0, 0, 700, 0, 0, 0, 0,
+    0, 708, 645, 0, 647, 0, 0, 0, 648, 650,
+    652, 646, 649, 651, 654, 0, 656, 0, 0, 0,
+    657, 659, 655, 658, 660, 662, 0, 0, 0, 671,
+    0, 0, 0, 679, 0, 0, 0, 0, 0, 680,
+    0, 0, 0, 0, 0, 684, 663, 0, 665, 0,
+    0, 0, 666, 668, 670, 664, 667, 669, 672, 0,
+    674, 0, 0, 0, 675, 677, 673, 676, 678, 681,
+    0, 0, 0, 0, 0, 0, 683, 682, 685, 0,
+    0, 0, 693, 0, 0, 0, 696, 0, 0, 0,
+    0, 697, 698, 686, 0, 688, 0, 0, 0, 689,
+    691, 687, 690, 692, 694, 0, 0, 0, 0, 695,
+    701, 0, 0, 0, 0, 0, 703, 705, 0, 0,
+    0, 0, 0, 0, 707, 702, 704, 706, 709, 0,
+    0, 0, 713, 0, 0, 0, 716, 0, 0, 0,
+    0, 717, 718, 710, 0, 0, 0, 0, 711, 712,
+    714, 0, 0, 0, 0, 715, 720, 0, 0, 0,
+    729, 0, 0, 0, 736, 0, 0, 0, 0, 0,
+    748, 0, 0, 0, 0, 0, 756, 721, 0, 723,
+    0, 0, 0, 724, 726, 728, 722, 725, 727, 730,
+    0, 0, 0, 0, 0, 732, 734, 731, 733, 735,
+    737, 0, 0, 0, 741, 0, 742, 0, 0, 0,
+    0, 0, 744, 746, 738, 740, 739, 743, 745, 747,
+    749, 0, 0, 0, 0, 0, 751, 753, 0, 0,
+    0, 0, 0, 0, 755, 750, 752, 754, 757, 0,
+    0, 0, 760, 0, 0, 0, 763, 0, 0, 0,
+    0, 764, 765, 758, 759, 761, 0, 0, 0, 0,
+    762, 767, 0, 0, 0, 775, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 783, 0, 0, 0, 0,
+    0, 784, 768, 0, 770, 0, 0, 0, 771, 773,
+    769, 772, 774, 776, 0, 778, 0, 0, 0, 779,
+    781, 777, 780, 782, 786, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 811, 818, 787, 0,
+    0, 0, 795, 0, 796, 0, 0, 0, 0, 0,
+    798, 800, 802, 0, 0, 0, 0, 0, 810, 788,
+    0, 0, 0, 0, 0, 790, 792, 794, 789, 791,
+    793, 797, 799, 801, 803, 0, 0, 0, 0, 0,
+    805, 807, 0, 0, 0, 0, 0, 0, 809, 804,
+    806, 808, 812, 0, 0, 0, 815, 0, 0, 0,
+    0, 0, 0, 0, 0, 817, 813, 814, 816, 819,
+    0, 0, 0, 822, 0, 0, 0, 0, 0, 0,
+    0, 0, 824, 820, 821, 823, 826, 0, 0, 0,
+    834, 0, 0, 0, 835, 0, 0, 0, 0, 0,
+    842, 0, 0, 0, 0, 0, 850, 857, 827, 0,
+    0, 0, 0, 0, 829, 831, 833, 828, 830, 832,
+    836, 0, 0, 0, 0, 0, 838, 840, 837, 839,
+    841, 843, 0, 0, 0, 0, 0, 845, 847, 0,
+    0, 0, 0, 0, 0, 849, 844, 846, 848, 851,
+    0, 0, 0, 854, 0, 0, 0, 0, 0, 0,
+    0, 0, 856, 852, 853, 855, 858, 0, 0, 0,
+    861, 0, 0, 0, 0, 0, 0, 0, 0, 863,
+    859, 860, 862, 865, 0, 0, 0, 874, 0, 0,
+    882, 924, 0, 0, 0, 0, 0, 925, 0, 0,
+    0, 0, 0, 933, 866, 0, 868, 0, 0, 0,
+    869, 871, 873, 867, 870, 872, 875, 0, 877, 0,
+    0, 0, 878, 880, 876, 879, 881, 883, 0, 0,
+    0, 892, 0, 0, 0, 900, 0, 0, 0, 0,
+    0, 901, 0, 0, 0, 0, 0, 909, 884, 0,
+    886, 0, 0, 0, 887, 889, 891, 885, 888, 890,
+    893, 0, 895, 0, 0, 0, 896, 898, 894, 897,
+    899, 902, 0, 0, 0, 0, 0, 904, 906, 0,
+    0, 0, 0, 0, 0, 908, 903, 905, 907, 910,
+    0, 0, 0, 918, 0, 0, 0, 921, 0, 0,
+    0, 0, 922, 923, 911, 0, 913, 0, 0, 0,
+    914, 916, 912, 915, 917, 919, 0, 0, 0, 0,
+    920, 926, 0, 0, 0, 0, 0, 928, 930, 0,
+    0, 0, 0, 0, 0, 932, 927, 929, 931, 934,
+    0, 0, 0, 938, 0, 0, 0, 941, 0, 0,
+    0, 0, 942, 943, 935, 0, 0, 0, 0, 936,
+    937, 939, 0, 0, 0, 0, 940,
+};
+
+/* sheng_yun_table[sheng][yun] is the pinyin of the sheng and yun ids, or NULL.
+ * yun is 0 for a pinyin of sheng only. */
+static const Pinyin * const sheng_yun_table[24][57] = {
+    {   /* zero */
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[0], &pinyin_table[2], &pinyin_table[4], &pinyin_table[5], &pinyin_table[6], &pinyin_table[128],
+        &pinyin_table[129], &pinyin_table[130], NULL, &pinyin_table[131], NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, &pinyin_table[401], NULL, &pinyin_table[402], NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL,
+    },
+    {   /* b */
+        &pinyin_table[7], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[8], &pinyin_table[10], &pinyin_table[12], &pinyin_table[13], &pinyin_table[14], NULL,
+        &pinyin_table[16], &pinyin_table[18], &pinyin_table[19], NULL, &pinyin_table[20], NULL,
+        &pinyin_table[21], &pinyin_table[22], &pinyin_table[23], &pinyin_table[24], &pinyin_table[27], &pinyin_table[28],
+        NULL, NULL, &pinyin_table[29], NULL, NULL, &pinyin_table[30],
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL,
+    },
+    {   /* c */
+        &pinyin_table[31], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[32], &pinyin_table[34], &pinyin_table[36], &pinyin_table[37], &pinyin_table[38], &pinyin_table[39],
+        NULL, &pinyin_table[42], &pinyin_table[43], NULL, &pinyin_table[74], NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, &pinyin_table[78], &pinyin_table[79], &pinyin_table[80],
+        NULL, &pinyin_table[81], &pinyin_table[82], &pinyin_table[83], NULL, &pinyin_table[86],
+        &pinyin_table[87], &pinyin_table[88], NULL,
+    },
+    {   /* ch */
+        &pinyin_table[44], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[45], &pinyin_table[47], &pinyin_table[49], &pinyin_table[50], &pinyin_table[51], &pinyin_table[52],
+        NULL, &pinyin_table[55], &pinyin_table[56], NULL, &pinyin_table[57], NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, &pinyin_table[61], &pinyin_table[62], &pinyin_table[63],
+        NULL, &pinyin_table[65], &pinyin_table[67], &pinyin_table[68], NULL, &pinyin_table[71],
+        &pinyin_table[72], &pinyin_table[73], NULL,
+    },
+    {   /* d */
+        &pinyin_table[89], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[90], &pinyin_table[92], &pinyin_table[94], &pinyin_table[95], &pinyin_table[96], &pinyin_table[97],
+        &pinyin_table[99], &pinyin_table[101], &pinyin_table[102], NULL, &pinyin_table[103], &pinyin_table[104],
+        &pinyin_table[105], &pinyin_table[106], &pinyin_table[107], &pinyin_table[108], &pinyin_table[111], &pinyin_table[112],
+        NULL, &pinyin_table[114], NULL, &pinyin_table[118], &pinyin_table[119], &pinyin_table[120],
+        NULL, NULL, &pinyin_table[121], &pinyin_table[122], NULL, &pinyin_table[125],
+        &pinyin_table[126], &pinyin_table[127], NULL,
+    },
+    {   /* f */
+        &pinyin_table[132], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[133], &pinyin_table[135], &pinyin_table[137], &pinyin_table[138], &pinyin_table[139], &pinyin_table[140],
+        &pinyin_table[142], &pinyin_table[144], &pinyin_table[145], NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, &pinyin_table[146], &pinyin_table[148], &pinyin_table[149], &pinyin_table[150],
+        &pinyin_table[151], &pinyin_table[152], &pinyin_table[153], &pinyin_table[154], NULL, &pinyin_table[157],
+        &pinyin_table[158], &pinyin_table[159], NULL,
+    },
+    {   /* g */
+        &pinyin_table[160], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[161], &pinyin_table[163], &pinyin_table[165], &pinyin_table[166], &pinyin_table[167], &pinyin_table[168],
+        &pinyin_table[170], &pinyin_table[172], &pinyin_table[173], NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, &pinyin_table[177], &pinyin_table[178], &pinyin_table[179],
+        &pinyin_table[180], &pinyin_table[182], &pinyin_table[184], &pinyin_table[185], NULL, &pinyin_table[188],
+        &pinyin_table[189], &pinyin_table[190], NULL,
+    },
+    {   /* h */
+        &pinyin_table[191], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[192], &pinyin_table[194], &pinyin_table[196], &pinyin_table[197], &pinyin_table[198], &pinyin_table[199],
+        &pinyin_table[201], &pinyin_table[203], &pinyin_table[204], NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, &pinyin_table[205], &pinyin_table[209], &pinyin_table[210], &pinyin_table[211],
+        &pinyin_table[212], &pinyin_table[214], &pinyin_table[216], &pinyin_table[217], NULL, &pinyin_table[220],
+        &pinyin_table[221], &pinyin_table[222], NULL,
+    },
+    {   /* j */
+        &pinyin_table[223], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, &pinyin_table[224], &pinyin_table[225],
+        &pinyin_table[228], &pinyin_table[229], &pinyin_table[230], &pinyin_table[231], &pinyin_table[234], &pinyin_table[235],
+        &pinyin_table[239], &pinyin_table[241], NULL, NULL, NULL, &pinyin_table[242],
+        NULL, NULL, &pinyin_table[243], &pinyin_table[244], &pinyin_table[245], NULL,
+        &pinyin_table[247], NULL, &pinyin_table[248],
+    },
+    {   /* k */
+        &pinyin_table[254], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[255], &pinyin_table[257], &pinyin_table[259], &pinyin_table[260], &pinyin_table[261], &pinyin_table[262],
+        &pinyin_table[264], &pinyin_table[266], &pinyin_table[267], NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, &pinyin_table[271], &pinyin_table[272], &pinyin_table[273],
+        &pinyin_table[274], &pinyin_table[276], &pinyin_table[278], &pinyin_table[279], NULL, &pinyin_table[282],
+        &pinyin_table[283], &pinyin_table[284], NULL,
+    },
+    {   /* l */
+        &pinyin_table[285], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[286], &pinyin_table[288], &pinyin_table[290], &pinyin_table[291], &pinyin_table[292], &pinyin_table[293],
+        &pinyin_table[295], &pinyin_table[297], &pinyin_table[298], NULL, &pinyin_table[299], &pinyin_table[300],
+        &pinyin_table[303], &pinyin_table[304], &pinyin_table[305], &pinyin_table[306], &pinyin_table[309], &pinyin_table[310],
+        NULL, &pinyin_table[312], &pinyin_table[313], &pinyin_table[317], &pinyin_table[318], &pinyin_table[319],
+        NULL, NULL, &pinyin_table[320], &pinyin_table[321], &pinyin_table[329], &pinyin_table[325],
+        &pinyin_table[326], &pinyin_table[327], &pinyin_table[328],
+    },
+    {   /* m */
+        &pinyin_table[330], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[331], &pinyin_table[333], &pinyin_table[335], &pinyin_table[336], &pinyin_table[337], &pinyin_table[338],
+        &pinyin_table[340], &pinyin_table[342], &pinyin_table[343], NULL, &pinyin_table[344], NULL,
+        &pinyin_table[345], &pinyin_table[346], &pinyin_table[347], &pinyin_table[348], &pinyin_table[351], &pinyin_table[352],
+        NULL, &pinyin_table[354], &pinyin_table[355], NULL, &pinyin_table[356], &pinyin_table[357],
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL,
+    },
+    {   /* n */
+        &pinyin_table[358], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[359], &pinyin_table[361], &pinyin_table[363], &pinyin_table[364], &pinyin_table[365], &pinyin_table[366],
+        &pinyin_table[368], &pinyin_table[370], &pinyin_table[371], NULL, &pinyin_table[372], &pinyin_table[373],
+        &pinyin_table[376], &pinyin_table[377], &pinyin_table[378], &pinyin_table[379], &pinyin_table[382], &pinyin_table[383],
+        NULL, &pinyin_table[385], &pinyin_table[386], &pinyin_table[390], &pinyin_table[391], &pinyin_table[392],
+        NULL, NULL, &pinyin_table[393], &pinyin_table[394], &pinyin_table[400], NULL,
+        &pinyin_table[397], &pinyin_table[398], &pinyin_table[399],
+    },
+    {   /* p */
+        &pinyin_table[403], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[404], &pinyin_table[406], &pinyin_table[408], &pinyin_table[409], &pinyin_table[410], NULL,
+        &pinyin_table[412], &pinyin_table[414], &pinyin_table[415], NULL, &pinyin_table[416], NULL,
+        &pinyin_table[417], &pinyin_table[418], &pinyin_table[419], &pinyin_table[420], &pinyin_table[423], &pinyin_table[424],
+        NULL, NULL, &pinyin_table[425], NULL, &pinyin_table[426], &pinyin_table[427],
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL,
+    },
+    {   /* q */
+        &pinyin_table[428], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, &pinyin_table[429], &pinyin_table[430],
+        &pinyin_table[433], &pinyin_table[434], &pinyin_table[435], &pinyin_table[436], &pinyin_table[439], &pinyin_table[440],
+        &pinyin_table[444], &pinyin_table[446], NULL, NULL, NULL, &pinyin_table[447],
+        NULL, NULL, &pinyin_table[448], &pinyin_table[449], &pinyin_table[450], NULL,
+        &pinyin_table[452], NULL, &pinyin_table[453],
+    },
+    {   /* r */
+        &pinyin_table[459], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[460], &pinyin_table[462], &pinyin_table[464], &pinyin_table[465], &pinyin_table[466], &pinyin_table[467],
+        &pinyin_table[469], &pinyin_table[471], &pinyin_table[472], NULL, &pinyin_table[473], &pinyin_table[474],
+        &pinyin_table[475], &pinyin_table[476], &pinyin_table[477], &pinyin_table[478], &pinyin_table[479], &pinyin_table[480],
+        NULL, &pinyin_table[482], &pinyin_table[483], &pinyin_table[487], &pinyin_table[488], &pinyin_table[489],
+        NULL, NULL, &pinyin_table[490], &pinyin_table[491], &pinyin_table[499], &pinyin_table[495],
+        &pinyin_table[496], &pinyin_table[497], &pinyin_table[498],
+    },
+    {   /* s */
+        &pinyin_table[500], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[501], &pinyin_table[503], &pinyin_table[505], &pinyin_table[506], &pinyin_table[507], &pinyin_table[508],
+        &pinyin_table[510], &pinyin_table[512], &pinyin_table[513], NULL, &pinyin_table[544], NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, &pinyin_table[548], &pinyin_table[549], &pinyin_table[550],
+        &pinyin_table[551], &pinyin_table[552], &pinyin_table[553], &pinyin_table[554], NULL, &pinyin_table[557],
+        &pinyin_table[558], &pinyin_table[559], NULL,
+    },
+    {   /* sh */
+        &pinyin_table[514], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[515], &pinyin_table[517], &pinyin_table[519], &pinyin_table[520], &pinyin_table[521], &pinyin_table[522],
+        &pinyin_table[524], &pinyin_table[526], &pinyin_table[527], NULL, &pinyin_table[528], NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, &pinyin_table[530], &pinyin_table[531], &pinyin_table[532],
+        &pinyin_table[533], &pinyin_table[535], &pinyin_table[537], &pinyin_table[538], NULL, &pinyin_table[541],
+        &pinyin_table[542], &pinyin_table[543], NULL,
+    },
+    {   /* t */
+        &pinyin_table[560], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[561], &pinyin_table[563], &pinyin_table[565], &pinyin_table[566], &pinyin_table[567], &pinyin_table[568],
+        NULL, &pinyin_table[571], &pinyin_table[572], NULL, &pinyin_table[573], NULL,
+        &pinyin_table[574], &pinyin_table[575], &pinyin_table[576], &pinyin_table[577], &pinyin_table[580], &pinyin_table[581],
+        NULL, NULL, NULL, &pinyin_table[585], &pinyin_table[586], &pinyin_table[587],
+        NULL, NULL, &pinyin_table[588], &pinyin_table[589], NULL, &pinyin_table[592],
+        &pinyin_table[593], &pinyin_table[594], NULL,
+    },
+    {   /* w */
+        &pinyin_table[595], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[596], &pinyin_table[598], &pinyin_table[600], &pinyin_table[601], NULL, NULL,
+        &pinyin_table[603], &pinyin_table[605], &pinyin_table[606], NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, &pinyin_table[607], NULL, NULL, &pinyin_table[608],
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL,
+    },
+    {   /* x */
+        &pinyin_table[609], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, &pinyin_table[610], &pinyin_table[611],
+        &pinyin_table[614], &pinyin_table[615], &pinyin_table[616], &pinyin_table[617], &pinyin_table[620], &pinyin_table[621],
+        &pinyin_table[625], &pinyin_table[627], NULL, NULL, NULL, &pinyin_table[628],
+        NULL, NULL, &pinyin_table[629], &pinyin_table[630], &pinyin_table[631], NULL,
+        &pinyin_table[633], NULL, &pinyin_table[634],
+    },
+    {   /* y */
+        &pinyin_table[640], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[641], NULL, &pinyin_table[644], &pinyin_table[645], &pinyin_table[646], &pinyin_table[647],
+        NULL, NULL, NULL, NULL, &pinyin_table[648], NULL,
+        NULL, NULL, NULL, NULL, &pinyin_table[651], &pinyin_table[652],
+        NULL, NULL, &pinyin_table[653], &pinyin_table[657], &pinyin_table[658], &pinyin_table[659],
+        NULL, NULL, &pinyin_table[660], &pinyin_table[661], &pinyin_table[662], NULL,
+        &pinyin_table[664], NULL, &pinyin_table[665],
+    },
+    {   /* z */
+        &pinyin_table[671], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[672], &pinyin_table[674], &pinyin_table[676], &pinyin_table[677], &pinyin_table[678], &pinyin_table[679],
+        &pinyin_table[681], &pinyin_table[683], &pinyin_table[684], NULL, &pinyin_table[717], NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, &pinyin_table[721], &pinyin_table[722], &pinyin_table[723],
+        &pinyin_table[724], &pinyin_table[725], &pinyin_table[726], &pinyin_table[727], NULL, &pinyin_table[730],
+        &pinyin_table[731], &pinyin_table[732], NULL,
+    },
+    {   /* zh */
+        &pinyin_table[685], NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        &pinyin_table[686], &pinyin_table[688], &pinyin_table[690], &pinyin_table[691], &pinyin_table[692], &pinyin_table[693],
+        &pinyin_table[695], &pinyin_table[697], &pinyin_table[698], NULL, &pinyin_table[699], NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, &pinyin_table[703], &pinyin_table[704], &pinyin_table[705],
+        &pinyin_table[706], &pinyin_table[708], &pinyin_table[710], &pinyin_table[711], NULL, &pinyin_table[714],
+        &pinyin_table[715], &pinyin_table[716], NULL,
+    },
+};
@@ -28,11 +28,18 @@
 
 #ifdef HAVE_OPENCC
 #  include <opencc.h>
+#  include <list>
+#  include <map>
 #else
-#  include <cstring>
-#  include <cstdlib>
+#  include <algorithm>
 #endif
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+#include <cstring>
+
 #include "String.h"
 
 namespace PyZy {
@@ -75,105 +82,568 @@ public:
         }
         g_free (in_ucs4);
     }
+
+    /* converts n characters of in, and appends them to out */
+    void convert (ucs4_t *in, size_t n, std::vector<unsigned int> &out)
+    {
+        while (n != 0) {
+            ucs4_t *poutbuf = (ucs4_t *)m_buffer;
+            size_t outbuf_left = BUFFER_SIZE;
+            size_t retval = opencc_convert(m_od, &in, &n, &poutbuf, &outbuf_left);
+            if (retval == (size_t) -1) {
+                g_warning ("opencc_convert return failed");
+                out.insert (out.end (), in, in + n);
+                break;
+            }
+            out.insert (out.end (), (ucs4_t *)m_buffer, poutbuf);
+        }
+    }
 private:
     opencc_t m_od;
     unichar m_buffer[BUFFER_SIZE + 1];
 };
 
+/* an opencc handle and its buffer are used by one thread at a time, the
+ * handles of exited threads are kept for the next threads since opening
+ * one loads the dictionaries of opencc */
+static GMutex simp_trad_opencc_mutex;
+static std::vector<opencc *> simp_trad_opencc_idle;
+
+static void
+simp_trad_opencc_release (gpointer data)
+{
+    g_mutex_lock (&simp_trad_opencc_mutex);
+    simp_trad_opencc_idle.push_back (static_cast<opencc *> (data));
+    g_mutex_unlock (&simp_trad_opencc_mutex);
+}
+
+static GPrivate simp_trad_opencc_thread = G_PRIVATE_INIT (simp_trad_opencc_release);
+
+static opencc &
+simp_trad_opencc (void)
+{
+    opencc *od = static_cast<opencc *> (g_private_get (&simp_trad_opencc_thread));
+    if (G_LIKELY (od != NULL))
+        return *od;
+
+    g_mutex_lock (&simp_trad_opencc_mutex);
+    if (!simp_trad_opencc_idle.empty ()) {
+        od = simp_trad_opencc_idle.back ();
+        simp_trad_opencc_idle.pop_back ();
+    }
+    g_mutex_unlock (&simp_trad_opencc_mutex);
+
+    if (od == NULL)
+        od = new opencc;
+    g_private_set (&simp_trad_opencc_thread, od);
+    return *od;
+}
+
 void
 SimpTradConverter::simpToTrad (const char *in, String &out)
 {
-    static opencc opencc;
-    opencc.convert (in, out);
+    simp_trad_opencc ().convert (in, out);
 }
 
 #else
 
-static int _xcmp (const char *p1, const char *p2, const char *str)
+#include "SimpTradConverterTable.h"
+
+/* the simplified texts of simp_to_trad in a double-array trie over their
+ * utf-8 bytes, so the longest text at a position is found by one walk */
+class SimpTradTrie {
+public:
+    SimpTradTrie (void) : m_next_free (1)
+    {
+        std::vector<int> keys (G_N_ELEMENTS (simp_to_trad));
+        for (size_t i = 0; i < keys.size (); i++)
+            keys[i] = i;
+        std::sort (keys.begin (), keys.end (), keyLess);
+        m_ascii_free = (unsigned char) simp_to_trad[keys[0]][0][0] >= 0x80;
+
+        grow (256);
+        m_check[0] = 0;
+        build (0, keys, 0, keys.size (), 0);
+    }
+
+    /* returns the index in simp_to_trad of the longest simplified text at
+     * the head of p, or -1 */
+    int match (const char *p, size_t &len) const
+    {
+        const int size = m_check.size ();
+        int state = 0;
+        int index = -1;
+
+        for (size_t i = 0; p[i] != '\0'; i++) {
+            int next = m_base[state] + (unsigned char) p[i];
+            if (next >= size || m_check[next] != state)
+                break;
+            state = next;
+            if (m_value[state] >= 0) {
+                index = m_value[state];
+                len = i + 1;
+            }
+        }
+        return index;
+    }
+
+    /* like match (), for the bytes before end; more is set if a longer
+     * text may go on after end */
+    int match (const char *p, const char *end, size_t &len, bool &more) const
+    {
+        const int size = m_check.size ();
+        int state = 0;
+        int index = -1;
+
+        more = false;
+        for (size_t i = 0; p + i < end; i++) {
+            int next = m_base[state] + (unsigned char) p[i];
+            if (next >= size || m_check[next] != state)
+                return index;
+            state = next;
+            if (m_value[state] >= 0) {
+                index = m_value[state];
+                len = i + 1;
+            }
+        }
+        /* only the leaves have no base */
+        more = m_base[state] != 0;
+        return index;
+    }
+
+    /* no simplified text starts with an ascii byte */
+    bool asciiFree (void) const { return m_ascii_free; }
+
+private:
+    static bool keyLess (int a, int b)
+    {
+        return std::strcmp (simp_to_trad[a][0], simp_to_trad[b][0]) < 0;
+    }
+
+    void grow (size_t size)
+    {
+        if (size <= m_check.size ())
+            return;
+        m_base.resize (size, 0);
+        m_check.resize (size, -1);
+        m_value.resize (size, -1);
+    }
+
+    /* keys[begin, end) are the sorted texts which have the same depth bytes
+     * leading to state */
+    void build (int state, const std::vector<int> &keys,
+                size_t begin, size_t end, size_t depth)
+    {
+        if (simp_to_trad[keys[begin]][0][depth] == '\0')
+            m_value[state] = keys[begin++];
+        if (begin == end)
+            return;
+
+        std::vector<size_t> children;
+        for (size_t i = begin; i < end; i++) {
+            if (i == begin || simp_to_trad[keys[i]][0][depth] !=
+                              simp_to_trad[keys[i - 1]][0][depth])
+                children.push_back (i);
+        }
+
+        /* the first base putting every child on a free slot, tried only
+         * where the first child is free */
+        const int first = label (keys, children[0], depth);
+        int pos = MAX (m_next_free, first + 1) - 1;
+        int base;
+        size_t used = 0;
+        bool next_free = true;
+        for (;;) {
+            grow (++pos + 256);
+            if (m_check[pos] >= 0) {
+                used++;
+                continue;
+            }
+            if (next_free) {
+                m_next_free = pos;
+                next_free = false;
+            }
+
+            base = pos - first;
+            size_t i = 1;
+            while (i < children.size () &&
+                   m_check[base + label (keys, children[i], depth)] < 0)
+                i++;
+            if (i == children.size ())
+                break;
+        }
+
+        /* skips the slots which are almost all used */
+        if (used * 20 >= (size_t) (pos - m_next_free + 1) * 19)
+            m_next_free = pos;
+
+        m_base[state] = base;
+        for (size_t i = 0; i < children.size (); i++)
+            m_check[base + label (keys, children[i], depth)] = state;
+
+        for (size_t i = 0; i < children.size (); i++) {
+            build (base + label (keys, children[i], depth), keys, children[i],
+                   i + 1 < children.size () ? children[i + 1] : end, depth + 1);
+        }
+    }
+
+    static int label (const std::vector<int> &keys, size_t i, size_t depth)
+    {
+        return (unsigned char) simp_to_trad[keys[i]][0][depth];
+    }
+
+    std::vector<int> m_base;
+    std::vector<int> m_check;
+    std::vector<int> m_value;
+    int m_next_free;
+    bool m_ascii_free;
+};
+
+/* the trie is never changed once built, so all threads share it */
+static const SimpTradTrie &
+simp_trad_trie (void)
+{
+    static const SimpTradTrie trie;
+    return trie;
+}
+
+void
+SimpTradConverter::simpToTrad (const char *in, String &out)
 {
-    for (;;) {
-        // both reach end
-        if (p1 == p2 && *str == '\0')
-            return 0;
-        // p1 reaches end
-        if (p1 == p2)
-            return -1;
-        // str reaches end
-        if (*str == '\0')
-            return 1;
+    const SimpTradTrie &trie = simp_trad_trie ();
 
-        if (*p1 < *str)
-            return -1;
-        if (*p1 > *str)
-            return 1;
+    while (*in != '\0') {
+        size_t len;
+        int index = trie.match (in, len);
+        if (index >= 0) {
+            out << simp_to_trad[index][1];
+            in += len;
+            continue;
+        }
 
-        p1 ++; str ++;
-    };
+        /* copies a character without traditional text */
+        len = 1;
+        while ((in[len] & 0xc0) == 0x80)
+            len++;
+        out.append (in, len);
+        in += len;
+    }
 }
+#endif  // HAVE_OPENCC
 
-static int _cmp (const void * p1, const void * p2)
+/* the length of the ascii bytes at the head of text, at most len */
+static inline size_t
+ascii_len (const char *text, size_t len)
 {
-    const char **pp = (const char **) p1;
-    const char **s2 = (const char **) p2;
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 16 <= len; i += 16) {
+        __m128i bytes = _mm_loadu_si128 ((const __m128i *) (text + i));
+        int mask = _mm_movemask_epi8 (bytes);
+        if (mask != 0)
+            return i + g_bit_nth_lsf (mask, -1);
+    }
+#endif
+    while (i < len && (unsigned char) text[i] < 0x80)
+        i++;
+    return i;
+}
 
-    return _xcmp (pp[0], pp[1], s2[0]);
+/* the length of the character at the head of text, or 0 if it may go on
+ * after len bytes */
+static inline size_t
+char_len (const char *text, size_t len, bool last)
+{
+    size_t n = 1;
+    while (n < len && (text[n] & 0xc0) == 0x80)
+        n++;
+    if (n == len && n < 4 && !last)
+        return 0;
+    return n;
 }
 
-#include "SimpTradConverterTable.h"
+SimpTradStream::SimpTradStream (void)
+    : m_tail_len (0),
+      m_carry_pos (0)
+{
+}
 
 void
-SimpTradConverter::simpToTrad (const char *in, String &out)
+SimpTradStream::reset (void)
 {
-    const char *pend;
-    const char *pp[2];
-    size_t len;
-    size_t begin;
+    m_tail_len = 0;
+    m_carry.clear ();
+    m_carry_pos = 0;
+}
 
-    if (!g_utf8_validate (in, -1 , NULL)) {
-        g_warning ("\%s\" is not an utf8 string!", in);
-        g_assert_not_reached ();
-    }
+inline void
+SimpTradStream::write (const char *text, size_t len, char *&out, size_t &out_left)
+{
+    size_t n = MIN (len, out_left);
+    std::memcpy (out, text, n);
+    out += n;
+    out_left -= n;
+    if (n < len)
+        m_carry.append (text + n, len - n);
+}
 
-    begin = 0;
-    pend = in + std::strlen (in);
-    len = g_utf8_strlen (in, -1);   // length in charactoers
-    pp[0] = in;
+/* writes the output kept by the last call, returns true if all is written */
+inline bool
+SimpTradStream::writeCarry (char *&out, size_t &out_left)
+{
+    if (G_LIKELY (m_carry.empty ()))
+        return true;
 
-    while (pp[0] != pend) {
-        size_t slen  = std::min (len - begin, static_cast<size_t>(SIMP_TO_TRAD_MAX_LEN)); // the length of sub string in character
-        pp[1] = g_utf8_offset_to_pointer (pp[0], slen);    // the end of sub string
+    size_t n = MIN (m_carry.size () - m_carry_pos, out_left);
+    std::memcpy (out, m_carry.data () + m_carry_pos, n);
+    out += n;
+    out_left -= n;
+    m_carry_pos += n;
+    if (m_carry_pos < m_carry.size ())
+        return false;
 
-        for (;;) {
-            const char **result;
-            result = (const char **) std::bsearch (pp, simp_to_trad,
-                                            G_N_ELEMENTS (simp_to_trad), sizeof (simp_to_trad[0]),
-                                            _cmp);
-
-            if (result != NULL) {
-                // found item in table,
-                // append the trad to out and adjust pointers
-                out << result[1];
-                pp[0] = pp[1];
-                begin += slen;
-                break;
-            }
+    m_carry.clear ();
+    m_carry_pos = 0;
+    return true;
+}
+
+/* converts text until out is full, or until the text which may go on
+ * after len bytes unless it is the last; returns the bytes used */
+size_t
+SimpTradStream::convertText (const char *text, size_t len, bool last,
+                             char *&out, size_t &out_left)
+{
+    const char *p = text;
+    const char *end = text + len;
+
+#ifdef HAVE_OPENCC
+    while (p < end && out_left > 0) {
+        size_t n = ascii_len (p, MIN ((size_t) (end - p), out_left));
+        if (n > 0) {
+            std::memcpy (out, p, n);
+            out += n;
+            out_left -= n;
+            p += n;
+            continue;
+        }
 
-            if (slen == 1) {
-                // if only one character left,
-                // append origin character to out and adjust pointers
-                out.append (pp[0], pp[1] - pp[0]);
-                pp[0] = pp[1];
-                begin += 1;
+        /* opencc segments a run of other characters by itself */
+        while (p + n < end && (unsigned char) p[n] >= 0x80)
+            n++;
+        if (p + n == end && !last) {
+            if (n < TAIL_SIZE)
                 break;
+            /* a long run is cut after its last whole character */
+            size_t i = n - 1;
+            while (i > 0 && (p[i] & 0xc0) == 0x80)
+                i--;
+            if (char_len (p + i, n - i, false) == 0)
+                n = i;
+        }
+
+        /* invalid bytes are replaced */
+        m_ucs4.clear ();
+        for (const char *q = p; q < p + n; ) {
+            gunichar c = g_utf8_get_char_validated (q, p + n - q);
+            if (c == (gunichar) -1 || c == (gunichar) -2) {
+                c = 0xfffd;
+                q++;
+            }
+            else {
+                q = g_utf8_next_char (q);
             }
+            m_ucs4.push_back (c);
+        }
+
+        m_ucs4_out.clear ();
+        simp_trad_opencc ().convert ((ucs4_t *) &m_ucs4[0], m_ucs4.size (), m_ucs4_out);
+        m_text.clear ();
+        for (size_t i = 0; i < m_ucs4_out.size (); i++) {
+            char buf[6];
+            m_text.append (buf, g_unichar_to_utf8 (m_ucs4_out[i], buf));
+        }
+        write (m_text.data (), m_text.size (), out, out_left);
+        p += n;
+    }
+#else
+    const SimpTradTrie &trie = simp_trad_trie ();
+
+    while (p < end && out_left > 0) {
+        size_t n = 0;
+        if (trie.asciiFree ())
+            n = ascii_len (p, MIN ((size_t) (end - p), out_left));
+        if (n > 0) {
+            std::memcpy (out, p, n);
+            out += n;
+            out_left -= n;
+            p += n;
+            continue;
+        }
 
-            // if more than on characters left,
-            // adjust pp[1] to previous character
-            pp[1] = g_utf8_prev_char (pp[1]);
-            slen--;
+        bool more;
+        int index = trie.match (p, end, n, more);
+        if (more && !last)
+            break;
+        if (index >= 0) {
+            const char *trad = simp_to_trad[index][1];
+            write (trad, std::strlen (trad), out, out_left);
+            p += n;
+            continue;
         }
+
+        /* copies a character without traditional text */
+        n = char_len (p, end - p, last);
+        if (n == 0)
+            break;
+        write (p, n, out, out_left);
+        p += n;
     }
+#endif  // HAVE_OPENCC
+
+    return p - text;
 }
+
+void
+SimpTradStream::convert (const char *&in, size_t &in_left, char *&out, size_t &out_left)
+{
+    if (!writeCarry (out, out_left))
+        return;
+
+    while (m_tail_len > 0) {
+        /* the kept tail goes on in the chunk, the bytes of the chunk it
+         * does not use are given back */
+        const size_t kept = m_tail_len;
+        const size_t n = MIN (in_left, TAIL_SIZE - kept);
+        std::memcpy (m_tail + kept, in, n);
+        m_tail_len += n;
+
+        size_t used = convertText (m_tail, m_tail_len, false, out, out_left);
+        if (used >= kept) {
+            in += used - kept;
+            in_left -= used - kept;
+            m_tail_len = 0;
+            break;
+        }
+
+        if (out_left == 0) {
+            std::memmove (m_tail, m_tail + used, kept - used);
+            m_tail_len = kept - used;
+            return;
+        }
+
+        /* the chunk is too short to end the tail */
+        std::memmove (m_tail, m_tail + used, m_tail_len - used);
+        m_tail_len -= used;
+        in += n;
+        in_left -= n;
+        if (in_left == 0)
+            return;
+    }
+
+    size_t used = convertText (in, in_left, false, out, out_left);
+    in += used;
+    in_left -= used;
+    if (in_left > 0 && out_left > 0) {
+        /* the end of the chunk may go on in the next one */
+        g_assert (in_left <= TAIL_SIZE);
+        std::memcpy (m_tail, in, in_left);
+        m_tail_len = in_left;
+        in += in_left;
+        in_left = 0;
+    }
+}
+
+bool
+SimpTradStream::flush (char *&out, size_t &out_left)
+{
+    if (!writeCarry (out, out_left))
+        return false;
+
+    size_t used = convertText (m_tail, m_tail_len, true, out, out_left);
+    std::memmove (m_tail, m_tail + used, m_tail_len - used);
+    m_tail_len -= used;
+    return m_tail_len == 0 && m_carry.empty ();
+}
+
+static volatile gint phrase_cache_hits;
+static volatile gint phrase_cache_misses;
+
+#ifdef HAVE_OPENCC
+
+/* the phrases of the candidates of all contexts */
+#define PHRASE_CACHE_SIZE   (1024)
+
+typedef std::list<std::string> PhraseCacheList;
+struct PhraseCacheItem {
+    std::string trad;
+    PhraseCacheList::iterator lru;
+};
+typedef std::map<std::string, PhraseCacheItem> PhraseCache;
+
+static GMutex phrase_cache_mutex;
+static PhraseCache phrase_cache;
+static PhraseCacheList phrase_cache_lru;
+
+void
+SimpTradConverter::phraseToTrad (const char *phrase, std::string &out)
+{
+    const std::string simp (phrase);
+
+    g_mutex_lock (&phrase_cache_mutex);
+    PhraseCache::iterator it = phrase_cache.find (simp);
+    if (it != phrase_cache.end ()) {
+        phrase_cache_lru.splice (phrase_cache_lru.begin (),
+                                 phrase_cache_lru, it->second.lru);
+        out = it->second.trad;
+        g_mutex_unlock (&phrase_cache_mutex);
+        g_atomic_int_inc (&phrase_cache_hits);
+        return;
+    }
+    g_mutex_unlock (&phrase_cache_mutex);
+
+    g_atomic_int_inc (&phrase_cache_misses);
+    String trad;
+    simpToTrad (phrase, trad);
+    out = trad;
+
+    g_mutex_lock (&phrase_cache_mutex);
+    if (phrase_cache.find (simp) == phrase_cache.end ()) {
+        if (phrase_cache.size () >= PHRASE_CACHE_SIZE) {
+            phrase_cache.erase (phrase_cache_lru.back ());
+            phrase_cache_lru.pop_back ();
+        }
+        phrase_cache_lru.push_front (simp);
+        PhraseCacheItem &item = phrase_cache[simp];
+        item.trad = trad;
+        item.lru = phrase_cache_lru.begin ();
+    }
+    g_mutex_unlock (&phrase_cache_mutex);
+}
+
+#else
+
+/* the trie converts a phrase faster than a shared cache finds it */
+void
+SimpTradConverter::phraseToTrad (const char *phrase, std::string &out)
+{
+    g_atomic_int_inc (&phrase_cache_misses);
+    String trad;
+    simpToTrad (phrase, trad);
+    out = trad;
+}
+
 #endif  // HAVE_OPENCC
 
+unsigned int
+SimpTradConverter::cacheHits (void)
+{
+    return g_atomic_int_get (&phrase_cache_hits);
+}
+
+unsigned int
+SimpTradConverter::cacheMisses (void)
+{
+    return g_atomic_int_get (&phrase_cache_misses);
+}
+
 };  // namespace PyZy
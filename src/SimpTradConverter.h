@@ -22,13 +22,64 @@
 #ifndef __PYZY_SIMP_TRAD_CONVERTER_H_
 #define __PYZY_SIMP_TRAD_CONVERTER_H_
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 namespace PyZy {
 
 class String;
 
+/* the converters may be used by several threads at once; opencc builds
+ * give every thread a handle of its own */
 class SimpTradConverter {
 public:
     static void simpToTrad (const char *in, String &out);
+
+    /* converts a phrase of a candidate; opencc builds keep the phrases in an
+     * lru cache shared by all threads */
+    static void phraseToTrad (const char *phrase, std::string &out);
+
+    /* statistics of the phrase cache */
+    static unsigned int cacheHits (void);
+    static unsigned int cacheMisses (void);
+};
+
+/* converts a long text in chunks to the buffers of the caller, like iconv.
+ * The end of a chunk which may be the head of a longer simplified text is
+ * kept for the next chunk, and the output which does not fit is kept for
+ * the next call. The buffers are reused, so converting allocates nothing
+ * once they are grown. An instance is used by one thread at a time */
+class SimpTradStream {
+    static const size_t TAIL_SIZE = 64;
+public:
+    SimpTradStream (void);
+
+    /* converts the text of in until in_left or out_left is 0, the pointers
+     * and the sizes are advanced by the bytes used */
+    void convert (const char *&in, size_t &in_left, char *&out, size_t &out_left);
+
+    /* ends the text, returns true when all of it is written */
+    bool flush (char *&out, size_t &out_left);
+
+    /* drops the kept text to start another one */
+    void reset (void);
+
+private:
+    size_t convertText (const char *text, size_t len, bool last,
+                        char *&out, size_t &out_left);
+    void write (const char *text, size_t len, char *&out, size_t &out_left);
+    bool writeCarry (char *&out, size_t &out_left);
+
+    char m_tail[TAIL_SIZE];
+    size_t m_tail_len;
+    std::string m_carry;
+    size_t m_carry_pos;
+
+    /* buffers of opencc */
+    std::vector<unsigned int> m_ucs4;
+    std::vector<unsigned int> m_ucs4_out;
+    std::string m_text;
 };
 
 };  // namespace PyZy
@@ -82,6 +82,12 @@ public:
         return *this;
     }
 
+    String & insert (size_t i, const std::string & str, size_t len)
+    {
+        std::string::insert (i, str, 0, len);
+        return *this;
+    }
+
     String & truncate (size_t len)
     {
         erase(len);
@@ -86,6 +86,15 @@ namespace PyZy {
 #define PINYIN_ID_UO    (55)
 #define PINYIN_ID_V     (56)
 #define PINYIN_ID_NG    PINYIN_ID_VOID
+#define PINYIN_ID_NUM   (57)
+
+/* A set of pinyin ids. Sheng and yun ids do not overlap, so one set holds
+ * both the shengs and the yuns a syllable may match. */
+typedef unsigned long long PinyinIdSet;
+
+#define PINYIN_ID_BIT(id)   (1ULL << (id))
+#define PINYIN_SHENG_MASK   (PINYIN_ID_BIT (PINYIN_ID_A) - 1)
+#define PINYIN_YUN_MASK     (PINYIN_ID_BIT (PINYIN_ID_NUM) - 1 - PINYIN_SHENG_MASK)
 
 struct Pinyin {
     const char *text;
@@ -0,0 +1,223 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#include "UserDBWriter.h"
+
+#include <sqlite3.h>
+
+#include "String.h"
+
+namespace PyZy {
+
+#define DB_WRITE_DELAY          (2)
+#define DB_CHECKPOINT_INTERVAL  (64)
+
+UserDBWriter::UserDBWriter (void)
+    : m_db (NULL)
+    , m_thread (NULL)
+    , m_queued (0)
+    , m_written (0)
+    , m_flush (false)
+    , m_stop (false)
+{
+    g_mutex_init (&m_mutex);
+    g_cond_init (&m_cond);
+}
+
+UserDBWriter::~UserDBWriter (void)
+{
+    stop ();
+    g_cond_clear (&m_cond);
+    g_mutex_clear (&m_mutex);
+}
+
+bool
+UserDBWriter::start (const char *filename)
+{
+    g_assert (m_thread == NULL);
+
+    String sql;
+    do {
+        unsigned int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+        if (sqlite3_open_v2 (":memory:", &m_db, flags, NULL) != SQLITE_OK)
+            break;
+
+        /* attach the file as userdb, so the sql of the memory copy of the
+         * user database runs here as it is */
+        char *path = sqlite3_mprintf ("%Q", filename);
+        sql = "ATTACH DATABASE ";
+        sql << path << " AS userdb;\n";
+        sqlite3_free (path);
+        sql << "PRAGMA userdb.journal_mode=WAL;\n";
+        sql << "PRAGMA userdb.synchronous=FULL;\n";
+        if (!executeSQL (sql))
+            break;
+
+        m_stop = false;
+        m_thread = g_thread_try_new ("pyzy-userdb", UserDBWriter::threadFunc, this, NULL);
+        if (m_thread == NULL)
+            break;
+        return true;
+    } while (0);
+
+    g_warning ("can not write user database %s", filename);
+    if (m_db) {
+        sqlite3_close (m_db);
+        m_db = NULL;
+    }
+    return false;
+}
+
+void
+UserDBWriter::stop (void)
+{
+    if (m_thread == NULL)
+        return;
+
+    g_mutex_lock (&m_mutex);
+    m_stop = true;
+    g_cond_broadcast (&m_cond);
+    g_mutex_unlock (&m_mutex);
+
+    g_thread_join (m_thread);
+    m_thread = NULL;
+
+    sqlite3_close (m_db);
+    m_db = NULL;
+}
+
+void
+UserDBWriter::write (const std::string &sql)
+{
+    if (m_thread == NULL)
+        return;
+
+    g_mutex_lock (&m_mutex);
+    m_changes.push_back (sql);
+    m_queued ++;
+    g_cond_broadcast (&m_cond);
+    g_mutex_unlock (&m_mutex);
+}
+
+void
+UserDBWriter::flush (void)
+{
+    if (m_thread == NULL)
+        return;
+
+    g_mutex_lock (&m_mutex);
+    guint64 queued = m_queued;
+    m_flush = true;
+    g_cond_broadcast (&m_cond);
+    while (m_written < queued)
+        g_cond_wait (&m_cond, &m_mutex);
+    g_mutex_unlock (&m_mutex);
+}
+
+gpointer
+UserDBWriter::threadFunc (gpointer data)
+{
+    static_cast<UserDBWriter *> (data)->run ();
+    return NULL;
+}
+
+void
+UserDBWriter::run (void)
+{
+    std::vector<std::string> changes;
+    size_t batches = 0;
+
+    g_mutex_lock (&m_mutex);
+    while (true) {
+        while (m_changes.empty () && !m_stop)
+            g_cond_wait (&m_cond, &m_mutex);
+        if (m_changes.empty ())
+            break;
+
+        /* wait a while to write changes of several commits together */
+        gint64 deadline = g_get_monotonic_time () + DB_WRITE_DELAY * G_USEC_PER_SEC;
+        while (!m_stop && !m_flush) {
+            if (!g_cond_wait_until (&m_cond, &m_mutex, deadline))
+                break;
+        }
+        m_flush = false;
+
+        changes.swap (m_changes);
+        g_mutex_unlock (&m_mutex);
+
+        writeChanges (changes);
+        if (++batches % DB_CHECKPOINT_INTERVAL == 0)
+            executeSQL ("PRAGMA userdb.wal_checkpoint(PASSIVE);");
+
+        g_mutex_lock (&m_mutex);
+        m_written += changes.size ();
+        changes.clear ();
+        g_cond_broadcast (&m_cond);
+    }
+    g_mutex_unlock (&m_mutex);
+
+    /* move all changes into the database file before it is closed */
+    executeSQL ("PRAGMA userdb.wal_checkpoint(TRUNCATE);");
+}
+
+void
+UserDBWriter::writeChanges (const std::vector<std::string> &changes)
+{
+    String sql;
+
+    sql = "BEGIN TRANSACTION;\n";
+    for (size_t i = 0; i < changes.size (); i++)
+        sql << changes[i];
+    sql << "COMMIT;\n";
+    if (executeSQL (sql))
+        return;
+
+    /* do not lose the other changes of the batch for a bad one */
+    rollback ();
+    for (size_t i = 0; i < changes.size (); i++) {
+        sql = "BEGIN TRANSACTION;\n";
+        sql << changes[i];
+        sql << "COMMIT;\n";
+        if (!executeSQL (sql))
+            rollback ();
+    }
+}
+
+void
+UserDBWriter::rollback (void)
+{
+    if (!sqlite3_get_autocommit (m_db))
+        executeSQL ("ROLLBACK;");
+}
+
+bool
+UserDBWriter::executeSQL (const char *sql)
+{
+    char *errmsg = NULL;
+    if (sqlite3_exec (m_db, sql, NULL, NULL, &errmsg) != SQLITE_OK) {
+        g_warning ("%s: %s", errmsg, sql);
+        sqlite3_free (errmsg);
+        return false;
+    }
+    return true;
+}
+
+};  // namespace PyZy
@@ -0,0 +1,80 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#ifndef __PYZY_USER_DB_WRITER_H_
+#define __PYZY_USER_DB_WRITER_H_
+
+#include <glib.h>
+#include <string>
+#include <vector>
+
+typedef struct sqlite3 sqlite3;
+
+namespace PyZy {
+
+/*
+ * UserDBWriter writes the changes of the user database to its file on a
+ * background thread. The changes are sql on the userdb schema, queued by
+ * the input thread and written in one transaction per batch, so the file
+ * is never copied as a whole and the input thread never waits for disk.
+ * The file is in WAL mode, a change reaches the disk at most
+ * DB_WRITE_DELAY seconds after it is queued.
+ */
+class UserDBWriter {
+public:
+    UserDBWriter (void);
+    ~UserDBWriter (void);
+
+    /* opens the user database file and starts the writer thread */
+    bool start (const char *filename);
+    /* writes pending changes and stops the writer thread */
+    void stop (void);
+    bool isStarted (void) const { return m_thread != NULL; }
+
+    /* queues sql changing the user database */
+    void write (const std::string &sql);
+    /* waits until all queued changes are written */
+    void flush (void);
+
+private:
+    static gpointer threadFunc (gpointer data);
+    void run (void);
+    void writeChanges (const std::vector<std::string> &changes);
+    void rollback (void);
+    bool executeSQL (const char *sql);
+
+private:
+    sqlite3 *m_db;
+    GThread *m_thread;
+    GMutex m_mutex;
+    GCond m_cond;
+
+    /* guarded by m_mutex */
+    std::vector<std::string> m_changes;
+    guint64 m_queued;
+    guint64 m_written;
+    bool m_flush;
+    bool m_stop;
+};
+
+};  // namespace PyZy
+
+#endif  // __PYZY_USER_DB_WRITER_H_
@@ -20,12 +20,20 @@
  * USA
  */
 #include <glib/gstdio.h>
+#include <sqlite3.h>
 
+#include <cstring>
 #include <iostream>
 #include <algorithm>
 
+#include "BatchConverter.h"
 #include "Config.h"
+#include "Database.h"
 #include "InputContext.h"
+#include "PhraseDict.h"
+#include "PinyinParser.h"
+#include "SimpTradConverter.h"
+#include "String.h"
 #include "Util.h"  // for unique_ptr
 #include "Variant.h"
 
@@ -35,14 +43,14 @@ using namespace PyZy;
 
 class DummyObserver : public PyZy::InputContext::Observer {
 public:
-    void commitText (const InputContext *context, const std::string &commit_text) {
+    void commitText (InputContext *context, const std::string &commit_text) override {
         m_commited_text = commit_text;
     }
-    void inputTextChanged (const InputContext *context) {}
-    void preeditTextChanged (const InputContext *context) {}
-    void auxiliaryTextChanged (const InputContext *context) {}
-    void candidatesChanged (const InputContext *context) {}
-    void cursorChanged (const InputContext *context) {}
+    void inputTextChanged (InputContext *context) override {}
+    void preeditTextChanged (InputContext *context) override {}
+    void auxiliaryTextChanged (InputContext *context) override {}
+    void candidatesChanged (InputContext *context) override {}
+    void cursorChanged (InputContext *context) override {}
 
     string commitedText ()         { return m_commited_text; }
 
@@ -62,7 +70,7 @@ void insertKeys (InputContext *context, const string &keys) {
 #define g_assert_cmpstring(s1, cmp, s2) \
     g_assert_cmpstr (s1.c_str(), cmp, s2)
 
-int testFullPinyin ()
+void testFullPinyin ()
 {
     DummyObserver observer;
     unique_ptr<InputContext> context;
@@ -355,6 +363,72 @@ int testFullPinyin ()
         g_assert (!context->hasCandidate (0));
         g_assert_cmpstring (observer.commitedText (), ==, "啊啊nihao");
     }
+
+    {  // Sentence with the fewest phrases
+        DummyObserver observer;
+        unique_ptr<InputContext> context;
+        context.reset (
+            InputContext::create (InputContext::FULL_PINYIN, &observer));
+
+        insertKeys (context.get (), "yigejinzita");
+        g_assert_cmpstring (context->conversionText (), ==, "一个金字塔");
+        g_assert_cmpstring (context->auxiliaryText (), ==, "yi ge jin zi ta|");
+
+        context->removeCharBefore ();
+        context->removeCharBefore ();
+        insertKeys (context.get (), "ta");
+        g_assert_cmpstring (context->conversionText (), ==, "一个金字塔");
+    }
+}
+
+void testIncrementalParse ()
+{
+    // Pieces which are resplit by the parser, like "xian" and "xi'an".
+    static const char * const pieces[] = {
+        "a", "an", "ang", "e", "en", "eng", "er", "i", "o", "ou", "u", "v",
+        "g", "n", "r", "na", "ge", "gan", "ren", "xian", "gu", "zh", "'",
+    };
+    const unsigned int options[] = {
+        0,
+        Config ().option,
+    };
+    guint32 seed = 1;
+
+    // Parsing the tail after random edits gives the same result as
+    // parsing the whole text.
+    for (size_t i = 0; i < G_N_ELEMENTS (options); ++i) {
+        String text;
+        PinyinArray incremental;
+        for (int round = 0; round < 5000; ++round) {
+            seed = seed * 1103515245 + 12345;
+            size_t edit = text.empty () ? 0 : (seed >> 8) % (text.size () + 1);
+            seed = seed * 1103515245 + 12345;
+            if (text.size () < 32 && ((seed >> 8) % 3 != 0 || text.empty ())) {
+                seed = seed * 1103515245 + 12345;
+                const string piece = pieces[(seed >> 8) % G_N_ELEMENTS (pieces)];
+                text.insert (edit, piece, piece.size ());
+            }
+            else {
+                seed = seed * 1103515245 + 12345;
+                size_t n = MIN (1 + (seed >> 8) % 4, text.size () - MIN (edit, text.size () - 1));
+                edit = MIN (edit, text.size () - 1);
+                text.erase (edit, n);
+            }
+
+            PinyinArray full;
+            size_t full_len = PinyinParser::parse (
+                text, text.size (), options[i], full, MAX_PHRASE_LEN);
+            size_t len = PinyinParser::parse (
+                text, text.size (), options[i], incremental, MAX_PHRASE_LEN, edit);
+            g_assert_cmpuint (len, ==, full_len);
+            g_assert_cmpuint (incremental.size (), ==, full.size ());
+            for (size_t j = 0; j < full.size (); ++j) {
+                g_assert (incremental[j].pinyin == full[j].pinyin);
+                g_assert_cmpuint (incremental[j].begin, ==, full[j].begin);
+                g_assert_cmpuint (incremental[j].len, ==, full[j].len);
+            }
+        }
+    }
 }
 
 void testDoublePinyin()
@@ -623,7 +697,7 @@ void testDoublePinyin()
         g_assert_cmpint (context->cursor (), ==, 8);
         g_assert_cmpstring (context->inputText (), ==, "aazhnihk");
         g_assert_cmpstring (context->selectedText (), ==, "");
-        g_assert_cmpstring (context->conversionText (), ==, "啊站立好");
+        g_assert_cmpstring (context->conversionText (), ==, "啊张你好");
         g_assert_cmpstring (context->restText (), ==, "");
         g_assert_cmpstring (context->auxiliaryText (), ==, "a zang ni hao|");
         g_assert (context->hasCandidate (0));
@@ -634,7 +708,7 @@ void testDoublePinyin()
         g_assert_cmpint (context->cursor (), ==, 8);
         g_assert_cmpstring (context->inputText (), ==, "aazhnihk");
         g_assert_cmpstring (context->selectedText (), ==, "啊");
-        g_assert_cmpstring (context->conversionText (), ==, "站立好");
+        g_assert_cmpstring (context->conversionText (), ==, "张你好");
         g_assert_cmpstring (context->restText (), ==, "");
         g_assert_cmpstring (context->auxiliaryText (), ==, "zang ni hao|");
         g_assert (context->hasCandidate (0));
@@ -1033,6 +1107,172 @@ void testCommit ()
     }
 }
 
+void testQueryCache ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+
+    insertKeys (context.get (), "nihao");
+    g_assert_cmpstring (context->conversionText (), ==, "你好");
+    context->removeCharBefore ();
+
+    // Typing the removed character again is served by the cache.
+    unsigned int hits = InputContext::queryCacheHits ();
+    unsigned int misses = InputContext::queryCacheMisses ();
+    context->insert ('o');
+    g_assert_cmpstring (context->conversionText (), ==, "你好");
+    g_assert_cmpuint (InputContext::queryCacheHits (), >, hits);
+    g_assert_cmpuint (InputContext::queryCacheMisses (), ==, misses);
+
+    // Learning a phrase flushes the cache.
+    observer.clear ();
+    context->selectCandidate (1);
+    g_assert_cmpstring (observer.commitedText (), !=, "");
+
+    misses = InputContext::queryCacheMisses ();
+    insertKeys (context.get (), "nihao");
+    g_assert_cmpuint (InputContext::queryCacheMisses (), >, misses);
+
+    // Disabled cache
+    context->reset ();
+    InputContext::setQueryCacheSize (0);
+    hits = InputContext::queryCacheHits ();
+    insertKeys (context.get (), "nihao");
+    g_assert_cmpuint (InputContext::queryCacheHits (), ==, hits);
+}
+
+void testStmtCache ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    InputContext::setQueryCacheSize (0);
+
+    // The user database is queried by sqlite, the second time by the
+    // statements prepared the first time.
+    insertKeys (context.get (), "nihao");
+    context->reset ();
+    unsigned int hits = InputContext::stmtCacheHits ();
+    unsigned int misses = InputContext::stmtCacheMisses ();
+    insertKeys (context.get (), "nihao");
+    g_assert_cmpstring (context->conversionText (), ==, "你好");
+    g_assert_cmpuint (InputContext::stmtCacheHits (), >, hits);
+    g_assert_cmpuint (InputContext::stmtCacheMisses (), ==, misses);
+
+    InputContext::setQueryCacheSize (256);
+}
+
+void testPhraseFilter ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+
+    // No phrase has three syllables "ka", the span is not looked up.
+    unsigned int skips = InputContext::phraseFilterSkips ();
+    insertKeys (context.get (), "kakaka");
+    g_assert_cmpuint (InputContext::phraseFilterSkips (), >, skips);
+    g_assert_cmpuint (InputContext::phraseFilterMemory (), >, 0);
+    g_assert (InputContext::phraseFilterFalsePositiveRate () < 0.05);
+
+    // A learned phrase is added to the filter.
+    observer.clear ();
+    while (observer.commitedText ().empty ())
+        context->selectCandidate (0);
+    const string learned = observer.commitedText ();
+    g_assert_cmpuint (g_utf8_strlen (learned.c_str (), -1), ==, 3);
+
+    skips = InputContext::phraseFilterSkips ();
+    insertKeys (context.get (), "kakaka");
+    g_assert_cmpuint (InputContext::phraseFilterSkips (), ==, skips);
+    g_assert_cmpstring (context->conversionText (), ==, learned.c_str ());
+}
+
+void testAbbreviation ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+
+    insertKeys (context.get (), "zgr");
+    g_assert_cmpstring (context->conversionText (), ==, "中国人");
+    context->reset ();
+
+    // A phrase learned from initials goes first.
+    insertKeys (context.get (), "zg");
+    Candidate candidate;
+    g_assert (context->getCandidate (1, candidate));
+    const string learned = candidate.text;
+    g_assert_cmpstring (learned, !=, context->conversionText ().c_str ());
+
+    observer.clear ();
+    context->selectCandidate (1);
+    g_assert_cmpstring (observer.commitedText (), ==, learned.c_str ());
+
+    insertKeys (context.get (), "zg");
+    g_assert_cmpstring (context->conversionText (), ==, learned.c_str ());
+}
+
+vector<string> getCandidates (InputContext *context)
+{
+    vector<string> candidates;
+    Candidate candidate;
+    for (size_t i = 0; context->getCandidate (i, candidate); ++i)
+        candidates.push_back (candidate.text);
+    return candidates;
+}
+
+void testFirstCandidatePath ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    context->setProperty (InputContext::PROPERTY_SPECIAL_PHRASE,
+                          Variant::fromBool (false));
+
+    // A rare long first phrase loses to a split into common phrases.
+    insertKeys (context.get (), "xianguojia");
+    g_assert_cmpstring (context->auxiliaryText (), ==, "xian guo jia|");
+    g_assert_cmpstring (context->conversionText (), ==, "想国家");
+
+    context->reset ();
+    insertKeys (context.get (), "zangnihao");
+    g_assert_cmpstring (context->conversionText (), ==, "张你好");
+
+    // Fewer phrases still win over common single characters.
+    context->reset ();
+    insertKeys (context.get (), "dianshiji");
+    g_assert_cmpstring (context->conversionText (), ==, "电视机");
+}
+
+void testCandidateOrder ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+
+    // Phrases are grouped by length, longest first.
+    insertKeys (context.get (), "nihaoshijie");
+    const vector<string> candidates = getCandidates (context.get ());
+    g_assert_cmpuint (candidates.size (), >, 10);
+    for (size_t i = 2; i < candidates.size (); ++i) {
+        g_assert_cmpuint (g_utf8_strlen (candidates[i - 1].c_str (), -1), >=,
+                          g_utf8_strlen (candidates[i].c_str (), -1));
+    }
+
+    // Lengths served by the query cache give the same candidates.
+    context->removeCharBefore ();
+    context->insert ('e');
+    g_assert (getCandidates (context.get ()) == candidates);
+}
+
 string getTestDir ()
 {
     const char *kPyZyTestDirName = "__pyzy_test_dir__";
@@ -1080,12 +1320,871 @@ void tearDown ()
     removeDirectory (getTestDir ());
 }
 
+// Writes a main database of the phrases of "nihao", with the scale of its
+// freq in the desc table if freq_per_e is not 0. It has no phrases of the
+// syllables typed before "nihao" is complete, so it is inserted at once.
+void createMainDB (const string &file, int freq_per_e, int freq_zero)
+{
+    static const struct {
+        const char *phrase;
+        size_t begin;
+        size_t len;
+        int freq;
+    } phrases[] = {
+        { "泥", 0, 1, 1000 }, { "号", 1, 1, 1000 }, { "你好", 0, 2, 100 },
+    };
+    PinyinArray pinyin;
+    g_assert_cmpuint (PinyinParser::parse ("nihao", 5, 0, pinyin, MAX_PHRASE_LEN), ==, 5);
+    g_assert_cmpuint (pinyin.size (), ==, 2);
+
+    String sql ("BEGIN TRANSACTION;\n");
+    for (size_t i = 0; i < MAX_PHRASE_LEN; ++i) {
+        sql << "CREATE TABLE py_phrase_" << i << " (phrase TEXT, freq INTEGER";
+        for (size_t j = 0; j <= i; ++j)
+            sql << ",s" << j << " INTEGER,y" << j << " INTEGER";
+        sql << ",trad TEXT);\n";
+    }
+    for (size_t i = 0; i < G_N_ELEMENTS (phrases); ++i) {
+        sql << "INSERT INTO py_phrase_" << phrases[i].len - 1 << " VALUES ('"
+            << phrases[i].phrase << "'," << phrases[i].freq;
+        for (size_t j = 0; j < phrases[i].len; ++j) {
+            const Pinyin *p = pinyin[phrases[i].begin + j].pinyin;
+            sql << ',' << p->pinyin_id[0].sheng << ',' << p->pinyin_id[0].yun;
+        }
+        sql << ",NULL);\n";
+    }
+    if (freq_per_e != 0) {
+        sql << "CREATE TABLE desc (name PRIMARY KEY, value TEXT);\n"
+            << "INSERT INTO desc VALUES ('freq-per-e','" << freq_per_e << "');\n"
+            << "INSERT INTO desc VALUES ('freq-zero','" << freq_zero << "');\n";
+    }
+    sql << "COMMIT;";
+
+    g_unlink (file.c_str ());
+    sqlite3 *db = NULL;
+    g_assert (sqlite3_open (file.c_str (), &db) == SQLITE_OK);
+    g_assert (sqlite3_exec (db, sql, NULL, NULL, NULL) == SQLITE_OK);
+    sqlite3_close (db);
+}
+
+void testFreqScale ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+    const string file = getTestDir () + G_DIR_SEPARATOR_S "main.db";
+    InputContext::finalize ();
+
+    // Without the scale of freq the path of the fewest phrases wins.
+    createMainDB (file, 0, 0);
+    Database::init (getTestDir (), false, file);
+    g_assert_cmpuint (Database::instance ().freqPerE (), ==, 0);
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    g_assert (context->insert ("nihao"));
+    g_assert_cmpstring (context->conversionText (), ==, "你好");
+    context.reset ();
+    InputContext::finalize ();
+
+    // By its own scale the rare phrase is e^-9 of the texts, and loses to
+    // the common ones, while it would win by the scale of android.db.
+    createMainDB (file, 100, 1000);
+    Database::init (getTestDir (), false, file);
+    g_assert_cmpuint (Database::instance ().freqPerE (), ==, 100);
+    g_assert_cmpint (Database::instance ().freqZero (), ==, 1000);
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    g_assert (context->insert ("nihao"));
+    g_assert_cmpstring (context->conversionText (), ==, "泥号");
+    context.reset ();
+}
+
+void testUserDB ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+
+    // Learn the second candidate of "nihao".
+    insertKeys (context.get (), "nihao");
+    Candidate candidate;
+    g_assert (context->getCandidate (1, candidate));
+    const string learned = candidate.text;
+    g_assert_cmpstring (learned, !=, context->conversionText ().c_str ());
+
+    observer.clear ();
+    context->selectCandidate (1);
+    g_assert_cmpstring (observer.commitedText (), ==, learned.c_str ());
+    context.reset ();
+
+    // The phrase is written to the user database file, and loaded again.
+    InputContext::finalize ();
+    InputContext::init (getTestDir (), getTestDir ());
+
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    insertKeys (context.get (), "nihao");
+    g_assert_cmpstring (context->conversionText (), ==, learned.c_str ());
+}
+
+void testLazyUserDB ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+    Candidate candidate;
+
+    // Learn a phrase, and load the user database lazily.
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    insertKeys (context.get (), "nihao");
+    g_assert (context->getCandidate (1, candidate));
+    const string learned = candidate.text;
+    context->selectCandidate (1);
+    context.reset ();
+
+    InputContext::finalize ();
+    InputContext::init (getTestDir (), getTestDir (), true);
+
+    // Learn another phrase, maybe before the user database is loaded.
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    insertKeys (context.get (), "shijie");
+    g_assert (context->getCandidate (1, candidate));
+    const string learned_lazily = candidate.text;
+    context->selectCandidate (1);
+    context.reset ();
+
+    // Both phrases are kept.
+    InputContext::finalize ();
+    InputContext::init (getTestDir (), getTestDir ());
+
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    insertKeys (context.get (), "nihao");
+    g_assert_cmpstring (context->conversionText (), ==, learned.c_str ());
+    context->reset ();
+    insertKeys (context.get (), "shijie");
+    g_assert_cmpstring (context->conversionText (), ==, learned_lazily.c_str ());
+}
+
+void testWarmUp ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+
+    // The first conversion cancels the warm up, and gets the same result.
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    insertKeys (context.get (), "nihao");
+    const string expected = context->conversionText ();
+    context.reset ();
+
+    InputContext::finalize ();
+    InputContext::init (getTestDir (), getTestDir ());
+    InputContext::warmUp (0, 0);
+
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    insertKeys (context.get (), "nihao");
+    g_assert_cmpstring (context->conversionText (), ==, expected.c_str ());
+
+    // A warm up with a budget is stopped by finalize.
+    InputContext::warmUp (4096, 1);
+    context.reset ();
+}
+
+void testSessions ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> fresh;
+    unique_ptr<InputContext> contexts[8];
+    const char *inputs[] = { "nihao", "shijie", "zhongguoren", "ni" };
+    string expected[G_N_ELEMENTS (inputs)];
+    size_t candidates[G_N_ELEMENTS (inputs)];
+
+    for (size_t i = 0; i < G_N_ELEMENTS (inputs); i++) {
+        fresh.reset (
+            InputContext::create (InputContext::FULL_PINYIN, &observer));
+        insertKeys (fresh.get (), inputs[i]);
+        expected[i] = fresh->conversionText ();
+        for (candidates[i] = 0; fresh->hasCandidate (candidates[i]); candidates[i]++);
+    }
+
+    // Sessions take the storage released by the others, in any order, and
+    // get the same conversions as a fresh context.
+    for (size_t i = 0; i < G_N_ELEMENTS (contexts); i++)
+        contexts[i].reset (
+            InputContext::create (InputContext::FULL_PINYIN, &observer));
+    for (size_t round = 0; round < 3; round++) {
+        for (size_t i = 0; i < G_N_ELEMENTS (contexts); i++) {
+            size_t j = (i + round) % G_N_ELEMENTS (inputs);
+            insertKeys (contexts[i].get (), inputs[j]);
+            g_assert_cmpstring (contexts[i]->conversionText (), ==, expected[j].c_str ());
+            size_t n = 0;
+            while (contexts[i]->hasCandidate (n))
+                n++;
+            g_assert_cmpuint (n, ==, candidates[j]);
+            if (i % 2 == 0)
+                contexts[i]->reset ();
+        }
+        for (size_t i = 1; i < G_N_ELEMENTS (contexts); i += 2) {
+            g_assert_cmpstring (contexts[i]->inputText (), !=, "");
+            contexts[i]->reset ();
+            g_assert_cmpstring (contexts[i]->inputText (), ==, "");
+            g_assert_cmpstring (contexts[i]->conversionText (), ==, "");
+        }
+    }
+}
+
+struct TypingThread {
+    GThread *thread;
+    GAsyncQueue *keys;
+    GAsyncQueue *texts;
+};
+
+/* converts the keys pushed to it by a context of its own, keys starting
+ * with '+' commit the second candidate. An empty string stops it */
+gpointer typingThread (gpointer data)
+{
+    TypingThread *typing = static_cast<TypingThread *> (data);
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+
+    for (;;) {
+        const char *keys = static_cast<const char *> (g_async_queue_pop (typing->keys));
+        if (*keys == '\0')
+            break;
+
+        context->reset ();
+        if (*keys == '+') {
+            insertKeys (context.get (), keys + 1);
+            observer.clear ();
+            context->selectCandidate (1);
+            g_async_queue_push (typing->texts, new string (observer.commitedText ()));
+        }
+        else {
+            insertKeys (context.get (), keys);
+            g_async_queue_push (typing->texts, new string (context->conversionText ()));
+        }
+    }
+    return NULL;
+}
+
+string convertByThread (TypingThread &typing, const char *keys)
+{
+    g_async_queue_push (typing.keys, (gpointer) keys);
+    unique_ptr<string> text (static_cast<string *> (g_async_queue_pop (typing.texts)));
+    return *text;
+}
+
+void startTypingThread (TypingThread &typing)
+{
+    typing.keys = g_async_queue_new ();
+    typing.texts = g_async_queue_new ();
+    typing.thread = g_thread_new ("typing", typingThread, &typing);
+}
+
+void stopTypingThread (TypingThread &typing)
+{
+    g_async_queue_push (typing.keys, (gpointer) "");
+    g_thread_join (typing.thread);
+    g_async_queue_unref (typing.keys);
+    g_async_queue_unref (typing.texts);
+}
+
+void testThreads ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+    Candidate candidate;
+    TypingThread threads[4];
+
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    insertKeys (context.get (), "nihao");
+    const string expected = context->conversionText ();
+    g_assert (context->getCandidate (1, candidate));
+    const string learned = candidate.text;
+    context->reset ();
+
+    // Every thread converts by its own reader.
+    for (size_t i = 0; i < G_N_ELEMENTS (threads); i++)
+        startTypingThread (threads[i]);
+    for (size_t i = 0; i < G_N_ELEMENTS (threads); i++)
+        g_assert_cmpstring (convertByThread (threads[i], "nihao"), ==, expected.c_str ());
+
+    // A phrase learned by the main thread is seen by the other threads.
+    insertKeys (context.get (), "nihao");
+    context->selectCandidate (1);
+    for (size_t i = 0; i < G_N_ELEMENTS (threads); i++)
+        g_assert_cmpstring (convertByThread (threads[i], "nihao"), ==, learned.c_str ());
+
+    // A phrase learned by another thread is seen by the main thread, the
+    // other threads, and a thread started later.
+    const string learned_by_thread = convertByThread (threads[0], "+shijie");
+    g_assert_cmpstring (learned_by_thread, !=, "");
+    insertKeys (context.get (), "shijie");
+    g_assert_cmpstring (context->conversionText (), ==, learned_by_thread.c_str ());
+    for (size_t i = 1; i < G_N_ELEMENTS (threads); i++)
+        g_assert_cmpstring (convertByThread (threads[i], "shijie"), ==, learned_by_thread.c_str ());
+
+    stopTypingThread (threads[0]);
+    startTypingThread (threads[0]);
+    g_assert_cmpstring (convertByThread (threads[0], "shijie"), ==, learned_by_thread.c_str ());
+
+    for (size_t i = 0; i < G_N_ELEMENTS (threads); i++)
+        stopTypingThread (threads[i]);
+}
+
+class CountingObserver : public DummyObserver {
+public:
+    CountingObserver () : m_legacy (0), m_batches (0), m_changes (0) {}
+
+    void inputTextChanged (InputContext *context) override     { m_legacy++; }
+    void preeditTextChanged (InputContext *context) override   { m_legacy++; }
+    void auxiliaryTextChanged (InputContext *context) override { m_legacy++; }
+    void candidatesChanged (InputContext *context) override    { m_legacy++; }
+    void cursorChanged (InputContext *context) override        { m_legacy++; }
+    void stateChanged (InputContext *context, unsigned int changes) override {
+        m_batches++;
+        m_changes = changes;
+    }
+
+    void clear () {
+        DummyObserver::clear ();
+        m_legacy = m_batches = m_changes = 0;
+    }
+
+    size_t          m_legacy;
+    size_t          m_batches;
+    unsigned int    m_changes;
+};
+
+void testBatchChanges ()
+{
+    CountingObserver observer;
+    unique_ptr<InputContext> context;
+    const unsigned int all_changes =
+        InputContext::INPUT_TEXT_CHANGED | InputContext::CURSOR_CHANGED |
+        InputContext::PREEDIT_TEXT_CHANGED |
+        InputContext::AUXILIARY_TEXT_CHANGED |
+        InputContext::CANDIDATES_CHANGED;
+
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    g_assert (!context->getProperty (
+        InputContext::PROPERTY_BATCH_CHANGES).getBool ());
+
+    // Without the property every change is notified by its own callback.
+    context->insert ('n');
+    g_assert_cmpint (observer.m_legacy, >, 1);
+    g_assert_cmpint (observer.m_batches, ==, 0);
+    context->reset ();
+
+    // With the property an operation is notified once.
+    g_assert (context->setProperty (InputContext::PROPERTY_BATCH_CHANGES,
+                                    Variant::fromBool (true)));
+    observer.clear ();
+    context->insert ('n');
+    g_assert_cmpint (observer.m_legacy, ==, 0);
+    g_assert_cmpint (observer.m_batches, ==, 1);
+    g_assert_cmpint (observer.m_changes, ==, all_changes);
+
+    const string keys = "ihao";
+    for (size_t i = 0; i < keys.size (); ++i) {
+        observer.clear ();
+        context->insert (keys[i]);
+        g_assert_cmpint (observer.m_batches, ==, 1);
+        g_assert (observer.m_changes & InputContext::INPUT_TEXT_CHANGED);
+    }
+    g_assert_cmpint (observer.m_legacy, ==, 0);
+    g_assert_cmpstring (context->conversionText (), ==, "你好");
+
+    // The same preedit text is not notified again.
+    observer.clear ();
+    g_assert (context->focusCandidate (0));
+    g_assert_cmpint (observer.m_batches, ==, 0);
+    g_assert (context->focusCandidate (1));
+    g_assert_cmpint (observer.m_batches, ==, 1);
+    g_assert_cmpint (observer.m_changes, ==,
+                     InputContext::PREEDIT_TEXT_CHANGED);
+
+    // An operation which changes nothing is not notified.
+    observer.clear ();
+    g_assert (!context->moveCursorToEnd ());
+    g_assert_cmpint (observer.m_batches, ==, 0);
+
+    // The commit text is still delivered during the operation.
+    observer.clear ();
+    context->commit ();
+    g_assert_cmpstring (observer.commitedText (), !=, "");
+    g_assert_cmpint (observer.m_batches, ==, 1);
+    g_assert_cmpint (observer.m_legacy, ==, 0);
+    g_assert (observer.m_changes & InputContext::PREEDIT_TEXT_CHANGED);
+
+    // The texts notified last are dropped with the context, the texts
+    // after it are notified again.
+    observer.clear ();
+    context->insert ('n');
+    g_assert (observer.m_changes & InputContext::PREEDIT_TEXT_CHANGED);
+    g_assert (observer.m_changes & InputContext::AUXILIARY_TEXT_CHANGED);
+    context->reset ();
+
+    // Bopomofo computes its own texts as well.
+    context.reset (
+        InputContext::create (InputContext::BOPOMOFO, &observer));
+    context->setProperty (InputContext::PROPERTY_BATCH_CHANGES,
+                          Variant::fromBool (true));
+    observer.clear ();
+    insertKeys (context.get (), "sucl");
+    g_assert_cmpint (observer.m_batches, ==, 4);
+    g_assert_cmpint (observer.m_legacy, ==, 0);
+    g_assert_cmpstring (context->conversionText (), ==, "你好");
+    g_assert_cmpstring (context->auxiliaryText (), ==, "ㄋㄧ,ㄏㄠ|");
+}
+
+void testBulkEdit ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context;
+
+    {  // Full pinyin
+        context.reset (
+            InputContext::create (InputContext::FULL_PINYIN, &observer));
+        g_assert (context->insert (string ("nihaoshijie")));
+        g_assert_cmpint (context->cursor (), ==, 11);
+        g_assert_cmpstring (context->inputText (), ==, "nihaoshijie");
+        g_assert_cmpstring (context->conversionText (), ==, "你好世界");
+
+        // Removes "hao" before the cursor.
+        g_assert (context->removeRange (2, 5));
+        g_assert_cmpint (context->cursor (), ==, 8);
+        g_assert_cmpstring (context->inputText (), ==, "nishijie");
+        {  // Same as typed by characters
+            unique_ptr<InputContext> typed (
+                InputContext::create (InputContext::FULL_PINYIN, &observer));
+            insertKeys (typed.get (), "nishijie");
+            g_assert_cmpstring (context->conversionText (), ==,
+                                typed->conversionText ().c_str ());
+            g_assert_cmpstring (context->auxiliaryText (), ==,
+                                typed->auxiliaryText ().c_str ());
+        }
+
+        // Inserts on the cursor in the middle of the text.
+        context->moveCursorToBegin ();
+        for (size_t i = 0; i < 2; ++i)
+            context->moveCursorRight ();
+        g_assert (context->insert (string ("hao")));
+        g_assert_cmpint (context->cursor (), ==, 5);
+        g_assert_cmpstring (context->inputText (), ==, "nihaoshijie");
+
+        // Removes text after the cursor.
+        g_assert (context->removeRange (5, 100));
+        g_assert_cmpint (context->cursor (), ==, 5);
+        g_assert_cmpstring (context->inputText (), ==, "nihao");
+        g_assert_cmpstring (context->conversionText (), ==, "你好");
+        g_assert (!context->removeRange (5, 6));
+        g_assert (!context->removeRange (3, 3));
+
+        // The cursor in the range moves to its beginning.
+        context->moveCursorLeft ();
+        g_assert (context->removeRange (2, 5));
+        g_assert_cmpint (context->cursor (), ==, 2);
+        g_assert_cmpstring (context->inputText (), ==, "ni");
+
+        // Stops at the first invalid character.
+        context->reset ();
+        g_assert (!context->insert (string ("nihao1shijie")));
+        g_assert_cmpstring (context->inputText (), ==, "nihao");
+        g_assert_cmpstring (context->conversionText (), ==, "你好");
+
+        // The defaults of InputContext edit by characters.
+        context->reset ();
+        g_assert (!context->InputContext::insert (string ("nihaoshi1jie")));
+        g_assert_cmpstring (context->inputText (), ==, "nihaoshi");
+        context->moveCursorLeft ();
+        g_assert (context->InputContext::removeRange (2, 5));
+        g_assert_cmpint (context->cursor (), ==, 4);
+        g_assert_cmpstring (context->inputText (), ==, "nishi");
+        g_assert (context->InputContext::removeRange (1, 3));
+        g_assert_cmpint (context->cursor (), ==, 2);
+        g_assert_cmpstring (context->inputText (), ==, "nhi");
+        g_assert (!context->InputContext::removeRange (3, 4));
+    }
+
+    {  // Double pinyin
+        context.reset (
+            InputContext::create (InputContext::DOUBLE_PINYIN, &observer));
+        g_assert (context->insert (string ("nihk")));
+        g_assert_cmpint (context->cursor (), ==, 4);
+        g_assert_cmpstring (context->conversionText (), ==, "你好");
+        g_assert (context->removeRange (2, 4));
+        g_assert_cmpstring (context->inputText (), ==, "ni");
+        g_assert (!context->insert (string ("hk;")));
+        g_assert_cmpstring (context->inputText (), ==, "nihk");
+        g_assert_cmpstring (context->conversionText (), ==, "你好");
+    }
+
+    {  // Bopomofo
+        context.reset (
+            InputContext::create (InputContext::BOPOMOFO, &observer));
+        context->setProperty (InputContext::PROPERTY_SPECIAL_PHRASE,
+                              Variant::fromBool (false));
+        g_assert (context->insert (string ("sucl")));
+        g_assert_cmpint (context->cursor (), ==, 4);
+        g_assert_cmpstring (context->conversionText (), ==, "你好");
+        g_assert_cmpstring (context->auxiliaryText (), ==, "ㄋㄧ,ㄏㄠ|");
+        g_assert (context->removeRange (0, 2));
+        g_assert_cmpint (context->cursor (), ==, 2);
+        g_assert_cmpstring (context->inputText (), ==, "cl");
+    }
+}
+
+void testBatchConverter ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    context->setProperty (InputContext::PROPERTY_SPECIAL_PHRASE,
+                          Variant::fromBool (false));
+    const char *texts[] = {
+        "nihao", "shijie", "woshiyigezhongguoren", "xi'anshi", "jintian",
+    };
+
+    // The lines are converted as typed.
+    vector<string> lines;
+    vector<string> typed;
+    for (size_t i = 0; i < 100; ++i) {
+        lines.push_back (texts[i % G_N_ELEMENTS (texts)]);
+        context->reset ();
+        insertKeys (context.get (), lines.back ());
+        typed.push_back (context->conversionText ());
+    }
+
+    for (unsigned int threads = 1; threads <= 4; threads *= 2) {
+        BatchConverter converter (InputContext::FULL_PINYIN, threads);
+        vector<string> results;
+        converter.convert (lines, results);
+        g_assert_cmpint (results.size (), ==, lines.size ());
+        for (size_t i = 0; i < lines.size (); ++i)
+            g_assert_cmpstring (results[i], ==, typed[i].c_str ());
+    }
+
+    BatchConverter converter (InputContext::FULL_PINYIN, 2);
+
+    // The characters which are not pinyin are copied.
+    g_assert_cmpstring (converter.convert ("nihao, shijie!\n\n123"), ==,
+                        (typed[0] + ", " + typed[1] + "!\n\n123").c_str ());
+    g_assert_cmpint (converter.syllables (), ==, 4);
+
+    // A line longer than a sentence is converted by some sentences.
+    string line;
+    for (size_t i = 0; i < 20; ++i)
+        line += "nihao";
+    const string result = converter.convert (line);
+    g_assert_cmpint (converter.syllables (), ==, 40);
+    g_assert_cmpint (g_utf8_strlen (result.c_str (), -1), ==, 40);
+
+    // The properties are given to every thread.
+    g_assert (converter.setProperty (InputContext::PROPERTY_MODE_SIMP,
+                                     Variant::fromBool (false)));
+    g_assert (!converter.setProperty (InputContext::PROPERTY_BOPOMOFO_SCHEMA,
+                                      Variant::fromUnsignedInt (0)));
+    g_assert_cmpstring (converter.convert ("zhongguoguojiatushuguan"), ==,
+                        "中國國家圖書館");
+
+    // Other input types.
+    BatchConverter bopomofo (InputContext::BOPOMOFO, 2);
+    g_assert_cmpstring (bopomofo.convert ("sucl"), ==, "你好");
+    BatchConverter double_pinyin (InputContext::DOUBLE_PINYIN, 2);
+    g_assert_cmpstring (double_pinyin.convert ("nihk"), ==, "你好");
+}
+
+void testSimpTradConverter ()
+{
+    const char *texts[][2] = {
+        { "", "" },
+        { "龙", "龍" },
+        { "中国国家图书馆", "中國國家圖書館" },
+        // The longest simplified text is converted first.
+        { "一发千钧", "一髮千鈞" },
+        { "头发", "頭髮" },
+        { "发现", "發現" },
+        // The other characters are copied.
+        { "abc龙 卷, 風", "abc龍 卷, 風" },
+        { "pyzy", "pyzy" },
+    };
+
+    for (size_t i = 0; i < G_N_ELEMENTS (texts); ++i) {
+        String trad ("<");
+        SimpTradConverter::simpToTrad (texts[i][0], trad);
+        g_assert_cmpstring (trad, ==, (string ("<") + texts[i][1]).c_str ());
+    }
+}
+
+void testSimpTradStream ()
+{
+    const string text = "一发千钧, hello world 头发\n"
+                        "中国国家图书馆。http://pyzy/发现 \xf0\x9f\x98\x80龙卷风 "
+                        "0123456789abcdefghijklmnopqrstuvwxyz一发";
+    String expected;
+    SimpTradConverter::simpToTrad (text.c_str (), expected);
+
+    // Every chunk size and output size gives the same text.
+    const size_t out_sizes[] = { 1, 2, 5, 64 };
+    for (size_t chunk = 1; chunk <= text.size (); ++chunk) {
+        for (size_t i = 0; i < G_N_ELEMENTS (out_sizes); ++i) {
+            SimpTradStream stream;
+            string result;
+            char buffer[64];
+            for (size_t pos = 0; pos < text.size (); pos += chunk) {
+                const char *in = text.data () + pos;
+                size_t in_left = MIN (chunk, text.size () - pos);
+                while (in_left > 0) {
+                    char *out = buffer;
+                    size_t out_left = out_sizes[i];
+                    stream.convert (in, in_left, out, out_left);
+                    result.append (buffer, out - buffer);
+                }
+            }
+            bool done = false;
+            while (!done) {
+                char *out = buffer;
+                size_t out_left = out_sizes[i];
+                done = stream.flush (out, out_left);
+                result.append (buffer, out - buffer);
+            }
+            g_assert_cmpstring (result, ==, expected.c_str ());
+        }
+    }
+}
+
+struct SimpTradThread {
+    GThread *thread;
+    const char *text;
+    string result;
+};
+
+/* converts a text many times, the result is kept if every round agrees */
+gpointer simpTradThread (gpointer data)
+{
+    SimpTradThread *conversion = static_cast<SimpTradThread *> (data);
+    for (int i = 0; i < 200; ++i) {
+        String trad;
+        SimpTradConverter::simpToTrad (conversion->text, trad);
+        if (i != 0 && conversion->result != (const char *) trad) {
+            conversion->result = "mismatch";
+            break;
+        }
+        conversion->result = trad;
+    }
+    return NULL;
+}
+
+void testSimpTradThreads ()
+{
+    const char * const texts[] = {
+        "一发千钧, hello world 头发",
+        "中国国家图书馆。http://pyzy/发现",
+        "龙卷风里面的计算机",
+        "我是一个中国人",
+    };
+    SimpTradThread threads[8];
+
+    // Threads converting at once give the same texts as one thread.
+    for (size_t i = 0; i < G_N_ELEMENTS (threads); ++i) {
+        threads[i].text = texts[i % G_N_ELEMENTS (texts)];
+        threads[i].thread = g_thread_new ("simptrad", simpTradThread, &threads[i]);
+    }
+    for (size_t i = 0; i < G_N_ELEMENTS (threads); ++i) {
+        g_thread_join (threads[i].thread);
+        String expected;
+        SimpTradConverter::simpToTrad (threads[i].text, expected);
+        g_assert_cmpstring (threads[i].result, ==, expected.c_str ());
+    }
+}
+
+void testTradCache ()
+{
+    // The dictionaries keep the traditional texts of their phrases, the
+    // user phrases below have none, and are converted in both builds.
+    static const char * const user_phrases[] = { "种过", "重锅", "肿锅" };
+    PinyinArray pinyin;
+    g_assert_cmpuint (PinyinParser::parse ("zhongguo", 8, 0, pinyin, MAX_PHRASE_LEN), ==, 8);
+    g_assert_cmpuint (pinyin.size (), ==, 2);
+
+    InputContext::finalize ();
+    sqlite3 *db = NULL;
+    const string file = getTestDir () + G_DIR_SEPARATOR_S "user-1.0.db";
+    g_assert (sqlite3_open (file.c_str (), &db) == SQLITE_OK);
+    for (size_t i = 0; i < G_N_ELEMENTS (user_phrases); ++i) {
+        String sql;
+        sql << "INSERT INTO py_phrase_1 (user_freq,phrase,freq,s0,y0,s1,y1)"
+            << " VALUES (100,'" << user_phrases[i] << "',0";
+        for (size_t j = 0; j < pinyin.size (); ++j)
+            sql << ',' << pinyin[j].pinyin->pinyin_id[0].sheng
+                << ',' << pinyin[j].pinyin->pinyin_id[0].yun;
+        sql << ");";
+        g_assert (sqlite3_exec (db, sql, NULL, NULL, NULL) == SQLITE_OK);
+    }
+    sqlite3_close (db);
+    InputContext::init (getTestDir (), getTestDir ());
+
+    DummyObserver observer;
+    unique_ptr<InputContext> simp (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    unique_ptr<InputContext> trad (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    trad->setProperty (InputContext::PROPERTY_MODE_SIMP,
+                       Variant::fromBool (false));
+    Candidate candidate;
+
+    insertKeys (simp.get (), "zhongguo");
+    insertKeys (trad.get (), "zhongguo");
+    size_t n = 0;
+    for (; n < 20 && simp->getCandidate (n, candidate); ++n) {
+        String text;
+        SimpTradConverter::simpToTrad (candidate.text.c_str (), text);
+        g_assert (trad->getCandidate (n, candidate));
+        g_assert_cmpstring (candidate.text, ==, text.c_str ());
+    }
+    g_assert_cmpint (n, >, G_N_ELEMENTS (user_phrases));
+    g_assert_cmpint (SimpTradConverter::cacheHits () +
+                     SimpTradConverter::cacheMisses (), >=,
+                     G_N_ELEMENTS (user_phrases));
+
+    // Scrolling the candidates and moving the focus convert nothing.
+    const unsigned int hits = SimpTradConverter::cacheHits ();
+    const unsigned int misses = SimpTradConverter::cacheMisses ();
+    for (size_t i = 0; i < n; ++i) {
+        g_assert (trad->getCandidate (i, candidate));
+        trad->focusCandidate (i);
+    }
+    g_assert_cmpint (SimpTradConverter::cacheHits (), ==, hits);
+    g_assert_cmpint (SimpTradConverter::cacheMisses (), ==, misses);
+
+    // Another context converts its candidates once too.
+    unique_ptr<InputContext> other (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    other->setProperty (InputContext::PROPERTY_MODE_SIMP,
+                        Variant::fromBool (false));
+    insertKeys (other.get (), "zhongguo");
+    unsigned int converted = 0;
+    for (size_t round = 0; round < 2; ++round) {
+        for (size_t i = 0; i < n; ++i) {
+            Candidate expected;
+            g_assert (trad->getCandidate (i, expected));
+            g_assert (other->getCandidate (i, candidate));
+            g_assert_cmpstring (candidate.text, ==, expected.text.c_str ());
+        }
+        if (round == 0) {
+            converted = SimpTradConverter::cacheHits () +
+                        SimpTradConverter::cacheMisses ();
+            g_assert_cmpint (converted, >=, hits + misses +
+                             G_N_ELEMENTS (user_phrases));
+        }
+    }
+    g_assert_cmpint (SimpTradConverter::cacheHits () +
+                     SimpTradConverter::cacheMisses (), ==, converted);
+
+    // The selected text is traditional too.
+    trad->focusCandidate (0);
+    g_assert (trad->getCandidate (0, candidate));
+    trad->selectCandidate (0);
+    g_assert_cmpstring (observer.commitedText (), ==, candidate.text.c_str ());
+}
+
+void testTradDictionary ()
+{
+    DummyObserver observer;
+    unique_ptr<InputContext> context (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    context->setProperty (InputContext::PROPERTY_MODE_SIMP,
+                          Variant::fromBool (false));
+    Candidate candidate;
+
+    // The dictionary has the traditional texts, nothing is converted.
+    const unsigned int converted = SimpTradConverter::cacheHits () +
+                                   SimpTradConverter::cacheMisses ();
+    insertKeys (context.get (), "zhongguoren");
+    for (size_t i = 0; i < 20 && context->getCandidate (i, candidate); ++i) {
+        String text;
+        SimpTradConverter::simpToTrad (candidate.text.c_str (), text);
+        g_assert_cmpstring (candidate.text, ==, text.c_str ());
+    }
+    g_assert_cmpint (SimpTradConverter::cacheHits () +
+                     SimpTradConverter::cacheMisses (), ==, converted);
+
+    // A learned sentence keeps its traditional text in the user database.
+    context->reset ();
+    insertKeys (context.get (), "womenyiququfanguan");
+    const string sentence = context->conversionText ();
+    observer.clear ();
+    context->selectCandidate (0);
+    g_assert_cmpstring (observer.commitedText (), ==, sentence.c_str ());
+    context.reset ();
+
+    InputContext::finalize ();
+    InputContext::init (getTestDir (), getTestDir ());
+
+    context.reset (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    context->setProperty (InputContext::PROPERTY_MODE_SIMP,
+                          Variant::fromBool (false));
+    insertKeys (context.get (), "womenyiququfanguan");
+    g_assert (context->getCandidate (0, candidate));
+    g_assert_cmpstring (candidate.text, ==, sentence.c_str ());
+    g_assert_cmpint (SimpTradConverter::cacheHits () +
+                     SimpTradConverter::cacheMisses (), ==, converted);
+}
+
+void testCorruptDictionary ()
+{
+    gchar *data = NULL;
+    gsize size = 0;
+    if (!g_file_get_contents (PKGDATADIR "/db/android.dict", &data, &size, NULL))
+        return;
+
+    // The header is followed by the tables, the index of the groups of the
+    // phrases of one syllable is at the offset in the 4th field of the first.
+    const size_t table_offset = 8 + 5 * sizeof (guint32);
+    guint32 record_num, index_offset;
+    memcpy (&record_num, data + table_offset, sizeof (guint32));
+    memcpy (&index_offset, data + table_offset + 3 * sizeof (guint32), sizeof (guint32));
+    guint32 *index = (guint32 *) (data + index_offset);
+
+    g_mkdir_with_parents (getTestDir ().c_str (), 0755);
+    const string file = getTestDir () + G_DIR_SEPARATOR_S "corrupt.dict";
+    PhraseDict dict;
+    g_assert (g_file_set_contents (file.c_str (), data, size, NULL));
+    g_assert (dict.open (file.c_str ()));
+
+    // A group which ends after the last record.
+    const guint32 end = index[1];
+    index[1] = record_num + 1;
+    g_assert (g_file_set_contents (file.c_str (), data, size, NULL));
+    g_assert (!dict.open (file.c_str ()));
+
+    // A group which ends before it begins.
+    index[1] = end;
+    index[0] = record_num;
+    g_assert (g_file_set_contents (file.c_str (), data, size, NULL));
+    g_assert (!dict.open (file.c_str ()));
+
+    g_free (data);
+    removeDirectory (getTestDir ());
+}
+
 int main (int argc, char **argv)
 {
     setUp();
     testFullPinyin();
     tearDown();
 
+    testIncrementalParse();
+
     setUp();
     testDoublePinyin();
     tearDown();
@@ -1098,5 +2197,79 @@ int main (int argc, char **argv)
     testCommit();
     tearDown();
 
+    setUp();
+    testQueryCache();
+    tearDown();
+
+    setUp();
+    testStmtCache();
+    tearDown();
+
+    setUp();
+    testCandidateOrder();
+    tearDown();
+
+    setUp();
+    testFirstCandidatePath();
+    tearDown();
+
+    setUp();
+    testFreqScale();
+    tearDown();
+
+    setUp();
+    testPhraseFilter();
+    tearDown();
+
+    setUp();
+    testAbbreviation();
+    tearDown();
+
+    setUp();
+    testUserDB();
+    tearDown();
+
+    setUp();
+    testLazyUserDB();
+    tearDown();
+
+    setUp();
+    testWarmUp();
+    tearDown();
+
+    setUp();
+    testSessions();
+    tearDown();
+
+    setUp();
+    testThreads();
+    tearDown();
+
+    setUp();
+    testBatchChanges();
+    tearDown();
+
+    setUp();
+    testBulkEdit();
+    tearDown();
+
+    setUp();
+    testBatchConverter();
+    tearDown();
+
+    testSimpTradConverter();
+    testSimpTradStream();
+    testSimpTradThreads();
+
+    setUp();
+    testTradCache();
+    tearDown();
+
+    setUp();
+    testTradDictionary();
+    tearDown();
+
+    testCorruptDictionary();
+
     return 0;
 }
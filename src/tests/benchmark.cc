@@ -0,0 +1,1068 @@
+/* vim:set et ts=4 sts=4:
+ *
+ * libpyzy - The Chinese PinYin and Bopomofo conversion library.
+ *
+ * Copyright (c) 2008-2010 Peng Huang <shawn.p.huang@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <fcntl.h>
+#include <malloc.h>
+#include <sqlite3.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "BatchConverter.h"
+#include "Config.h"
+#include "Database.h"
+#include "InputContext.h"
+#include "PhrasePool.h"
+#include "PinyinParser.h"
+#include "SimpTradConverter.h"
+#include "Util.h"  // for unique_ptr
+#include "Variant.h"
+
+using namespace PyZy;
+
+class DummyObserver : public InputContext::Observer {
+public:
+    void commitText (InputContext *context, const std::string &commit_text) {}
+    void inputTextChanged (InputContext *context) {}
+    void cursorChanged (InputContext *context) {}
+    void preeditTextChanged (InputContext *context) {}
+    void auxiliaryTextChanged (InputContext *context) {}
+    void candidatesChanged (InputContext *context) {}
+};
+
+/* Runs the benchmarks named on the command line, or all of them. Each
+ * benchmark prints one line per case with the time of one operation. */
+
+static const char * const pinyin_texts[] = {
+    "woshiyigezhongguoren",
+    "zhonghuarenmingongheguo",
+    "xi'anshiyigemeilidechengshi",
+    "jintiantianqihenhao",
+    "shuangchuangzhuanghuang",
+    "yigejinzita",
+    "nihaoshijie",
+    "zhongguoxiangqi",
+};
+
+static void
+report (const char *name, gint64 start, size_t count)
+{
+    double us = g_get_monotonic_time () - start;
+    if (count == 1)
+        std::printf ("%-32s %10.2f ms\n", name, us / 1000.0);
+    else
+        std::printf ("%-32s %10.1f ns/op\n", name, us * 1000.0 / count);
+}
+
+static void
+benchmarkParser (void)
+{
+    const size_t rounds = 200000;
+    const unsigned int option = Config ().option;
+    PinyinArray result;
+    size_t syllables = 0;
+    gint64 start;
+
+    start = g_get_monotonic_time ();
+    for (size_t i = 0; i < rounds; i++) {
+        for (size_t j = 0; j < G_N_ELEMENTS (pinyin_texts); j++) {
+            String text (pinyin_texts[j]);
+            PinyinParser::parse (text, text.size (), option, result, 16);
+            syllables += result.size ();
+        }
+    }
+    report ("parser/full", start, rounds * G_N_ELEMENTS (pinyin_texts));
+    report ("parser/full per syllable", start, syllables);
+
+    /* parse after every key stroke, reusing the last result */
+    const size_t strokes_rounds = rounds / 10;
+    size_t strokes = 0;
+    start = g_get_monotonic_time ();
+    for (size_t i = 0; i < strokes_rounds; i++) {
+        for (size_t j = 0; j < G_N_ELEMENTS (pinyin_texts); j++) {
+            String text (pinyin_texts[j]);
+            result.clear ();
+            for (size_t k = 1; k <= text.size (); k++) {
+                PinyinParser::parse (text, k, option, result, 16, k - 1);
+                strokes++;
+            }
+        }
+    }
+    report ("parser/key stroke", start, strokes);
+}
+
+static void
+benchmarkIsPinyin (void)
+{
+    const size_t rounds = 20000;
+    const unsigned int option = Config ().option;
+    size_t found = 0;
+    gint64 start;
+
+    /* what double pinyin does for every key pair */
+    start = g_get_monotonic_time ();
+    for (size_t i = 0; i < rounds; i++) {
+        for (int sheng = PINYIN_ID_ZERO; sheng <= PINYIN_ID_ZH; sheng++) {
+            for (int yun = PINYIN_ID_A; yun <= PINYIN_ID_V; yun++) {
+                if (PinyinParser::isPinyin (sheng, yun, option) != NULL)
+                    found++;
+            }
+        }
+    }
+    report ("isPinyin", start,
+            rounds * (PINYIN_ID_ZH + 1) * (PINYIN_ID_V - PINYIN_ID_A + 1));
+}
+
+static std::string
+benchmarkDir (void)
+{
+    gchar *path = g_build_filename (g_get_tmp_dir (), "__pyzy_benchmark_dir__", NULL);
+    const std::string result = path;
+    g_free (path);
+    return result;
+}
+
+static void
+removeBenchmarkDir (void)
+{
+    const std::string dir = benchmarkDir ();
+    static const char * const files[] = {
+        "user-1.0.db", "user-1.0.db-wal", "user-1.0.db-shm",
+    };
+    for (size_t i = 0; i < G_N_ELEMENTS (files); i++)
+        g_unlink ((dir + G_DIR_SEPARATOR_S + files[i]).c_str ());
+    g_rmdir (dir.c_str ());
+}
+
+/* fills the user database with rows random phrases */
+static void
+createUserDB (size_t rows)
+{
+    const std::string dir = benchmarkDir ();
+    removeBenchmarkDir ();
+
+    /* let the library create the tables */
+    InputContext::init (dir, dir);
+    InputContext::finalize ();
+
+    sqlite3 *db = NULL;
+    const std::string file = dir + G_DIR_SEPARATOR_S "user-1.0.db";
+    if (sqlite3_open (file.c_str (), &db) != SQLITE_OK)
+        g_error ("can not open %s", file.c_str ());
+
+    sqlite3_exec (db, "BEGIN TRANSACTION;", NULL, NULL, NULL);
+    srand (1);
+    for (size_t i = 0; i < rows; i++) {
+        size_t len = 2 + rand () % 3;
+        String sql;
+        sql << "INSERT OR IGNORE INTO py_phrase_" << len - 1 << " VALUES ("
+            << 1 + rand () % 10 << ",'";
+        for (size_t j = 0; j < len; j++)
+            sql.appendUnichar (0x4e00 + rand () % 0x5000);
+        sql << "'," << rand () % 1000;
+        for (size_t j = 0; j < len; j++)
+            sql << ',' << 1 + rand () % PINYIN_ID_ZH << ',' << PINYIN_ID_A + rand () % 33;
+        sql << ",NULL);";
+        sqlite3_exec (db, sql, NULL, NULL, NULL);
+    }
+    sqlite3_exec (db, "COMMIT;", NULL, NULL, NULL);
+    sqlite3_close (db);
+}
+
+static void
+benchmarkStartup (bool lazy)
+{
+    const std::string dir = benchmarkDir ();
+    DummyObserver observer;
+    std::unique_ptr<InputContext> context;
+    gint64 start;
+
+    start = g_get_monotonic_time ();
+    InputContext::init (dir, dir, lazy);
+    report (lazy ? "startup/lazy init" : "startup/init", start, 1);
+
+    context.reset (InputContext::create (InputContext::FULL_PINYIN, &observer));
+    const char *keys = "nihao";
+    for (const char *p = keys; *p; p++)
+        context->insert (*p);
+    report (lazy ? "startup/lazy first conversion" : "startup/first conversion", start, 1);
+
+    if (lazy) {
+        Database::instance ().waitUserDB ();
+        report ("startup/lazy user dictionary", start, 1);
+    }
+    context.reset ();
+    InputContext::finalize ();
+}
+
+static void
+benchmarkStartup (void)
+{
+    createUserDB (300000);
+    benchmarkStartup (false);
+    benchmarkStartup (true);
+    removeBenchmarkDir ();
+}
+
+/* pages through all candidates of a whole input, as PhraseEditor does,
+ * without the query cache */
+static void
+benchmarkQuery (void)
+{
+    const size_t rounds = 20;
+    const unsigned int option = Config ().option;
+    const std::string dir = benchmarkDir ();
+    PinyinArray pinyin;
+    PhraseArray phrases;
+    size_t queries = 0;
+    size_t candidates = 0;
+    gint64 start;
+
+    createUserDB (10000);
+    InputContext::init (dir, dir);
+    InputContext::setQueryCacheSize (0);
+
+    /* the first page of every suffix of the input */
+    start = g_get_monotonic_time ();
+    for (size_t i = 0; i < rounds; i++) {
+        for (size_t j = 0; j < G_N_ELEMENTS (pinyin_texts); j++) {
+            String text (pinyin_texts[j]);
+            PinyinParser::parse (text, text.size (), option, pinyin, MAX_PHRASE_LEN);
+            for (size_t k = 0; k < pinyin.size (); k++) {
+                Query query (pinyin, k, pinyin.size () - k, option);
+                phrases.clear ();
+                query.fill (phrases, 12);
+                queries ++;
+            }
+        }
+    }
+    report ("query/first page", start, queries);
+
+    queries = 0;
+    start = g_get_monotonic_time ();
+    for (size_t i = 0; i < rounds; i++) {
+        for (size_t j = 0; j < G_N_ELEMENTS (pinyin_texts); j++) {
+            String text (pinyin_texts[j]);
+            PinyinParser::parse (text, text.size (), option, pinyin, MAX_PHRASE_LEN);
+            Query query (pinyin, 0, pinyin.size (), option);
+            phrases.clear ();
+            while (query.fill (phrases, 12) == 12);
+            candidates += phrases.size ();
+            queries ++;
+        }
+    }
+    report ("query/all candidates", start, queries);
+    report ("query/per candidate", start, candidates);
+
+    InputContext::finalize ();
+    removeBenchmarkDir ();
+}
+
+/* the first page of every suffix, of the inputs and of their initials
+ * typed as incomplete pinyin */
+static void
+benchmarkAbbreviation (void)
+{
+    const size_t rounds = 20;
+    const unsigned int option = Config ().option;
+    const std::string dir = benchmarkDir ();
+    std::vector<String> texts;
+    PinyinArray pinyin;
+    PhraseArray phrases;
+
+    for (size_t i = 0; i < G_N_ELEMENTS (pinyin_texts); i++) {
+        String text (pinyin_texts[i]);
+        PinyinParser::parse (text, text.size (), option, pinyin, MAX_PHRASE_LEN);
+        String initials;
+        for (size_t j = 0; j < pinyin.size (); j++) {
+            if (j > 0)
+                initials << '\'';
+            initials << (pinyin[j]->sheng[0] != '\0' ? pinyin[j]->sheng : pinyin[j]->text);
+        }
+        texts.push_back (text);
+        texts.push_back (initials);
+    }
+
+    createUserDB (10000);
+    InputContext::init (dir, dir);
+    InputContext::setQueryCacheSize (0);
+
+    for (size_t abbreviated = 0; abbreviated < 2; abbreviated++) {
+        size_t queries = 0;
+        gint64 start = g_get_monotonic_time ();
+        for (size_t i = 0; i < rounds; i++) {
+            for (size_t j = abbreviated; j < texts.size (); j += 2) {
+                PinyinParser::parse (texts[j], texts[j].size (), option, pinyin, MAX_PHRASE_LEN);
+                for (size_t k = 0; k < pinyin.size (); k++) {
+                    Query query (pinyin, k, pinyin.size () - k, option);
+                    phrases.clear ();
+                    query.fill (phrases, 12);
+                    queries ++;
+                }
+            }
+        }
+        report (abbreviated ? "abbreviation/initials first page" :
+                              "abbreviation/full first page", start, queries);
+    }
+
+    InputContext::finalize ();
+    removeBenchmarkDir ();
+}
+
+/* looks up random spans of three to six syllables, most of them have no
+ * phrases, and counts the spans the filter did not leave out */
+static void
+benchmarkFilter (void)
+{
+    const size_t spans = 20000;
+    const unsigned int option = Config ().option;
+    const std::string dir = benchmarkDir ();
+    std::vector<std::string> syllables;
+    PinyinArray pinyin;
+    PhraseArray phrases;
+    gint64 start;
+
+    for (size_t i = 0; i < G_N_ELEMENTS (pinyin_texts); i++) {
+        String text (pinyin_texts[i]);
+        PinyinParser::parse (text, text.size (), option, pinyin, MAX_PHRASE_LEN);
+        for (size_t j = 0; j < pinyin.size (); j++)
+            syllables.push_back (pinyin[j]->text);
+    }
+
+    createUserDB (10000);
+    InputContext::init (dir, dir);
+    InputContext::setQueryCacheSize (0);
+
+    std::vector<String> texts (spans);
+    srand (1);
+    for (size_t i = 0; i < spans; i++) {
+        size_t len = 3 + rand () % 4;
+        for (size_t j = 0; j < len; j++) {
+            if (j > 0)
+                texts[i] << '\'';
+            texts[i] << syllables[rand () % syllables.size ()];
+        }
+    }
+
+    size_t empty = 0;
+    size_t looked_up = 0;
+    start = g_get_monotonic_time ();
+    for (size_t i = 0; i < spans; i++) {
+        PinyinParser::parse (texts[i], texts[i].size (), option, pinyin, MAX_PHRASE_LEN);
+        unsigned int skips = InputContext::phraseFilterSkips ();
+        Query query (pinyin, 0, pinyin.size (), option, pinyin.size ());
+        phrases.clear ();
+        if (query.fill (phrases, 1) == 0) {
+            empty ++;
+            if (InputContext::phraseFilterSkips () == skips)
+                looked_up ++;
+        }
+    }
+    report ("filter/span", start, spans);
+
+    std::printf ("%-32s %10.1f KB\n", "filter/memory",
+                 InputContext::phraseFilterMemory () / 1024.0);
+    std::printf ("%-32s %10.2f %%\n", "filter/estimated false positives",
+                 InputContext::phraseFilterFalsePositiveRate () * 100.0);
+    std::printf ("%-32s %10.2f %%\n", "filter/measured false positives",
+                 empty > 0 ? looked_up * 100.0 / empty : 0.0);
+
+    InputContext::finalize ();
+    removeBenchmarkDir ();
+}
+
+/* drops the main dictionaries from the page cache of the system, as after
+ * a reboot */
+static void
+evictDictionaries (void)
+{
+    static const char * const files[] = {
+        PKGDATADIR "/db/local.db",
+        PKGDATADIR "/db/local.dict",
+        PKGDATADIR "/db/open-phrase.db",
+        PKGDATADIR "/db/open-phrase.dict",
+        PKGDATADIR "/db/android.db",
+        PKGDATADIR "/db/android.dict",
+    };
+    for (size_t i = 0; i < G_N_ELEMENTS (files); i++) {
+        int fd = open (files[i], O_RDONLY);
+        if (fd < 0)
+            continue;
+        posix_fadvise (fd, 0, 0, POSIX_FADV_DONTNEED);
+        close (fd);
+    }
+}
+
+static void
+benchmarkWarmUp (bool warm)
+{
+    const std::string dir = benchmarkDir ();
+    DummyObserver observer;
+    std::unique_ptr<InputContext> context;
+    gint64 start;
+
+    evictDictionaries ();
+    InputContext::init (dir, dir);
+    if (warm)
+        InputContext::warmUp (16 << 20, 1000);
+    /* the user does not type at once */
+    g_usleep (200 * 1000);
+
+    context.reset (InputContext::create (InputContext::FULL_PINYIN, &observer));
+    start = g_get_monotonic_time ();
+    context->insert ('n');
+    report (warm ? "warmup/warm first key" : "warmup/cold first key", start, 1);
+
+    start = g_get_monotonic_time ();
+    const char *keys = "ihaoshijie";
+    for (const char *p = keys; *p; p++)
+        context->insert (*p);
+    report (warm ? "warmup/warm next keys" : "warmup/cold next keys", start, 1);
+
+    context.reset ();
+    InputContext::finalize ();
+}
+
+static void
+benchmarkWarmUp (void)
+{
+    removeBenchmarkDir ();
+    benchmarkWarmUp (false);
+    benchmarkWarmUp (true);
+    removeBenchmarkDir ();
+}
+
+struct TypingThread {
+    size_t rounds;
+    bool learn;
+    size_t keys;
+};
+
+/* types the inputs by a context of its own, and commits the first
+ * candidate of every input when learning */
+static gpointer
+typingThread (gpointer data)
+{
+    TypingThread *typing = static_cast<TypingThread *> (data);
+    DummyObserver observer;
+    std::unique_ptr<InputContext> context (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+
+    typing->keys = 0;
+    for (size_t i = 0; i < typing->rounds; i++) {
+        for (size_t j = 0; j < G_N_ELEMENTS (pinyin_texts); j++) {
+            for (const char *p = pinyin_texts[j]; *p; p++)
+                context->insert (*p);
+            typing->keys += std::strlen (pinyin_texts[j]);
+            if (typing->learn)
+                context->selectCandidate (0);
+            context->reset ();
+        }
+    }
+    return NULL;
+}
+
+/* the key strokes of all threads per second, every thread has its own
+ * context and reader */
+static void
+benchmarkThreads (bool learn)
+{
+    static const size_t counts[] = { 1, 2, 4, 8 };
+    const size_t keys = 20000;
+    size_t length = 0;
+    for (size_t i = 0; i < G_N_ELEMENTS (pinyin_texts); i++)
+        length += std::strlen (pinyin_texts[i]);
+
+    for (size_t i = 0; i < G_N_ELEMENTS (counts); i++) {
+        const size_t n = counts[i];
+        std::vector<TypingThread> typings (n);
+        std::vector<GThread *> threads (n);
+        size_t total = 0;
+
+        gint64 start = g_get_monotonic_time ();
+        for (size_t j = 0; j < n; j++) {
+            typings[j].rounds = keys / n / length + 1;
+            typings[j].learn = learn;
+            threads[j] = g_thread_new ("typing", typingThread, &typings[j]);
+        }
+        for (size_t j = 0; j < n; j++) {
+            g_thread_join (threads[j]);
+            total += typings[j].keys;
+        }
+
+        String name (learn ? "threads/learning " : "threads/typing ");
+        name << n;
+        report (name, start, total);
+    }
+}
+
+static void
+benchmarkThreads (void)
+{
+    const std::string dir = benchmarkDir ();
+    createUserDB (10000);
+    InputContext::init (dir, dir);
+    std::printf ("%-32s %10u\n", "threads/processors", g_get_num_processors ());
+    benchmarkThreads (false);
+    benchmarkThreads (true);
+    InputContext::finalize ();
+    removeBenchmarkDir ();
+}
+
+struct ReaderThread {
+    volatile gint *opened;
+    volatile gint *stop;
+};
+
+/* converts an input by a context of its own, which copies the user
+ * database for the reader of the thread, and waits for the others */
+static gpointer
+readerThread (gpointer data)
+{
+    ReaderThread *reader = static_cast<ReaderThread *> (data);
+    DummyObserver observer;
+    std::unique_ptr<InputContext> context (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+
+    for (const char *p = "nihao"; *p; p++)
+        context->insert (*p);
+    g_atomic_int_inc (reader->opened);
+    while (!g_atomic_int_get (reader->stop))
+        g_usleep (1000);
+    return NULL;
+}
+
+/* n threads open their readers while the first one types and learns at
+ * a key per ms, the worst key stroke is the one waiting for the copies */
+static void
+benchmarkReaders (size_t n)
+{
+    DummyObserver observer;
+    std::unique_ptr<InputContext> context (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    volatile gint opened = 0;
+    volatile gint stop = 0;
+    std::vector<ReaderThread> readers (n);
+    std::vector<GThread *> threads (n);
+    gint64 worst = 0;
+
+    /* the first conversion builds the caches of the typing thread */
+    for (const char *p = pinyin_texts[0]; *p; p++)
+        context->insert (*p);
+    context->reset ();
+
+    gint64 start = g_get_monotonic_time ();
+    for (size_t i = 0; i < n; i++) {
+        readers[i].opened = &opened;
+        readers[i].stop = &stop;
+        threads[i] = g_thread_new ("reader", readerThread, &readers[i]);
+    }
+    for (size_t i = 0; g_atomic_int_get (&opened) < (gint) n; i++) {
+        const char *text = pinyin_texts[i % G_N_ELEMENTS (pinyin_texts)];
+        for (const char *p = text; *p; p++) {
+            g_usleep (1000);
+            gint64 key = g_get_monotonic_time ();
+            context->insert (*p);
+            worst = MAX (worst, g_get_monotonic_time () - key);
+        }
+        gint64 key = g_get_monotonic_time ();
+        context->selectCandidate (0);
+        worst = MAX (worst, g_get_monotonic_time () - key);
+        context->reset ();
+    }
+    String name ("readers/open ");
+    name << n;
+    report (name, start, 1);
+
+    g_atomic_int_set (&stop, 1);
+    for (size_t i = 0; i < n; i++)
+        g_thread_join (threads[i]);
+
+    name << " worst key";
+    std::printf ("%-32s %10.2f ms\n", (const char *) name, worst / 1000.0);
+}
+
+static void
+benchmarkReaders (void)
+{
+    const std::string dir = benchmarkDir ();
+    createUserDB (300000);
+    InputContext::init (dir, dir);
+    benchmarkReaders (1);
+    benchmarkReaders (4);
+    InputContext::finalize ();
+    removeBenchmarkDir ();
+}
+
+/* recorded key strokes of a session: ' ' commits the conversion and '<'
+ * removes the character before the cursor */
+static const char * const session_traces[] = {
+    "nihao shijie ",
+    "woshiyigezhongguoren ",
+    "zhonghuarenmingongheguo ",
+    "jintiantianqihenhao ",
+    "xi'anshiyigemeilidechengshi ",
+    "zhongguoxx<<xiangqi ",
+    "shuangchuangzhuanghuang ",
+    "yigejinzita ",
+};
+
+static size_t
+heapInUse (void)
+{
+#if defined (__GLIBC__) && __GLIBC_PREREQ (2, 33)
+    return mallinfo2 ().uordblks;
+#else
+    return 0;
+#endif
+}
+
+static void
+replayKey (InputContext *context, char key)
+{
+    switch (key) {
+    case ' ':
+        context->commit ();
+        break;
+    case '<':
+        context->removeCharBefore ();
+        break;
+    default:
+        context->insert (key);
+        break;
+    }
+}
+
+/* n sessions type the traces in turns, a trace at a time, or a key at a
+ * time so every session is in the middle of an input */
+static void
+benchmarkSessions (size_t n, bool interleaved)
+{
+    DummyObserver observer;
+    std::vector<InputContext *> contexts;
+    const size_t rounds = interleaved ? 1 : 20000 / n + 1;
+    size_t keys = 0;
+
+    size_t heap = heapInUse ();
+    for (size_t i = 0; i < n; i++)
+        contexts.push_back (InputContext::create (InputContext::FULL_PINYIN, &observer));
+
+    gint64 start = g_get_monotonic_time ();
+    for (size_t round = 0; round < rounds; round++) {
+        for (size_t i = 0; i < n; i++) {
+            const char *trace = session_traces[(i + round) % G_N_ELEMENTS (session_traces)];
+            for (const char *p = trace; *p && !interleaved; p++, keys++)
+                replayKey (contexts[i], *p);
+        }
+    }
+    if (interleaved) {
+        const char *trace = session_traces[1];
+        for (const char *p = trace; *p != ' '; p++) {
+            for (size_t i = 0; i < n; i++, keys++)
+                replayKey (contexts[i], *p);
+        }
+    }
+
+    String name ("sessions/");
+    name << n << (interleaved ? " typing" : " idle");
+    report (name, start, keys);
+
+    /* the bytes per session, without the storage kept by the pool */
+    name << " bytes";
+    std::printf ("%-32s %10lu\n", (const char *) name,
+                 (unsigned long) ((heapInUse () - heap - PhrasePool::memory ()) / n));
+
+    for (size_t i = 0; i < n; i++)
+        delete contexts[i];
+}
+
+static void
+benchmarkSessions (void)
+{
+    const std::string dir = benchmarkDir ();
+    createUserDB (10000);
+    InputContext::init (dir, dir);
+    benchmarkSessions (1000, false);
+    benchmarkSessions (10000, false);
+    std::printf ("%-32s %10lu\n", "sessions/pool bytes", (unsigned long) PhrasePool::memory ());
+    benchmarkSessions (1000, true);
+    InputContext::finalize ();
+    removeBenchmarkDir ();
+}
+
+/* a front end which repaints what it is notified of */
+class RepaintObserver : public DummyObserver {
+public:
+    RepaintObserver () : callbacks (0) {}
+
+    void inputTextChanged (InputContext *context) { repaint (context, InputContext::INPUT_TEXT_CHANGED); }
+    void cursorChanged (InputContext *context) { repaint (context, InputContext::CURSOR_CHANGED); }
+    void preeditTextChanged (InputContext *context) { repaint (context, InputContext::PREEDIT_TEXT_CHANGED); }
+    void auxiliaryTextChanged (InputContext *context) { repaint (context, InputContext::AUXILIARY_TEXT_CHANGED); }
+    void candidatesChanged (InputContext *context) { repaint (context, InputContext::CANDIDATES_CHANGED); }
+    void stateChanged (InputContext *context, unsigned int changes) { repaint (context, changes); }
+
+    size_t callbacks;
+    std::string painted;
+
+private:
+    void repaint (InputContext *context, unsigned int changes) {
+        callbacks++;
+        if (changes & (InputContext::INPUT_TEXT_CHANGED | InputContext::CURSOR_CHANGED))
+            painted = context->inputText ();
+        if (changes & InputContext::PREEDIT_TEXT_CHANGED)
+            painted = context->selectedText () + context->conversionText () + context->restText ();
+        if (changes & InputContext::AUXILIARY_TEXT_CHANGED)
+            painted = context->auxiliaryText ();
+        if (changes & InputContext::CANDIDATES_CHANGED) {
+            Candidate candidate;
+            for (size_t i = 0; i < 5 && context->getCandidate (i, candidate); i++)
+                painted = candidate.text;
+        }
+    }
+};
+
+/* the callbacks and repaints of typing the session traces, with a callback
+ * per change or one per key */
+static void
+benchmarkNotify (bool batch)
+{
+    RepaintObserver observer;
+    std::unique_ptr<InputContext> context (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    context->setProperty (InputContext::PROPERTY_BATCH_CHANGES, Variant::fromBool (batch));
+    size_t keys = 0;
+
+    gint64 start = g_get_monotonic_time ();
+    for (size_t round = 0; round < 100; round++) {
+        for (size_t i = 0; i < G_N_ELEMENTS (session_traces); i++) {
+            for (const char *p = session_traces[i]; *p; p++, keys++)
+                replayKey (context.get (), *p);
+        }
+    }
+    report (batch ? "notify/batched" : "notify/legacy", start, keys);
+    std::printf ("%-32s %10.2f\n", batch ? "notify/batched callbacks/key" : "notify/legacy callbacks/key",
+                 (double) observer.callbacks / keys);
+}
+
+static void
+benchmarkNotify (void)
+{
+    const std::string dir = benchmarkDir ();
+    createUserDB (10000);
+    InputContext::init (dir, dir);
+    benchmarkNotify (false);
+    benchmarkNotify (true);
+    InputContext::finalize ();
+    removeBenchmarkDir ();
+}
+
+/* pastes a text of n characters by insert (char) or at once */
+static void
+benchmarkPaste (InputContext::InputType type, const char *text, const char *name)
+{
+    DummyObserver observer;
+    std::unique_ptr<InputContext> context (InputContext::create (type, &observer));
+    const std::string pasted = text;
+
+    for (size_t n = 8; n <= pasted.size (); n *= 2) {
+        const std::string part = pasted.substr (0, n);
+        const size_t rounds = 2000 / n + 1;
+
+        gint64 start = g_get_monotonic_time ();
+        for (size_t round = 0; round < rounds; round++) {
+            for (size_t i = 0; i < part.size (); i++)
+                context->insert (part[i]);
+            context->reset ();
+        }
+        String label (name);
+        label << "/" << n << " by chars";
+        report (label, start, rounds);
+
+        start = g_get_monotonic_time ();
+        for (size_t round = 0; round < rounds; round++) {
+            context->insert (part);
+            context->reset ();
+        }
+        label.clear ();
+        label << name << "/" << n << " at once";
+        report (label, start, rounds);
+    }
+}
+
+static void
+benchmarkPaste (void)
+{
+    const std::string dir = benchmarkDir ();
+    createUserDB (10000);
+    InputContext::init (dir, dir);
+    benchmarkPaste (InputContext::FULL_PINYIN,
+                    "woshiyigezhongguorenzhonghuarenmingongheguojintiantianqihenhao",
+                    "paste/full");
+    benchmarkPaste (InputContext::DOUBLE_PINYIN,
+                    "wouiyigevsgooyfvshrfmkgsgeguojbtmtmqihfhk",
+                    "paste/double");
+    InputContext::finalize ();
+    removeBenchmarkDir ();
+}
+
+/* converts a corpus of lines by 1 to 8 threads */
+static void
+benchmarkBatch (void)
+{
+    const std::string dir = benchmarkDir ();
+    createUserDB (10000);
+    InputContext::init (dir, dir);
+
+    std::vector<std::string> lines;
+    std::vector<std::string> results;
+    for (size_t i = 0; i < 4000; i++) {
+        std::string line = pinyin_texts[i % G_N_ELEMENTS (pinyin_texts)];
+        line += pinyin_texts[(i / G_N_ELEMENTS (pinyin_texts)) % G_N_ELEMENTS (pinyin_texts)];
+        lines.push_back (line);
+    }
+
+    std::printf ("%-32s %10u\n", "batch/processors", g_get_num_processors ());
+    for (unsigned int threads = 1; threads <= 8; threads *= 2) {
+        BatchConverter converter (InputContext::FULL_PINYIN, threads);
+        gint64 start = g_get_monotonic_time ();
+        converter.convert (lines, results);
+        double seconds = (g_get_monotonic_time () - start) / (double) G_USEC_PER_SEC;
+
+        String name ("batch/");
+        name << threads << " threads";
+        std::printf ("%-32s %10.0f syllables/s\n", (const char *) name,
+                     converter.syllables () / seconds);
+    }
+
+    InputContext::finalize ();
+    removeBenchmarkDir ();
+}
+
+/* converts candidates and a long text to traditional chinese */
+static void
+benchmarkSimpTrad (void)
+{
+    static const char * const candidates[] = {
+        "我是一个中国人", "中华人民共和国", "西安是一个美丽的城市",
+        "今天天气很好", "一发千钧", "头发", "你好世界", "中国象棋",
+        "龙卷风", "发现", "计算机", "里面", "图书馆", "后来", "干净",
+        "pyzy",
+    };
+    std::string text;
+    size_t bytes = 0;
+    for (size_t i = 0; i < G_N_ELEMENTS (candidates); i++) {
+        text += candidates[i];
+        bytes += std::strlen (candidates[i]);
+    }
+
+    const size_t rounds = 20000;
+    gint64 start = g_get_monotonic_time ();
+    for (size_t round = 0; round < rounds; round++) {
+        for (size_t i = 0; i < G_N_ELEMENTS (candidates); i++) {
+            String trad;
+            SimpTradConverter::simpToTrad (candidates[i], trad);
+        }
+    }
+    double seconds = (g_get_monotonic_time () - start) / (double) G_USEC_PER_SEC;
+    std::printf ("%-32s %10.2f MB/s\n", "simptrad/candidates", bytes * rounds / seconds / 1e6);
+
+    start = g_get_monotonic_time ();
+    for (size_t round = 0; round < rounds; round++) {
+        String trad;
+        SimpTradConverter::simpToTrad (text.c_str (), trad);
+    }
+    seconds = (g_get_monotonic_time () - start) / (double) G_USEC_PER_SEC;
+    std::printf ("%-32s %10.2f MB/s\n", "simptrad/text", text.size () * rounds / seconds / 1e6);
+}
+
+/* converts a chat log of chinese, ascii and punctuation in chunks */
+static void
+benchmarkTradStream (void)
+{
+    static const char * const lines[] = {
+        "[12:01] <alice> 我们今天晚上去图书馆吧\n",
+        "[12:02] <bob> ok, see you at 7pm\n",
+        "[12:02] <bob> https://example.com/pyzy/docs/index.html\n",
+        "[12:03] <alice> 头发剪短了，发现天气很好！\n",
+        "[12:04] <carol> make -j4 && ./run-tests --verbose 2>&1 | tee log\n",
+        "[12:05] <alice> 这个问题在计算机里面很常见。\n",
+    };
+    std::string text;
+    while (text.size () < (1 << 20))
+        text += lines[text.size () % G_N_ELEMENTS (lines)];
+
+    const size_t rounds = 20;
+    gint64 start = g_get_monotonic_time ();
+    for (size_t round = 0; round < rounds; round++) {
+        String trad;
+        SimpTradConverter::simpToTrad (text.c_str (), trad);
+    }
+    double seconds = (g_get_monotonic_time () - start) / (double) G_USEC_PER_SEC;
+    std::printf ("%-32s %10.2f MB/s\n", "tradstream/whole text", text.size () * rounds / seconds / 1e6);
+
+    SimpTradStream stream;
+    char buffer[4096];
+    size_t written = 0;
+    start = g_get_monotonic_time ();
+    for (size_t round = 0; round < rounds; round++) {
+        for (size_t pos = 0; pos < text.size (); pos += sizeof (buffer)) {
+            const char *in = text.data () + pos;
+            size_t in_left = MIN (sizeof (buffer), text.size () - pos);
+            while (in_left > 0) {
+                char *out = buffer;
+                size_t out_left = sizeof (buffer);
+                stream.convert (in, in_left, out, out_left);
+                written += out - buffer;
+            }
+        }
+        bool done = false;
+        while (!done) {
+            char *out = buffer;
+            size_t out_left = sizeof (buffer);
+            done = stream.flush (out, out_left);
+            written += out - buffer;
+        }
+    }
+    seconds = (g_get_monotonic_time () - start) / (double) G_USEC_PER_SEC;
+    g_assert (written > 0);
+    std::printf ("%-32s %10.2f MB/s\n", "tradstream/4k chunks", text.size () * rounds / seconds / 1e6);
+}
+
+struct TradThread {
+    GThread *thread;
+    const std::string *text;
+    size_t rounds;
+};
+
+static gpointer
+tradThread (gpointer data)
+{
+    TradThread *conversion = static_cast<TradThread *> (data);
+    for (size_t round = 0; round < conversion->rounds; round++) {
+        String trad;
+        SimpTradConverter::simpToTrad (conversion->text->c_str (), trad);
+    }
+    return NULL;
+}
+
+/* converts short texts on several threads at once */
+static void
+benchmarkTradThreads (void)
+{
+    static const char * const lines[] = {
+        "我们今天晚上去图书馆吧", "ok, see you at 7pm",
+        "头发剪短了，发现天气很好！", "这个问题在计算机里面很常见。",
+    };
+    std::string text;
+    for (size_t i = 0; i < G_N_ELEMENTS (lines); i++)
+        text += lines[i];
+
+    const size_t rounds = 40000;
+    std::printf ("%-32s %10u\n", "tradthreads/processors", g_get_num_processors ());
+    for (unsigned int n = 1; n <= 8; n *= 2) {
+        std::vector<TradThread> threads (n);
+        gint64 start = g_get_monotonic_time ();
+        for (unsigned int i = 0; i < n; i++) {
+            threads[i].text = &text;
+            threads[i].rounds = rounds / n;
+            threads[i].thread = g_thread_new ("tradthreads", tradThread, &threads[i]);
+        }
+        for (unsigned int i = 0; i < n; i++)
+            g_thread_join (threads[i].thread);
+        double seconds = (g_get_monotonic_time () - start) / (double) G_USEC_PER_SEC;
+
+        String name ("tradthreads/");
+        name << n << " threads";
+        std::printf ("%-32s %10.2f MB/s\n", (const char *) name,
+                     text.size () * (rounds / n) * n / seconds / 1e6);
+    }
+}
+
+/* scrolls the candidates of traditional chinese and moves the focus */
+static void
+benchmarkTradScroll (void)
+{
+    const std::string dir = benchmarkDir ();
+    createUserDB (10000);
+    InputContext::init (dir, dir);
+
+    DummyObserver observer;
+    std::unique_ptr<InputContext> context (
+        InputContext::create (InputContext::FULL_PINYIN, &observer));
+    context->setProperty (InputContext::PROPERTY_MODE_SIMP, Variant::fromBool (false));
+    Candidate candidate;
+    size_t count = 0;
+
+    gint64 start = g_get_monotonic_time ();
+    for (size_t round = 0; round < 200; round++) {
+        const char *text = pinyin_texts[round % G_N_ELEMENTS (pinyin_texts)];
+        context->insert (std::string (text));
+        for (size_t pass = 0; pass < 3; pass++) {
+            for (size_t i = 0; i < 50 && context->getCandidate (i, candidate); i++, count++)
+                context->focusCandidate (i);
+        }
+        context->reset ();
+    }
+    report ("tradscroll/candidate", start, count);
+
+    InputContext::finalize ();
+    removeBenchmarkDir ();
+}
+
+static const struct {
+    const char *name;
+    void (*run) (void);
+} benchmarks[] = {
+    { "parser", benchmarkParser },
+    { "isPinyin", benchmarkIsPinyin },
+    { "startup", benchmarkStartup },
+    { "warmup", benchmarkWarmUp },
+    { "query", benchmarkQuery },
+    { "filter", benchmarkFilter },
+    { "abbreviation", benchmarkAbbreviation },
+    { "threads", benchmarkThreads },
+    { "readers", benchmarkReaders },
+    { "sessions", benchmarkSessions },
+    { "notify", benchmarkNotify },
+    { "paste", benchmarkPaste },
+    { "batch", benchmarkBatch },
+    { "simptrad", benchmarkSimpTrad },
+    { "tradstream", benchmarkTradStream },
+    { "tradthreads", benchmarkTradThreads },
+    { "tradscroll", benchmarkTradScroll },
+};
+
+int main (int argc, char **argv)
+{
+    for (size_t i = 0; i < G_N_ELEMENTS (benchmarks); i++) {
+        bool run = argc < 2;
+        for (int j = 1; j < argc; j++)
+            run = run || std::strcmp (argv[j], benchmarks[i].name) == 0;
+        if (run)
+            benchmarks[i].run ();
+    }
+    return 0;
+}